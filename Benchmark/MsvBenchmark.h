@@ -0,0 +1,27 @@
+#ifndef MARSTECH_BENCHMARK_H
+#define MARSTECH_BENCHMARK_H
+
+
+#include "../msverror.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <benchmark/benchmark.h>
+
+MSV_ENABLE_WARNINGS
+
+
+/*
+Shared helpers of MarsTech Error benchmarks.
+*/
+
+
+//prevents inlining of functions which simulate real call stacks
+#if defined(_MSC_VER)
+#define MSV_BENCHMARK_NOINLINE __declspec(noinline)
+#else
+#define MSV_BENCHMARK_NOINLINE __attribute__((noinline))
+#endif
+
+
+#endif // !MARSTECH_BENCHMARK_H
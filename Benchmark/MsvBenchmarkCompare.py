@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+"""
+Compares two MarsTech Error benchmark results (Google Benchmark JSON output) and fails when any benchmark
+is slower than the regression budget allows.
+
+Usage: MsvBenchmarkCompare.py <baseline.json> <current.json> [--budget <percent>]
+
+Medians are compared when results contain repetitions (MsvErrorBenchmarkJson target), otherwise plain runs.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_times(path):
+	with open(path, encoding="utf-8") as file:
+		results = json.load(file)
+
+	medians = {}
+	runs = {}
+	for benchmark in results["benchmarks"]:
+		name = benchmark.get("run_name", benchmark["name"])
+		if benchmark.get("aggregate_name") == "median":
+			medians[name] = benchmark["cpu_time"]
+		elif benchmark.get("run_type", "iteration") == "iteration":
+			runs.setdefault(name, benchmark["cpu_time"])
+
+	return medians if medians else runs
+
+
+def main():
+	parser = argparse.ArgumentParser(description="Compare MarsTech Error benchmark results.")
+	parser.add_argument("baseline", help="Baseline JSON results.")
+	parser.add_argument("current", help="Current JSON results.")
+	parser.add_argument("--budget", type=float, default=5.0, help="Allowed slowdown in percent (default 5).")
+	arguments = parser.parse_args()
+
+	baseline = load_times(arguments.baseline)
+	current = load_times(arguments.current)
+	regressions = 0
+
+	for name, baselineTime in sorted(baseline.items()):
+		if name not in current:
+			print("%-50s missing in current results" % name)
+			continue
+
+		change = (current[name] - baselineTime) / baselineTime * 100.0 if baselineTime else 0.0
+		regressed = change > arguments.budget
+		regressions += regressed
+		print("%-50s %12.2f %12.2f %+8.2f%%%s" % (name, baselineTime, current[name], change, "  REGRESSION" if regressed else ""))
+
+	print("%d regression(s) over %.1f%% budget" % (regressions, arguments.budget))
+
+	return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
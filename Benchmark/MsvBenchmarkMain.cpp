@@ -0,0 +1,4 @@
+#include "MsvBenchmark.h"
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,145 @@
+#include "MsvBenchmark.h"
+
+#include "../msverrorbatch.h"
+#include "../msverrorcodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/*
+Batch classification (MsvErrorBatch) versus loops with MSV_FAILED and MSV_IS_* macros. Batches succeed except the last
+error code (the whole batch is scanned), Arg is batch size.
+*/
+
+
+namespace
+{
+	std::vector<MsvErrorCode> MakeBatch(benchmark::State& state)
+	{
+		std::vector<MsvErrorCode> codes(static_cast<std::size_t>(state.range(0)), MSV_SUCCESS);
+		for (std::size_t index = 0; index < codes.size(); index += 7)
+		{
+			codes[index] = MSV_ALREADY_SET_INFO;
+		}
+		codes.back() = MSV_STILL_RUNNING_WARN;
+
+		return codes;
+	}
+
+	void BM_FirstFailedLoop(benchmark::State& state)
+	{
+		std::vector<MsvErrorCode> codes = MakeBatch(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(codes.data());
+			std::size_t index = 0;
+			for (; index < codes.size() && MSV_SUCCEEDED(codes[index]); ++index) {}
+			benchmark::DoNotOptimize(index);
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void BM_FirstFailedBatch(benchmark::State& state)
+	{
+		std::vector<MsvErrorCode> codes = MakeBatch(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(codes.data());
+			benchmark::DoNotOptimize(MsvErrorBatch::FirstFailed(codes));
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void BM_CountSeveritiesLoop(benchmark::State& state)
+	{
+		std::vector<MsvErrorCode> codes = MakeBatch(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(codes.data());
+			std::size_t counts[4] = { 0, 0, 0, 0 };
+			for (MsvErrorCode code : codes)
+			{
+				if (MSV_IS_SUCCESS(code)) { ++counts[0]; }
+				else if (MSV_IS_INFO(code)) { ++counts[1]; }
+				else if (MSV_IS_WARN(code)) { ++counts[2]; }
+				else { ++counts[3]; }
+			}
+			benchmark::DoNotOptimize(counts);
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	template<MsvErrorBatchIsa Isa>
+	void BM_CountSeveritiesKernel(benchmark::State& state)
+	{
+		if (Isa == MsvErrorBatchIsa::Avx2 && MsvErrorBatch::GetIsa() != MsvErrorBatchIsa::Avx2)
+		{
+			state.SkipWithError("AVX2 is not supported.");
+			return;
+		}
+
+		std::vector<MsvErrorCode> codes = MakeBatch(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(codes.data());
+			benchmark::DoNotOptimize(MsvErrorBatchKernel<Isa>::CountSeverities(codes.data(), codes.size()));
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void BM_MaxSeverityLoop(benchmark::State& state)
+	{
+		std::vector<MsvErrorCode> codes = MakeBatch(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(codes.data());
+			MsvErrorCode worst = MSV_SUCCESS;
+			for (MsvErrorCode code : codes)
+			{
+				if (MSV_IS_ERROR(code)) { worst = code; break; }
+				if (MSV_IS_WARN(code) || (MSV_IS_INFO(code) && MSV_IS_SUCCESS(worst))) { worst = MSV_IS_WARN(worst) ? worst : code; }
+			}
+			benchmark::DoNotOptimize(worst);
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void BM_MaxSeverityBatch(benchmark::State& state)
+	{
+		std::vector<MsvErrorCode> codes = MakeBatch(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(codes.data());
+			benchmark::DoNotOptimize(MsvErrorBatch::MaxSeverity(codes));
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+}
+
+
+BENCHMARK(BM_FirstFailedLoop)->Name("MsvErrorBatch/FirstFailed/Loop")->Arg(1024)->Arg(16384);
+BENCHMARK(BM_FirstFailedBatch)->Name("MsvErrorBatch/FirstFailed/Batch")->Arg(1024)->Arg(16384);
+BENCHMARK(BM_CountSeveritiesLoop)->Name("MsvErrorBatch/CountSeverities/Loop")->Arg(1024)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_CountSeveritiesKernel, MsvErrorBatchIsa::Scalar)->Name("MsvErrorBatch/CountSeverities/Scalar")->Arg(1024)->Arg(16384);
+#ifdef MSV_ERROR_BATCH_X86
+BENCHMARK_TEMPLATE(BM_CountSeveritiesKernel, MsvErrorBatchIsa::Sse2)->Name("MsvErrorBatch/CountSeverities/Sse2")->Arg(1024)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_CountSeveritiesKernel, MsvErrorBatchIsa::Avx2)->Name("MsvErrorBatch/CountSeverities/Avx2")->Arg(1024)->Arg(16384);
+#endif
+BENCHMARK(BM_MaxSeverityLoop)->Name("MsvErrorBatch/MaxSeverity/Loop")->Arg(1024)->Arg(16384);
+BENCHMARK(BM_MaxSeverityBatch)->Name("MsvErrorBatch/MaxSeverity/Batch")->Arg(1024)->Arg(16384);
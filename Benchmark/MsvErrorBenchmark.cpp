@@ -0,0 +1,166 @@
+#include "MsvBenchmark.h"
+
+#include "../msverrorcodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/*
+Propagation macros (MSV_RETURN_FAILED, MSV_BREAK_FAILED, MSV_CONTINUE_FAILED) compared with the same code without
+branch hints (the way the macros were written before). All errorcodes are success except the last one - the failure
+branch is taken once per benchmark iteration.
+MSV_RETURN_FAILED is also measured through deep call stacks (errorcode is returned by the deepest function and
+checked by each caller).
+*/
+
+
+namespace
+{
+	const size_t CodeCount = 1 << 20;
+
+	std::vector<MsvErrorCode> CreateCodes()
+	{
+		std::vector<MsvErrorCode> codes(CodeCount, MSV_SUCCESS);
+		codes.back() = MSV_BUSY_ERROR;
+
+		return codes;
+	}
+
+	inline MsvErrorCode Step(const MsvErrorCode* codes, size_t index, int64_t& sum)
+	{
+		sum += static_cast<int64_t>(index);
+
+		return codes[index];
+	}
+
+	MsvErrorCode ReturnFailedHinted(const MsvErrorCode* codes, size_t count, int64_t& sum)
+	{
+		for (size_t index = 0; index < count; ++index)
+		{
+			MSV_RETURN_FAILED(Step(codes, index, sum));
+		}
+
+		return MSV_SUCCESS;
+	}
+
+	MsvErrorCode ReturnFailedPlain(const MsvErrorCode* codes, size_t count, int64_t& sum)
+	{
+		for (size_t index = 0; index < count; ++index)
+		{
+			MsvErrorCode errorCode = Step(codes, index, sum);
+			if (MSV_FAILED(errorCode)) { return errorCode; }
+		}
+
+		return MSV_SUCCESS;
+	}
+
+	size_t BreakFailedHinted(const MsvErrorCode* codes, size_t count, int64_t& sum)
+	{
+		size_t index = 0;
+		for (; index < count; ++index)
+		{
+			MSV_BREAK_FAILED(Step(codes, index, sum));
+		}
+
+		return index;
+	}
+
+	size_t BreakFailedPlain(const MsvErrorCode* codes, size_t count, int64_t& sum)
+	{
+		size_t index = 0;
+		for (; index < count; ++index)
+		{
+			if (MSV_FAILED(Step(codes, index, sum))) { break; }
+		}
+
+		return index;
+	}
+
+	size_t ContinueFailedHinted(const MsvErrorCode* codes, size_t count, int64_t& sum)
+	{
+		size_t succeeded = 0;
+		for (size_t index = 0; index < count; ++index)
+		{
+			MSV_CONTINUE_FAILED(Step(codes, index, sum));
+			++succeeded;
+		}
+
+		return succeeded;
+	}
+
+	size_t ContinueFailedPlain(const MsvErrorCode* codes, size_t count, int64_t& sum)
+	{
+		size_t succeeded = 0;
+		for (size_t index = 0; index < count; ++index)
+		{
+			if (MSV_FAILED(Step(codes, index, sum))) { continue; }
+			++succeeded;
+		}
+
+		return succeeded;
+	}
+
+	template<typename Result, Result (*Loop)(const MsvErrorCode*, size_t, int64_t&)>
+	void BM_PropagationLoop(benchmark::State& state)
+	{
+		std::vector<MsvErrorCode> codes = CreateCodes();
+		int64_t sum = 0;
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(Loop(codes.data(), codes.size(), sum));
+		}
+
+		benchmark::DoNotOptimize(sum);
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(codes.size()));
+	}
+
+	template<int Depth>
+	MSV_BENCHMARK_NOINLINE MsvErrorCode ReturnFailedDepth(MsvErrorCode errorCode)
+	{
+		MSV_RETURN_FAILED(ReturnFailedDepth<Depth - 1>(errorCode));
+
+		return MSV_SUCCESS;
+	}
+
+	template<>
+	MSV_BENCHMARK_NOINLINE MsvErrorCode ReturnFailedDepth<0>(MsvErrorCode errorCode)
+	{
+		benchmark::DoNotOptimize(errorCode);
+
+		return errorCode;
+	}
+
+	template<int Depth, MsvErrorCode ErrorCode>
+	void BM_ReturnFailedDepth(benchmark::State& state)
+	{
+		MsvErrorCode errorCode = ErrorCode;
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(errorCode);
+			benchmark::DoNotOptimize(ReturnFailedDepth<Depth>(errorCode));
+		}
+
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * Depth);
+	}
+}
+
+
+BENCHMARK_TEMPLATE(BM_PropagationLoop, MsvErrorCode, ReturnFailedHinted)->Name("MSV_RETURN_FAILED/Hinted");
+BENCHMARK_TEMPLATE(BM_PropagationLoop, MsvErrorCode, ReturnFailedPlain)->Name("MSV_RETURN_FAILED/Plain");
+BENCHMARK_TEMPLATE(BM_PropagationLoop, size_t, BreakFailedHinted)->Name("MSV_BREAK_FAILED/Hinted");
+BENCHMARK_TEMPLATE(BM_PropagationLoop, size_t, BreakFailedPlain)->Name("MSV_BREAK_FAILED/Plain");
+BENCHMARK_TEMPLATE(BM_PropagationLoop, size_t, ContinueFailedHinted)->Name("MSV_CONTINUE_FAILED/Hinted");
+BENCHMARK_TEMPLATE(BM_PropagationLoop, size_t, ContinueFailedPlain)->Name("MSV_CONTINUE_FAILED/Plain");
+
+BENCHMARK_TEMPLATE(BM_ReturnFailedDepth, 8, MSV_SUCCESS)->Name("MSV_RETURN_FAILED/Depth:8/Success");
+BENCHMARK_TEMPLATE(BM_ReturnFailedDepth, 8, MSV_BUSY_ERROR)->Name("MSV_RETURN_FAILED/Depth:8/Failure");
+BENCHMARK_TEMPLATE(BM_ReturnFailedDepth, 32, MSV_SUCCESS)->Name("MSV_RETURN_FAILED/Depth:32/Success");
+BENCHMARK_TEMPLATE(BM_ReturnFailedDepth, 32, MSV_BUSY_ERROR)->Name("MSV_RETURN_FAILED/Depth:32/Failure");
+BENCHMARK_TEMPLATE(BM_ReturnFailedDepth, 64, MSV_SUCCESS)->Name("MSV_RETURN_FAILED/Depth:64/Success");
+BENCHMARK_TEMPLATE(BM_ReturnFailedDepth, 64, MSV_BUSY_ERROR)->Name("MSV_RETURN_FAILED/Depth:64/Failure");
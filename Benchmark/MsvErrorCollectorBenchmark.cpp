@@ -0,0 +1,145 @@
+#include "MsvBenchmark.h"
+
+#include "../msverrorcollector.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/*
+Contention of failure aggregation - all threads report failure in each iteration (heavy failure rate) to one shared
+collector. MsvErrorCollector is compared with hand-rolled mutex protected vector (bounded the same way). Throughput
+should grow linearly with threads (up to count of hardware threads).
+Each thread runs fixed count of iterations and collectors are sized to capture all reports, so capture (not drop
+path) is measured. ReportFull measures reports to full collector (all reports are counted as dropped).
+*/
+
+
+namespace
+{
+	const MsvErrorCode benchmarkCodes[] = { MSV_BUSY_ERROR, MSV_OPEN_ERROR, MSV_STILL_RUNNING_WARN, MSV_PARSE_ERROR };
+
+	//iterations of each thread (collectors capture all of them)
+	const benchmark::IterationCount reportIterations = 1 << 16;
+
+	std::size_t GetCapacity(const benchmark::State& state)
+	{
+		return static_cast<std::size_t>(state.threads()) * static_cast<std::size_t>(reportIterations);
+	}
+
+	//hand-rolled baseline - first error, worst error and bounded errors under one mutex
+	struct MutexCollector
+	{
+		explicit MutexCollector(std::size_t errorCapacity) :
+			capacity(errorCapacity)
+		{
+			errors.reserve(errorCapacity);
+		}
+
+		std::size_t capacity;
+		std::mutex mutex;
+		MsvErrorCode firstError = MSV_SUCCESS;
+		MsvErrorCode worstError = MSV_SUCCESS;
+		std::vector<MsvErrorCode> errors;
+		std::size_t dropped = 0;
+
+		void Report(MsvErrorCode errorCode)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			firstError = MSV_FAILED(firstError) ? firstError : errorCode;
+			worstError = MsvErrorCodeSeverity(errorCode) > MsvErrorCodeSeverity(worstError) ? errorCode : worstError;
+			if (errors.size() < capacity) { errors.push_back(errorCode); } else { ++dropped; }
+		}
+	};
+
+	std::unique_ptr<MsvErrorCollector> collector;
+	std::unique_ptr<MutexCollector> mutexCollector;
+
+	MsvException MakeException(MsvErrorCode errorCode)
+	{
+		try
+		{
+			MSV_THROW(errorCode, "worker failed");
+		}
+		catch (const MsvException& exception)
+		{
+			return exception;
+		}
+	}
+
+	void BM_Report(benchmark::State& state)
+	{
+		if (state.thread_index() == 0)
+		{
+			collector.reset(new MsvErrorCollector(GetCapacity(state)));
+		}
+
+		std::size_t report = static_cast<std::size_t>(state.thread_index());
+		for (auto _ : state)
+		{
+			collector->Report(benchmarkCodes[++report & 3]);
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	void BM_ReportException(benchmark::State& state)
+	{
+		if (state.thread_index() == 0)
+		{
+			collector.reset(new MsvErrorCollector(GetCapacity(state)));
+		}
+
+		MsvException exceptions[] = { MakeException(benchmarkCodes[0]), MakeException(benchmarkCodes[1]), MakeException(benchmarkCodes[2]), MakeException(benchmarkCodes[3]) };
+		std::size_t report = static_cast<std::size_t>(state.thread_index());
+		for (auto _ : state)
+		{
+			collector->Report(exceptions[++report & 3]);
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	void BM_ReportFull(benchmark::State& state)
+	{
+		if (state.thread_index() == 0)
+		{
+			collector.reset(new MsvErrorCollector(0));
+		}
+
+		std::size_t report = static_cast<std::size_t>(state.thread_index());
+		for (auto _ : state)
+		{
+			collector->Report(benchmarkCodes[++report & 3]);
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	void BM_ReportMutex(benchmark::State& state)
+	{
+		if (state.thread_index() == 0)
+		{
+			mutexCollector.reset(new MutexCollector(GetCapacity(state)));
+		}
+
+		std::size_t report = static_cast<std::size_t>(state.thread_index());
+		for (auto _ : state)
+		{
+			mutexCollector->Report(benchmarkCodes[++report & 3]);
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+}
+
+
+BENCHMARK(BM_Report)->Name("MsvErrorCollector/Report")->ThreadRange(1, 64)->Iterations(reportIterations)->UseRealTime();
+BENCHMARK(BM_ReportException)->Name("MsvErrorCollector/ReportException")->ThreadRange(1, 64)->Iterations(reportIterations)->UseRealTime();
+BENCHMARK(BM_ReportFull)->Name("MsvErrorCollector/ReportFull")->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_ReportMutex)->Name("MsvErrorCollector/MutexVector")->ThreadRange(1, 64)->Iterations(reportIterations)->UseRealTime();
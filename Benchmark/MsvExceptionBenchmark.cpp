@@ -0,0 +1,165 @@
+#include "MsvBenchmark.h"
+
+#include "../msvexception.h"
+#include "../msverrorcodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <string>
+
+MSV_ENABLE_WARNINGS
+
+
+/*
+MsvException costs - throw and catch, rethrow chains (each level catches and rethrows), lazy what() formatting
+and MSV_THROW_FAILED on success and failure. Heap storage (long messages and formatted what()) is allocated from
+thread local recycling pool (default) and from the global heap (std::pmr::new_delete_resource).
+*/
+
+
+namespace
+{
+	MSV_BENCHMARK_NOINLINE void ThrowChain(int64_t depth)
+	{
+		if (depth <= 0)
+		{
+			//base case has visible success path (throw is noreturn) - GCC would report infinite recursion otherwise
+			MSV_THROW_FAILED(MSV_NOT_FOUND_ERROR, "Item not found.");
+			return;
+		}
+
+		try
+		{
+			ThrowChain(depth - 1);
+		}
+		catch (MsvException& exception)
+		{
+			MSV_RETHROW(exception, MSV_BUSY_ERROR, "Rethrowing.");
+		}
+	}
+
+	MsvException CreateException(int64_t frames)
+	{
+		MsvException exception(__FILE__, __LINE__, MSV_NOT_FOUND_ERROR, "Item not found.");
+		for (int64_t frame = 1; frame < frames; ++frame)
+		{
+			exception.Rethrowing(__FILE__, __LINE__, MSV_BUSY_ERROR, "Rethrowing.");
+		}
+
+		return exception;
+	}
+
+	void BM_Throw(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			try
+			{
+				MSV_THROW(MSV_NOT_FOUND_ERROR, "Item not found.");
+			}
+			catch (MsvException& exception)
+			{
+				benchmark::DoNotOptimize(exception.GetErrorCode());
+			}
+		}
+	}
+
+	void BM_Rethrow(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			try
+			{
+				ThrowChain(state.range(0));
+			}
+			catch (MsvException& exception)
+			{
+				benchmark::DoNotOptimize(exception.GetErrorCode());
+			}
+		}
+
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * (state.range(0) + 1));
+	}
+
+	void BM_Copy(benchmark::State& state)
+	{
+		MsvException prototype = CreateException(state.range(0));
+
+		for (auto _ : state)
+		{
+			MsvException exception(prototype);
+			benchmark::DoNotOptimize(&exception);
+		}
+	}
+
+	void BM_What(benchmark::State& state)
+	{
+		MsvException prototype = CreateException(state.range(0));
+
+		for (auto _ : state)
+		{
+			MsvException exception(prototype);
+			benchmark::DoNotOptimize(exception.what());
+		}
+
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+	}
+
+	void BM_WhatCached(benchmark::State& state)
+	{
+		MsvException exception = CreateException(state.range(0));
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(exception.what());
+		}
+	}
+
+#ifdef MSV_MEMORY_RESOURCE
+	void BM_HeapStorage(benchmark::State& state, bool pool)
+	{
+		std::string message(2 * MSV_EXCEPTION_WHAT_SIZE, 'x');
+		MsvExceptionMemoryResourceScope scope(pool ? nullptr : std::pmr::new_delete_resource());
+
+		for (auto _ : state)
+		{
+			MsvException exception("fileName", 10, MSV_BUSY_ERROR, message.c_str());
+			exception.Rethrowing("fileName", 20, MSV_EXECUTE_ERROR, message.c_str());
+			benchmark::DoNotOptimize(exception.what());
+		}
+	}
+#endif
+
+	template<MsvErrorCode ErrorCode>
+	void BM_ThrowFailed(benchmark::State& state)
+	{
+		MsvErrorCode errorCode = ErrorCode;
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(errorCode);
+
+			try
+			{
+				MSV_THROW_FAILED(errorCode, "Failed.");
+			}
+			catch (MsvException& exception)
+			{
+				benchmark::DoNotOptimize(exception.GetErrorCode());
+			}
+		}
+	}
+}
+
+
+BENCHMARK(BM_Throw)->Name("MSV_THROW");
+BENCHMARK(BM_Rethrow)->Name("MSV_RETHROW")->ArgName("Depth")->RangeMultiplier(2)->Range(1, 64);
+BENCHMARK(BM_Copy)->Name("MsvException/Copy")->ArgName("Frames")->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(BM_What)->Name("MsvException/What")->ArgName("Frames")->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(BM_WhatCached)->Name("MsvException/WhatCached")->ArgName("Frames")->RangeMultiplier(4)->Range(1, 64);
+#ifdef MSV_MEMORY_RESOURCE
+BENCHMARK_CAPTURE(BM_HeapStorage, Pool, true)->Name("MsvException/HeapStorage/Pool");
+BENCHMARK_CAPTURE(BM_HeapStorage, NewDelete, false)->Name("MsvException/HeapStorage/NewDelete");
+#endif
+BENCHMARK_TEMPLATE(BM_ThrowFailed, MSV_SUCCESS)->Name("MSV_THROW_FAILED/Success");
+BENCHMARK_TEMPLATE(BM_ThrowFailed, MSV_BUSY_ERROR)->Name("MSV_THROW_FAILED/Failure");
@@ -0,0 +1,132 @@
+#include "MsvBenchmark.h"
+
+#include "../msverrorcodes.h"
+#include "../msvexceptionhandle.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <exception>
+
+MSV_ENABLE_WARNINGS
+
+
+/*
+Transfer of caught exception from worker to requester - capture, 4 hops (moves through queues/futures) and the
+requester reads errorcode (exception_ptr has to be rethrown for it) or rethrows exception. MsvExceptionHandle is
+compared with std::exception_ptr (std::make_exception_ptr, std::rethrow_exception).
+*/
+
+
+namespace
+{
+	const int transferHops = 4;
+
+	MsvException MakeException()
+	{
+		try
+		{
+			MSV_THROW(MSV_BUSY_ERROR, "worker failed");
+		}
+		catch (const MsvException& exception)
+		{
+			return exception;
+		}
+	}
+
+	MSV_BENCHMARK_NOINLINE MsvExceptionHandle TransferHandle(const MsvException& exception)
+	{
+		MsvExceptionHandle handle(exception);
+		for (int hop = 0; hop < transferHops; ++hop)
+		{
+			MsvExceptionHandle next(std::move(handle));
+			handle = std::move(next);
+		}
+
+		return handle;
+	}
+
+	MSV_BENCHMARK_NOINLINE std::exception_ptr TransferExceptionPtr(const MsvException& exception)
+	{
+		std::exception_ptr pointer = std::make_exception_ptr(exception);
+		for (int hop = 0; hop < transferHops; ++hop)
+		{
+			std::exception_ptr next(std::move(pointer));
+			pointer = std::move(next);
+		}
+
+		return pointer;
+	}
+
+	void BM_HandleErrorCode(benchmark::State& state)
+	{
+		MsvException exception = MakeException();
+
+		for (auto _ : state)
+		{
+			MsvExceptionHandle handle = TransferHandle(exception);
+			benchmark::DoNotOptimize(handle.GetErrorCode());
+		}
+	}
+
+	void BM_ExceptionPtrErrorCode(benchmark::State& state)
+	{
+		MsvException exception = MakeException();
+
+		for (auto _ : state)
+		{
+			std::exception_ptr pointer = TransferExceptionPtr(exception);
+
+			try
+			{
+				std::rethrow_exception(pointer);
+			}
+			catch (const MsvException& transferred)
+			{
+				benchmark::DoNotOptimize(transferred.GetErrorCode());
+			}
+		}
+	}
+
+	void BM_HandleRethrow(benchmark::State& state)
+	{
+		MsvException exception = MakeException();
+
+		for (auto _ : state)
+		{
+			MsvExceptionHandle handle = TransferHandle(exception);
+
+			try
+			{
+				handle.Rethrow();
+			}
+			catch (const MsvException& transferred)
+			{
+				benchmark::DoNotOptimize(transferred.GetErrorCode());
+			}
+		}
+	}
+
+	void BM_ExceptionPtrRethrow(benchmark::State& state)
+	{
+		MsvException exception = MakeException();
+
+		for (auto _ : state)
+		{
+			std::exception_ptr pointer = TransferExceptionPtr(exception);
+
+			try
+			{
+				std::rethrow_exception(pointer);
+			}
+			catch (const MsvException& transferred)
+			{
+				benchmark::DoNotOptimize(transferred.GetErrorCode());
+			}
+		}
+	}
+}
+
+BENCHMARK(BM_HandleErrorCode)->Name("MsvExceptionHandle/ErrorCode");
+BENCHMARK(BM_ExceptionPtrErrorCode)->Name("MsvExceptionHandle/ExceptionPtrErrorCode");
+BENCHMARK(BM_HandleRethrow)->Name("MsvExceptionHandle/Rethrow");
+BENCHMARK(BM_ExceptionPtrRethrow)->Name("MsvExceptionHandle/ExceptionPtrRethrow");
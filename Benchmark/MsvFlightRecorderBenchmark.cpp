@@ -0,0 +1,40 @@
+#include "MsvBenchmark.h"
+
+#include "../msvflightrecorder.h"
+#include "../msverrorcodes.h"
+
+
+/*
+Flight recorder costs - one record (ring of current thread) and dump of all rings.
+*/
+
+
+namespace
+{
+	void BM_Record(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			MsvFlightRecorder::Record(MSV_BUSY_ERROR, __FILE__, __LINE__);
+		}
+	}
+
+	void BM_Dump(benchmark::State& state)
+	{
+		for (int record = 0; record < MSV_FLIGHT_RECORDER_SIZE; ++record)
+		{
+			MsvFlightRecorder::Record(MSV_BUSY_ERROR, __FILE__, __LINE__);
+		}
+
+		for (auto _ : state)
+		{
+			int64_t count = 0;
+			MsvFlightRecorder::Dump([&count](const MsvFlightRecord& record) { count += record.line; });
+			benchmark::DoNotOptimize(count);
+		}
+	}
+}
+
+
+BENCHMARK(BM_Record)->Name("MsvFlightRecorder/Record");
+BENCHMARK(BM_Dump)->Name("MsvFlightRecorder/Dump");
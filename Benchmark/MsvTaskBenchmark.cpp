@@ -0,0 +1,142 @@
+#include "MsvBenchmark.h"
+
+#include "../msverrorcodes.h"
+#include "../msvtask.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <exception>
+
+MSV_ENABLE_WARNINGS
+
+
+/*
+Failure propagation through chain of awaiting coroutines (argument is chain depth). MsvTask short circuits all awaiting
+coroutines without exceptions. The baseline is task which stores thrown exception (std::exception_ptr) and rethrows it
+from each co_await - MsvException thrown by the innermost coroutine crosses every await and it is caught on the top.
+Succeeded chains show the cost of awaits alone.
+*/
+
+
+#ifdef MSV_COROUTINES
+
+namespace
+{
+	//baseline task - exceptions are propagated through co_await
+	class ExceptionTask
+	{
+	public:
+		struct promise_type
+		{
+			int value = 0;
+			std::exception_ptr exception;
+			std::coroutine_handle<> continuation = std::noop_coroutine();
+
+			struct FinalAwaiter
+			{
+				bool await_ready() const noexcept { return false; }
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> coroutine) noexcept { return coroutine.promise().continuation; }
+				void await_resume() const noexcept { }
+			};
+
+			ExceptionTask get_return_object() noexcept { return ExceptionTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+			std::suspend_always initial_suspend() const noexcept { return {}; }
+			FinalAwaiter final_suspend() const noexcept { return {}; }
+			void return_value(int result) noexcept { value = result; }
+			void unhandled_exception() noexcept { exception = std::current_exception(); }
+		};
+
+		explicit ExceptionTask(std::coroutine_handle<promise_type> coroutine) noexcept : m_coroutine(coroutine) { }
+		ExceptionTask(ExceptionTask&& origin) noexcept : m_coroutine(std::exchange(origin.m_coroutine, nullptr)) { }
+		~ExceptionTask() { if (m_coroutine) { m_coroutine.destroy(); } }
+
+		bool await_ready() const noexcept { return false; }
+
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+		{
+			m_coroutine.promise().continuation = awaiting;
+			return m_coroutine;
+		}
+
+		int await_resume() const
+		{
+			if (m_coroutine.promise().exception)
+			{
+				std::rethrow_exception(m_coroutine.promise().exception);
+			}
+
+			return m_coroutine.promise().value;
+		}
+
+		int Run()
+		{
+			m_coroutine.resume();
+			return await_resume();
+		}
+
+	private:
+		std::coroutine_handle<promise_type> m_coroutine;
+	};
+
+	MsvTask<int> TaskChain(int64_t depth, bool fail)
+	{
+		if (depth == 0)
+		{
+			if (fail)
+			{
+				co_return MsvFailure(MSV_BUSY_ERROR);
+			}
+
+			co_return 1;
+		}
+
+		co_return co_await TaskChain(depth - 1, fail) + 1;
+	}
+
+	ExceptionTask ExceptionChain(int64_t depth, bool fail)
+	{
+		if (depth == 0)
+		{
+			if (fail)
+			{
+				MSV_THROW(MSV_BUSY_ERROR, "operation failed");
+			}
+
+			co_return 1;
+		}
+
+		co_return co_await ExceptionChain(depth - 1, fail) + 1;
+	}
+
+	void BM_Task(benchmark::State& state, bool fail)
+	{
+		for (auto _ : state)
+		{
+			MsvResult<int> result = TaskChain(state.range(0), fail).Run();
+			benchmark::DoNotOptimize(result);
+		}
+	}
+
+	void BM_ExceptionTask(benchmark::State& state, bool fail)
+	{
+		for (auto _ : state)
+		{
+			try
+			{
+				int value = ExceptionChain(state.range(0), fail).Run();
+				benchmark::DoNotOptimize(value);
+			}
+			catch (const MsvException& exception)
+			{
+				benchmark::DoNotOptimize(exception.GetErrorCode());
+			}
+		}
+	}
+}
+
+BENCHMARK_CAPTURE(BM_Task, Failure, true)->Name("MsvTask/Failure")->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK_CAPTURE(BM_ExceptionTask, Failure, true)->Name("MsvTask/ExceptionFailure")->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK_CAPTURE(BM_Task, Success, false)->Name("MsvTask/Success")->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK_CAPTURE(BM_ExceptionTask, Success, false)->Name("MsvTask/ExceptionSuccess")->Arg(1)->Arg(4)->Arg(16);
+
+#endif // MSV_COROUTINES
@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+"""
+Prints scaling curves of MarsTech Error throw scaling benchmarks (Google Benchmark JSON output of MsvThrowScaling/*
+benchmarks) - throughput of each variant per thread count and its speedup against one thread.
+
+Usage: MsvThrowScaling.py <results.json>
+
+Medians are used when results contain repetitions (MsvThrowScalingJson target), otherwise plain runs. Speedup
+should follow thread count up to the count of hardware threads (reported in the results context) - flat or falling
+curve means contention.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+
+def load_throughputs(path):
+	with open(path, encoding="utf-8") as file:
+		results = json.load(file)
+
+	medians = {}
+	runs = {}
+	for benchmark in results["benchmarks"]:
+		match = re.match(r"MsvThrowScaling/([^/]+)/.*threads:(\d+)$", benchmark.get("run_name", benchmark["name"]))
+		if not match or "items_per_second" not in benchmark:
+			continue
+
+		key = (match.group(1), int(match.group(2)))
+		if benchmark.get("aggregate_name") == "median":
+			medians[key] = benchmark["items_per_second"]
+		elif benchmark.get("run_type", "iteration") == "iteration":
+			runs.setdefault(key, benchmark["items_per_second"])
+
+	return results.get("context", {}), medians if medians else runs
+
+
+def main():
+	parser = argparse.ArgumentParser(description="Print MarsTech Error throw scaling curves.")
+	parser.add_argument("results", help="JSON results.")
+	arguments = parser.parse_args()
+
+	context, throughputs = load_throughputs(arguments.results)
+	if not throughputs:
+		print("no MsvThrowScaling results")
+		return 1
+
+	variants = sorted({variant for variant, _ in throughputs})
+	threads = sorted({threadCount for _, threadCount in throughputs})
+
+	print("hardware threads: %s" % context.get("num_cpus", "unknown"))
+	print("throughput (throws per second) / speedup against 1 thread")
+	print("%-24s" % "threads" + "".join("%18d" % threadCount for threadCount in threads))
+	for variant in variants:
+		single = throughputs.get((variant, 1))
+		cells = []
+		for threadCount in threads:
+			throughput = throughputs.get((variant, threadCount))
+			if throughput is None:
+				cells.append("%18s" % "-")
+			else:
+				cells.append("%11.0f/%5.1fx" % (throughput, throughput / single if single else 0.0))
+		print("%-24s" % variant + "".join(cells))
+
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
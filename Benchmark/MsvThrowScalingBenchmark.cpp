@@ -0,0 +1,124 @@
+#include "MsvBenchmark.h"
+
+#include "../msverrorcodes.h"
+#include "../msvexception.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+MSV_ENABLE_WARNINGS
+
+
+/*
+Failure storm - all threads throw, catch and format (what()) exception in each iteration. Throughput should grow
+linearly with threads (up to count of hardware threads) - flat or falling curve means contention.
+ - MsvException - short and long (heap stored) message, heap storage from thread local pool (default).
+ - GlobalHeap - long message, heap storage from the global heap (std::pmr::new_delete_resource).
+ - Legacy - formatting of the original MsvException (std::stringstream and std::string per throw - locale reference
+   counting and global heap).
+ - RuntimeError - std::runtime_error with std::string message (cost of C++ runtime - allocation and unwinding).
+*/
+
+
+namespace
+{
+	//the original MsvException (formats message by std::stringstream in constructor)
+	class LegacyException :
+		public std::exception
+	{
+	public:
+		LegacyException(const char* fileName, int line, MsvErrorCode errorCode, const char* msg) :
+			m_errorCode(errorCode)
+		{
+			std::stringstream data;
+			data << std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()) << " 0x" << std::setfill('0') << std::setw(8) << errorCode << " " << fileName << ":" << line << " " << msg << std::endl;
+			m_what = data.str();
+		}
+
+		const char* what() const noexcept override
+		{
+			return m_what.c_str();
+		}
+
+	private:
+		MsvErrorCode m_errorCode;
+		std::string m_what;
+	};
+
+	//long message is stored on the heap
+	const std::string longMessage(2 * MSV_EXCEPTION_WHAT_SIZE, 'x');
+
+	MSV_BENCHMARK_NOINLINE void ThrowMsvException(const char* msg)
+	{
+		MSV_THROW(MSV_BUSY_ERROR, msg);
+	}
+
+	MSV_BENCHMARK_NOINLINE void ThrowLegacyException(const char* msg)
+	{
+		throw LegacyException(__FILE__, __LINE__, MSV_BUSY_ERROR, msg);
+	}
+
+	MSV_BENCHMARK_NOINLINE void ThrowRuntimeError(const char* msg)
+	{
+		throw std::runtime_error(msg);
+	}
+
+	template<typename Exception>
+	void Throw(benchmark::State& state, void (*thrower)(const char*), const char* msg)
+	{
+		for (auto _ : state)
+		{
+			try
+			{
+				thrower(msg);
+			}
+			catch (const Exception& exception)
+			{
+				benchmark::DoNotOptimize(exception.what());
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	void BM_MsvException(benchmark::State& state)
+	{
+		Throw<MsvException>(state, ThrowMsvException, "Failed.");
+	}
+
+	void BM_MsvExceptionLongMessage(benchmark::State& state)
+	{
+		Throw<MsvException>(state, ThrowMsvException, longMessage.c_str());
+	}
+
+#ifdef MSV_MEMORY_RESOURCE
+	void BM_GlobalHeap(benchmark::State& state)
+	{
+		MsvExceptionMemoryResourceScope scope(std::pmr::new_delete_resource());
+		Throw<MsvException>(state, ThrowMsvException, longMessage.c_str());
+	}
+#endif
+
+	void BM_Legacy(benchmark::State& state)
+	{
+		Throw<LegacyException>(state, ThrowLegacyException, "Failed.");
+	}
+
+	void BM_RuntimeError(benchmark::State& state)
+	{
+		Throw<std::runtime_error>(state, ThrowRuntimeError, "Failed.");
+	}
+}
+
+BENCHMARK(BM_MsvException)->Name("MsvThrowScaling/MsvException")->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_MsvExceptionLongMessage)->Name("MsvThrowScaling/MsvExceptionLongMessage")->ThreadRange(1, 64)->UseRealTime();
+#ifdef MSV_MEMORY_RESOURCE
+BENCHMARK(BM_GlobalHeap)->Name("MsvThrowScaling/GlobalHeap")->ThreadRange(1, 64)->UseRealTime();
+#endif
+BENCHMARK(BM_Legacy)->Name("MsvThrowScaling/Legacy")->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_RuntimeError)->Name("MsvThrowScaling/RuntimeError")->ThreadRange(1, 64)->UseRealTime();
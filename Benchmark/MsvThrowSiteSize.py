@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""
+Compares code size of two object files with the same throw sites (Benchmark/MsvThrowSites.cpp) - outlined throws
+(default) and inline throws (MSV_INLINE_THROW).
+
+Usage: MsvThrowSiteSize.py <outlined.o> <inline.o> [--size <size tool>]
+
+Sections are read by binutils size (ELF objects of GCC/Clang) and grouped:
+ - hot text: .text (functions with throw sites)
+ - shared text: .text.<symbol> (inline functions shared by all sites - COMDAT sections)
+ - cold text: .text.unlikely, .text.cold (cold functions and split cold parts)
+ - unwind: .eh_frame, .gcc_except_table
+"""
+
+import argparse
+import subprocess
+import sys
+
+
+def load_sections(size, path):
+	output = subprocess.run([size, "-A", path], check=True, capture_output=True, text=True).stdout
+
+	groups = { "hot text": 0, "shared text": 0, "cold text": 0, "unwind": 0 }
+	for line in output.splitlines():
+		fields = line.split()
+		if len(fields) < 2 or not fields[1].isdigit():
+			continue
+
+		name = fields[0]
+		length = int(fields[1])
+		if name == ".text":
+			groups["hot text"] += length
+		elif name.startswith(".text.unlikely") or name.startswith(".text.cold"):
+			groups["cold text"] += length
+		elif name.startswith(".text."):
+			groups["shared text"] += length
+		elif name in (".eh_frame", ".gcc_except_table"):
+			groups["unwind"] += length
+
+	return groups
+
+
+def main():
+	parser = argparse.ArgumentParser(description="Compare code size of outlined and inline throw sites.")
+	parser.add_argument("outlined", help="Object file with outlined throws.")
+	parser.add_argument("inline", help="Object file with inline throws (MSV_INLINE_THROW).")
+	parser.add_argument("--size", default="size", help="Size tool (default size).")
+	arguments = parser.parse_args()
+
+	outlined = load_sections(arguments.size, arguments.outlined)
+	inline = load_sections(arguments.size, arguments.inline)
+
+	print("%-14s %10s %10s %10s" % ("section", "inline", "outlined", "change"))
+	for name in outlined:
+		change = (outlined[name] - inline[name]) / inline[name] * 100.0 if inline[name] else 0.0
+		print("%-14s %10d %10d %+9.1f%%" % (name, inline[name], outlined[name], change))
+
+	inlineTotal = sum(inline.values())
+	outlinedTotal = sum(outlined.values())
+	print("%-14s %10d %10d %+9.1f%%" % ("total", inlineTotal, outlinedTotal, (outlinedTotal - inlineTotal) / inlineTotal * 100.0))
+
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -0,0 +1,32 @@
+#include "../msvexception.h"
+#include "../msverrorcodes.h"
+
+
+/*
+Sample translation unit with 100 throw sites for throw site size report (MsvThrowSiteSize target). It is compiled with
+outlined throws (default) and with MSV_INLINE_THROW (construction inlined to each site) and .text sizes are compared
+by MsvThrowSiteSize.py.
+*/
+
+
+#define MSV_THROW_SITE(index) \
+MsvErrorCode MsvThrowSite##index(MsvErrorCode errorCode, int value) \
+{ \
+	MSV_THROW_FAILED(errorCode, "Throw site " #index " failed."); \
+	return value > index ? MSV_SUCCESS : MSV_NOT_FOUND_INFO; \
+}
+
+#define MSV_THROW_SITES_10(tens) \
+MSV_THROW_SITE(tens##0) MSV_THROW_SITE(tens##1) MSV_THROW_SITE(tens##2) MSV_THROW_SITE(tens##3) MSV_THROW_SITE(tens##4) \
+MSV_THROW_SITE(tens##5) MSV_THROW_SITE(tens##6) MSV_THROW_SITE(tens##7) MSV_THROW_SITE(tens##8) MSV_THROW_SITE(tens##9)
+
+MSV_THROW_SITES_10(1)
+MSV_THROW_SITES_10(2)
+MSV_THROW_SITES_10(3)
+MSV_THROW_SITES_10(4)
+MSV_THROW_SITES_10(5)
+MSV_THROW_SITES_10(6)
+MSV_THROW_SITES_10(7)
+MSV_THROW_SITES_10(8)
+MSV_THROW_SITES_10(9)
+MSV_THROW_SITES_10(10)
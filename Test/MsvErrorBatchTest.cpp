@@ -0,0 +1,148 @@
+#include "pch.h"
+
+#include "../msverrorbatch.h"
+#include "../msverrorcodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <array>
+#include <random>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+namespace
+{
+	//random error codes, failed (and info) ones are rare like in real batches
+	std::vector<MsvErrorCode> MakeCodes(std::mt19937& random, std::size_t count, uint32_t failedPercent)
+	{
+		std::vector<MsvErrorCode> codes(count);
+		for (MsvErrorCode& code : codes)
+		{
+			uint32_t value = random();
+			code = static_cast<MsvErrorCode>(value % 100 < failedPercent ? value : value & 0x7FFFFFFF);
+		}
+
+		return codes;
+	}
+
+	template<MsvErrorBatchIsa Isa>
+	void ExpectKernelMatchesScalar(const MsvErrorCode* codes, std::size_t count)
+	{
+		typedef MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar> Scalar;
+		typedef MsvErrorBatchKernel<Isa> Kernel;
+
+		EXPECT_EQ(Kernel::AnyFailed(codes, count), Scalar::AnyFailed(codes, count));
+		EXPECT_EQ(Kernel::FirstFailed(codes, count), Scalar::FirstFailed(codes, count));
+		EXPECT_EQ(Kernel::MaxSeverity(codes, count), Scalar::MaxSeverity(codes, count));
+
+		MsvErrorSeverityCounts expected = Scalar::CountSeverities(codes, count);
+		MsvErrorSeverityCounts counts = Kernel::CountSeverities(codes, count);
+		for (std::size_t severity = 0; severity < 4; ++severity)
+		{
+			EXPECT_EQ(counts.counts[severity], expected.counts[severity]);
+		}
+	}
+
+	void ExpectKernelsMatchScalar(const MsvErrorCode* codes, std::size_t count)
+	{
+#ifdef MSV_ERROR_BATCH_X86
+		ExpectKernelMatchesScalar<MsvErrorBatchIsa::Sse2>(codes, count);
+
+		if (MsvErrorBatch::GetIsa() == MsvErrorBatchIsa::Avx2)
+		{
+			ExpectKernelMatchesScalar<MsvErrorBatchIsa::Avx2>(codes, count);
+		}
+#endif
+
+		EXPECT_EQ(MsvErrorBatch::FirstFailed(codes, count), MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::FirstFailed(codes, count));
+	}
+}
+
+
+TEST(MsvErrorBatchTest, ItShouldClassifyEmptyBatch)
+{
+	EXPECT_FALSE(MsvErrorBatch::AnyFailed(nullptr, 0));
+	EXPECT_EQ(MsvErrorBatch::FirstFailed(nullptr, 0), 0);
+	EXPECT_EQ(MsvErrorBatch::MaxSeverity(nullptr, 0), 0);
+	EXPECT_EQ(MsvErrorBatch::CountSeverities(nullptr, 0).counts[0], 0);
+}
+
+TEST(MsvErrorBatchTest, ItShouldClassifyBatch)
+{
+	std::vector<MsvErrorCode> codes(100, MSV_SUCCESS);
+	EXPECT_FALSE(MsvErrorBatch::AnyFailed(codes));
+	EXPECT_EQ(MsvErrorBatch::FirstFailed(codes), codes.size());
+	EXPECT_EQ(MsvErrorBatch::MaxSeverity(codes), 0);
+
+	codes[70] = MSV_NOT_FOUND_INFO;
+	EXPECT_FALSE(MsvErrorBatch::AnyFailed(codes));
+	EXPECT_EQ(MsvErrorBatch::MaxSeverity(codes), 1);
+
+	codes[90] = MSV_BUSY_ERROR;
+	codes[50] = MSV_STILL_RUNNING_WARN;
+	codes[97] = MSV_STILL_RUNNING_WARN;
+	EXPECT_TRUE(MsvErrorBatch::AnyFailed(codes));
+	EXPECT_EQ(MsvErrorBatch::FirstFailed(codes), 50);
+	EXPECT_EQ(MsvErrorBatch::MaxSeverity(codes), 3);
+
+	MsvErrorSeverityCounts counts = MsvErrorBatch::CountSeverities(codes);
+	EXPECT_EQ(counts.counts[0], 96);
+	EXPECT_EQ(counts.counts[1], 1);
+	EXPECT_EQ(counts.counts[2], 2);
+	EXPECT_EQ(counts.counts[3], 1);
+}
+
+TEST(MsvErrorBatchTest, ItShouldFindFailureInEachPosition)
+{
+	for (std::size_t count = 1; count <= 80; ++count)
+	{
+		for (std::size_t position = 0; position < count; ++position)
+		{
+			std::vector<MsvErrorCode> codes(count, MSV_ALREADY_SET_INFO);
+			codes[position] = MSV_STILL_RUNNING_WARN;
+
+			ExpectKernelsMatchScalar(codes.data(), count);
+			ASSERT_EQ(MsvErrorBatch::FirstFailed(codes), position);
+		}
+	}
+}
+
+TEST(MsvErrorBatchTest, ItShouldMatchScalarForRandomUnalignedBatches)
+{
+	std::mt19937 random(16);
+
+	for (uint32_t failedPercent : { 0u, 1u, 50u, 100u })
+	{
+		std::vector<MsvErrorCode> codes = MakeCodes(random, 1000, failedPercent);
+
+		for (std::size_t offset = 0; offset < 8; ++offset)
+		{
+			for (std::size_t count : { std::size_t(0), std::size_t(3), std::size_t(31), std::size_t(33), std::size_t(257), codes.size() - offset })
+			{
+				ExpectKernelsMatchScalar(codes.data() + offset, count);
+			}
+		}
+	}
+}
+
+TEST(MsvErrorBatchTest, ItShouldDetectSupportedIsa)
+{
+#ifdef MSV_ERROR_BATCH_X86
+	EXPECT_NE(MsvErrorBatch::GetIsa(), MsvErrorBatchIsa::Scalar);
+#else
+	EXPECT_EQ(MsvErrorBatch::GetIsa(), MsvErrorBatchIsa::Scalar);
+#endif
+	EXPECT_EQ(MsvErrorBatch::GetIsa(), MsvErrorBatch::GetIsa());
+}
+
+TEST(MsvErrorBatchTest, ItShouldAcceptArrays)
+{
+	std::array<MsvErrorCode, 5> codes = { MSV_SUCCESS, MSV_NOT_SET_INFO, MSV_SUCCESS, MSV_SUCCESS, MSV_OPEN_ERROR };
+
+	EXPECT_TRUE(MsvErrorBatch::AnyFailed(codes));
+	EXPECT_EQ(MsvErrorBatch::FirstFailed(codes), 4);
+	EXPECT_EQ(MsvErrorBatch::MaxSeverity(codes), 3);
+	EXPECT_EQ(MsvErrorBatch::CountSeverities(codes).counts[0], 3);
+}
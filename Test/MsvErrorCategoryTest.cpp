@@ -0,0 +1,74 @@
+#include "pch.h"
+
+#include "../msverrorcategory.h"
+
+#include "MsvErrorTestConstants.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cerrno>
+#include <system_error>
+
+MSV_ENABLE_WARNINGS
+
+
+TEST(MsvErrorCategoryTest, ItShouldMakeErrorCode)
+{
+	std::error_code errorCode = make_error_code(MSV_BUSY_ERROR);
+
+	EXPECT_TRUE(errorCode);
+	EXPECT_EQ(errorCode.value(), MSV_BUSY_ERROR);
+	EXPECT_EQ(errorCode.category(), MsvGetErrorCategory());
+	EXPECT_STREQ(errorCode.category().name(), "MarsTech");
+	EXPECT_FALSE(make_error_code(MSV_SUCCESS));
+}
+
+TEST(MsvErrorCategoryTest, ItShouldReturnRegisteredDescriptions)
+{
+	EXPECT_STREQ(MsvErrorCategory::GetDescription(MSV_BUSY_ERROR), MsvErrorCodeDescription(MSV_BUSY_ERROR));
+	EXPECT_EQ(make_error_code(MSV_NOT_FOUND_ERROR).message(), MsvErrorCodeDescription(MSV_NOT_FOUND_ERROR));
+	EXPECT_EQ(make_error_code(MSV_NOT_FOUND_INFO).message(), MsvErrorCodeDescription(MSV_NOT_FOUND_INFO));
+}
+
+TEST(MsvErrorCategoryTest, ItShouldReturnGenericDescriptionOfNotRegisteredErrorCode)
+{
+	EXPECT_STREQ(MsvErrorCategory::GetDescription(MSV_ERROR_MIDDLE), "Unknown MarsTech error.");
+	EXPECT_STREQ(MsvErrorCategory::GetDescription(MSV_INFO_MIDDLE), "Unknown MarsTech status.");
+}
+
+TEST(MsvErrorCategoryTest, ItShouldCompareEqualToEquivalentErrc)
+{
+	EXPECT_EQ(make_error_code(MSV_NOT_FOUND_ERROR), std::errc::no_such_file_or_directory);
+	EXPECT_EQ(make_error_code(MSV_DOES_NOT_EXIST_ERROR), std::errc::no_such_file_or_directory);
+	EXPECT_EQ(make_error_code(MSV_BUSY_ERROR), std::errc::device_or_resource_busy);
+	EXPECT_EQ(make_error_code(MSV_ALLOCATION_ERROR), std::errc::not_enough_memory);
+	EXPECT_NE(make_error_code(MSV_BUSY_ERROR), std::errc::no_such_file_or_directory);
+	EXPECT_NE(make_error_code(MSV_PARSE_ERROR), std::errc::invalid_argument);
+}
+
+TEST(MsvErrorCategoryTest, ItShouldCompareEqualToSystemErrorCode)
+{
+	std::error_code systemError(ENOENT, std::system_category());
+
+	EXPECT_EQ(make_error_code(MSV_NOT_FOUND_ERROR).default_error_condition(), systemError.default_error_condition());
+	EXPECT_EQ(systemError, make_error_code(MSV_NOT_FOUND_ERROR).default_error_condition());
+}
+
+TEST(MsvErrorCategoryTest, ItShouldKeepOwnConditionOfNotEquivalentErrorCode)
+{
+	std::error_condition condition = make_error_code(MSV_PARSE_ERROR).default_error_condition();
+
+	EXPECT_EQ(condition.category(), MsvGetErrorCategory());
+	EXPECT_EQ(condition.value(), MSV_PARSE_ERROR);
+}
+
+TEST(MsvErrorCategoryTest, ItShouldConvertErrorCodeToMarsTechErrorCode)
+{
+	EXPECT_EQ(MsvErrorCodeFromErrorCode(std::error_code()), MSV_SUCCESS);
+	EXPECT_EQ(MsvErrorCodeFromErrorCode(make_error_code(MSV_PARSE_ERROR)), MSV_PARSE_ERROR);
+	EXPECT_EQ(MsvErrorCodeFromErrorCode(make_error_code(MSV_NOT_FOUND_INFO)), MSV_NOT_FOUND_INFO);
+	EXPECT_EQ(MsvErrorCodeFromErrorCode(std::make_error_code(std::errc::no_such_file_or_directory)), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(MsvErrorCodeFromErrorCode(std::make_error_code(std::errc::device_or_resource_busy)), MSV_BUSY_ERROR);
+	EXPECT_EQ(MsvErrorCodeFromErrorCode(std::error_code(ENOENT, std::system_category())), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(MsvErrorCodeFromErrorCode(std::make_error_code(std::errc::broken_pipe)), MSV_UNKNOWN_ERROR);
+}
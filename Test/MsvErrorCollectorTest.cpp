@@ -0,0 +1,162 @@
+#include "pch.h"
+
+#include "../msverrorcollector.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+namespace
+{
+	MsvException MakeException(MsvErrorCode errorCode, const char* msg)
+	{
+		try
+		{
+			MSV_THROW(errorCode, msg);
+		}
+		catch (const MsvException& exception)
+		{
+			return exception;
+		}
+	}
+}
+
+
+TEST(MsvErrorCollectorTest, ItShouldNotFailWithoutFailures)
+{
+	MsvErrorCollector collector;
+	collector.Report(MSV_SUCCESS);
+	collector.Report(MSV_NOT_FOUND_INFO);
+
+	EXPECT_FALSE(collector.Failed());
+	EXPECT_EQ(collector.GetFirstError(), MSV_SUCCESS);
+	EXPECT_EQ(collector.GetWorstError(), MSV_SUCCESS);
+	EXPECT_EQ(collector.GetErrorCount(), 0);
+	EXPECT_EQ(collector.GetException(MSV_BUSY_ERROR), nullptr);
+}
+
+TEST(MsvErrorCollectorTest, ItShouldKeepFirstAndWorstError)
+{
+	MsvErrorCollector collector;
+	collector.Report(MSV_STILL_RUNNING_WARN);
+	collector.Report(MSV_BUSY_ERROR);
+	collector.Report(MSV_OPEN_ERROR);
+	collector.Report(MSV_STILL_RUNNING_WARN);
+
+	EXPECT_TRUE(collector.Failed());
+	EXPECT_EQ(collector.GetFirstError(), MSV_STILL_RUNNING_WARN);
+	EXPECT_EQ(collector.GetWorstError(), MSV_BUSY_ERROR);
+	EXPECT_EQ(collector.GetErrorCount(), 4);
+}
+
+TEST(MsvErrorCollectorTest, ItShouldCaptureBoundedErrors)
+{
+	MsvErrorCollector collector(16);
+	ASSERT_GE(collector.GetCapacity(), 16);
+
+	std::size_t reports = collector.GetCapacity() + 10;
+	for (std::size_t index = 0; index < reports; ++index)
+	{
+		collector.Report(index % 2 ? MSV_BUSY_ERROR : MSV_OPEN_ERROR);
+	}
+
+	std::map<MsvErrorCode, std::size_t> counts;
+	collector.ForEachError([&counts](MsvErrorCode errorCode) { ++counts[errorCode]; });
+
+	//one thread fills all stripes (its own one first)
+	EXPECT_EQ(collector.GetErrorCount(), reports);
+	EXPECT_EQ(collector.GetDroppedCount(), 10);
+	EXPECT_EQ(counts[MSV_OPEN_ERROR] + counts[MSV_BUSY_ERROR], collector.GetCapacity());
+	EXPECT_EQ(counts[MSV_OPEN_ERROR], (collector.GetCapacity() + 1) / 2);
+}
+
+TEST(MsvErrorCollectorTest, ItShouldStoreFirstExceptionOfEachErrorCode)
+{
+	MsvErrorCollector collector;
+	collector.Report(MakeException(MSV_BUSY_ERROR, "first busy"));
+	collector.Report(MakeException(MSV_BUSY_ERROR, "second busy"));
+	collector.Report(MakeException(MSV_OPEN_ERROR, "open"));
+
+	const MsvException* busy = collector.GetException(MSV_BUSY_ERROR);
+	const MsvException* open = collector.GetException(MSV_OPEN_ERROR);
+	ASSERT_NE(busy, nullptr);
+	ASSERT_NE(open, nullptr);
+	EXPECT_STREQ(busy->GetFrame(0).message, "first busy");
+	EXPECT_STREQ(open->GetFrame(0).message, "open");
+	EXPECT_NE(std::string(busy->what()).find("first busy"), std::string::npos);
+
+	EXPECT_EQ(collector.GetException(MSV_PARSE_ERROR), nullptr);
+	EXPECT_EQ(collector.GetFirstError(), MSV_BUSY_ERROR);
+	EXPECT_EQ(collector.GetErrorCount(), 3);
+}
+
+TEST(MsvErrorCollectorTest, ItShouldBoundStoredExceptions)
+{
+	MsvErrorCollector collector(64, 2);
+	collector.Report(MakeException(MSV_BUSY_ERROR, "busy"));
+	collector.Report(MakeException(MSV_OPEN_ERROR, "open"));
+	collector.Report(MakeException(MSV_PARSE_ERROR, "parse"));
+
+	EXPECT_NE(collector.GetException(MSV_BUSY_ERROR), nullptr);
+	EXPECT_NE(collector.GetException(MSV_OPEN_ERROR), nullptr);
+	EXPECT_EQ(collector.GetException(MSV_PARSE_ERROR), nullptr);
+	EXPECT_EQ(collector.GetErrorCount(), 3);
+}
+
+TEST(MsvErrorCollectorTest, ItShouldCollectFromParallelWorkers)
+{
+	const MsvErrorCode codes[] = { MSV_BUSY_ERROR, MSV_OPEN_ERROR, MSV_STILL_RUNNING_WARN, MSV_PARSE_ERROR };
+	const int threadCount = 8;
+	const int reportCount = 2000;
+
+	MsvErrorCollector collector(threadCount * reportCount);
+	std::atomic<bool> start(false);
+	std::vector<std::thread> threads;
+
+	for (int thread = 0; thread < threadCount; ++thread)
+	{
+		threads.emplace_back([&, thread]()
+		{
+			while (!start.load()) { std::this_thread::yield(); }
+
+			for (int report = 0; report < reportCount; ++report)
+			{
+				MsvErrorCode errorCode = codes[(thread + report) % 4];
+				if (report % 100 == 0)
+				{
+					collector.Report(MakeException(errorCode, "worker"));
+				}
+				else
+				{
+					collector.Report(errorCode);
+				}
+			}
+		});
+	}
+
+	start.store(true);
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	std::map<MsvErrorCode, std::size_t> counts;
+	collector.ForEachError([&counts](MsvErrorCode errorCode) { ++counts[errorCode]; });
+
+	EXPECT_EQ(collector.GetErrorCount(), static_cast<std::size_t>(threadCount * reportCount));
+	EXPECT_EQ(collector.GetDroppedCount(), 0);
+	EXPECT_EQ(MsvErrorCodeSeverity(collector.GetWorstError()), 3);
+	for (MsvErrorCode errorCode : codes)
+	{
+		EXPECT_EQ(counts[errorCode], static_cast<std::size_t>(threadCount * reportCount / 4));
+		ASSERT_NE(collector.GetException(errorCode), nullptr);
+		EXPECT_EQ(collector.GetException(errorCode)->GetErrorCode(), errorCode);
+	}
+}
@@ -0,0 +1,175 @@
+#include "pch.h"
+
+//error counters are enabled for the whole test binary (MSV_ERROR_COUNTERS is defined by build)
+#include "../msverrorcounters.h"
+#include "../msverrorcodes.h"
+#include "../msvexception.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+namespace
+{
+	MsvErrorCode ReturnFailed(MsvErrorCode errorCode)
+	{
+		MSV_RETURN_FAILED(errorCode);
+
+		return MSV_SUCCESS;
+	}
+
+	void ThrowFailed(MsvErrorCode errorCode)
+	{
+		try
+		{
+			MSV_THROW_FAILED(errorCode, "failed");
+		}
+		catch (const MsvException&)
+		{
+
+		}
+	}
+}
+
+
+TEST(MsvErrorCountersTest, ItShouldCountReturnedFailures)
+{
+	MsvErrorCountersSnapshot before = MsvErrorCounters::GetSnapshot();
+
+	ReturnFailed(MSV_NOT_FOUND_ERROR);
+	ReturnFailed(MSV_NOT_FOUND_ERROR);
+	ReturnFailed(MSV_STILL_RUNNING_WARN);
+	ReturnFailed(MSV_SUCCESS);
+	ReturnFailed(MSV_NOT_FOUND_INFO);
+
+	MsvErrorCountersSnapshot after = MsvErrorCounters::GetSnapshot();
+	EXPECT_EQ(after.GetCount(MSV_NOT_FOUND_ERROR) - before.GetCount(MSV_NOT_FOUND_ERROR), 2);
+	EXPECT_EQ(after.GetCount(MSV_STILL_RUNNING_WARN) - before.GetCount(MSV_STILL_RUNNING_WARN), 1);
+	EXPECT_EQ(after.GetCount(MSV_SUCCESS) - before.GetCount(MSV_SUCCESS), 0);
+	EXPECT_EQ(after.GetCount(MSV_NOT_FOUND_INFO) - before.GetCount(MSV_NOT_FOUND_INFO), 0);
+	EXPECT_EQ(after.GetSeverityCount(3) - before.GetSeverityCount(3), 2);
+}
+
+TEST(MsvErrorCountersTest, ItShouldCountThrows)
+{
+	MsvErrorCountersSnapshot before = MsvErrorCounters::GetSnapshot();
+
+	ThrowFailed(MSV_BUSY_ERROR);
+	ThrowFailed(MSV_SUCCESS);
+
+	try
+	{
+		MSV_THROW(MSV_PARSE_ERROR, "parse");
+	}
+	catch (const MsvException&)
+	{
+
+	}
+
+	MsvErrorCountersSnapshot after = MsvErrorCounters::GetSnapshot();
+	EXPECT_EQ(after.GetCount(MSV_BUSY_ERROR) - before.GetCount(MSV_BUSY_ERROR), 1);
+	EXPECT_EQ(after.GetCount(MSV_PARSE_ERROR) - before.GetCount(MSV_PARSE_ERROR), 1);
+	EXPECT_EQ(after.GetCount(MSV_SUCCESS) - before.GetCount(MSV_SUCCESS), 0);
+}
+
+TEST(MsvErrorCountersTest, ItShouldCountNotCountedCodesTogether)
+{
+	MsvErrorCode first = static_cast<MsvErrorCode>(0xC0000000 | (MSV_ERROR_COUNTERS_CODES + 1));
+	MsvErrorCode second = static_cast<MsvErrorCode>(0xC0000000 | (MSV_ERROR_COUNTERS_CODES + 100));
+	MsvErrorCountersSnapshot before = MsvErrorCounters::GetSnapshot();
+
+	ReturnFailed(first);
+	ReturnFailed(second);
+
+	MsvErrorCountersSnapshot after = MsvErrorCounters::GetSnapshot();
+	EXPECT_EQ(after.GetCount(first) - before.GetCount(first), 2);
+	EXPECT_EQ(after.GetCount(second), after.GetCount(first));
+}
+
+TEST(MsvErrorCountersTest, ItShouldAggregateThreadShards)
+{
+	const int threadCount = 4;
+	const int failureCount = 1000;
+	MsvErrorCountersSnapshot before = MsvErrorCounters::GetSnapshot();
+	std::vector<std::thread> threads;
+
+	for (int thread = 0; thread < threadCount; ++thread)
+	{
+		threads.emplace_back([]()
+		{
+			for (int failure = 0; failure < failureCount; ++failure)
+			{
+				ReturnFailed(MSV_EXECUTE_ERROR);
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	//finished threads keep their counts
+	MsvErrorCountersSnapshot after = MsvErrorCounters::GetSnapshot();
+	EXPECT_EQ(after.GetCount(MSV_EXECUTE_ERROR) - before.GetCount(MSV_EXECUTE_ERROR), threadCount * failureCount);
+}
+
+TEST(MsvErrorCountersTest, ItShouldWritePrometheusText)
+{
+	ReturnFailed(MSV_NOT_ALLOWED_ERROR);
+
+	std::ostringstream stream;
+	MsvErrorCounters::GetSnapshot().WritePrometheus(stream);
+	std::string text = stream.str();
+
+	EXPECT_NE(text.find("# TYPE msv_errors_total counter\n"), std::string::npos);
+	EXPECT_NE(text.find("msv_errors_total{severity=\"error\",code=\"0xC000000D\",name=\"MSV_NOT_ALLOWED_ERROR\"} "), std::string::npos);
+	EXPECT_NE(text.find("msv_errors_severity_total{severity=\"error\"} "), std::string::npos);
+	EXPECT_NE(text.find("msv_errors_severity_total{severity=\"success\"} 0\n"), std::string::npos);
+}
+
+TEST(MsvErrorCountersTest, ItShouldWritePrometheusFile)
+{
+	const char* filePath = "MsvErrorCountersTest.prom";
+	ReturnFailed(MSV_NOT_ALLOWED_ERROR);
+
+	ASSERT_EQ(MsvErrorCounters::GetSnapshot().WritePrometheus(filePath), MSV_SUCCESS);
+
+	std::ifstream file(filePath);
+	std::stringstream text;
+	text << file.rdbuf();
+	file.close();
+	std::remove(filePath);
+
+	EXPECT_NE(text.str().find("name=\"MSV_NOT_ALLOWED_ERROR\"}"), std::string::npos);
+	EXPECT_EQ(MsvErrorCounters::GetSnapshot().WritePrometheus("not/existing/directory/file.prom"), MSV_OPEN_ERROR);
+}
+
+TEST(MsvErrorCountersTest, ItShouldReplacePrometheusFile)
+{
+	const char* filePath = "MsvErrorCountersReplaceTest.prom";
+	{
+		std::ofstream file(filePath);
+		file << "old content\n";
+	}
+	ReturnFailed(MSV_NOT_ALLOWED_ERROR);
+
+	ASSERT_EQ(MsvErrorCounters::GetSnapshot().WritePrometheus(filePath), MSV_SUCCESS);
+
+	std::ifstream file(filePath);
+	std::stringstream text;
+	text << file.rdbuf();
+	file.close();
+	std::remove(filePath);
+
+	EXPECT_EQ(text.str().find("old content"), std::string::npos);
+	EXPECT_NE(text.str().find("name=\"MSV_NOT_ALLOWED_ERROR\"}"), std::string::npos);
+}
@@ -0,0 +1,41 @@
+#include "pch.h"
+
+#include "../msverrorregistry.h"
+
+#include "MsvErrorTestConstants.h"
+
+
+static_assert(MsvErrorCodeName(MSV_BUSY_ERROR) != nullptr, "Error code names must be available at compile time.");
+
+
+TEST(MsvErrorRegistryTest, ItShouldReturnNameOfRegisteredErrorCode)
+{
+	EXPECT_STREQ(MsvErrorCodeName(MSV_SUCCESS), "MSV_SUCCESS");
+	EXPECT_STREQ(MsvErrorCodeName(MSV_NOT_FOUND_INFO), "MSV_NOT_FOUND_INFO");
+	EXPECT_STREQ(MsvErrorCodeName(MSV_STILL_RUNNING_WARN), "MSV_STILL_RUNNING_WARN");
+	EXPECT_STREQ(MsvErrorCodeName(MSV_NOT_FOUND_ERROR), "MSV_NOT_FOUND_ERROR");
+	EXPECT_STREQ(MsvErrorCodeName(MSV_BUSY_ERROR), "MSV_BUSY_ERROR");
+}
+
+TEST(MsvErrorRegistryTest, ItShouldReturnDescriptionOfRegisteredErrorCode)
+{
+	EXPECT_STREQ(MsvErrorCodeDescription(MSV_PARSE_ERROR), "Parsing data failed.");
+	EXPECT_STREQ(MsvErrorCodeDescription(MSV_EXPIRED_INFO), "Something is expired.");
+}
+
+TEST(MsvErrorRegistryTest, ItShouldReturnNullptrForNotRegisteredErrorCode)
+{
+	EXPECT_EQ(MsvErrorCodeName(MSV_SUCCESS_MAX), nullptr);
+	EXPECT_EQ(MsvErrorCodeName(MSV_INFO_MAX), nullptr);
+	EXPECT_EQ(MsvErrorCodeName(MSV_WARN_MIDDLE), nullptr);
+	EXPECT_EQ(MsvErrorCodeName(MSV_ERROR_MAX), nullptr);
+	EXPECT_EQ(MsvErrorCodeDescription(MSV_ERROR_MAX), nullptr);
+}
+
+TEST(MsvErrorRegistryTest, ItShouldFindAllRegisteredErrorCodes)
+{
+	for (const MsvErrorCodeInfo& info : MsvErrorCodeInfos)
+	{
+		EXPECT_EQ(MsvGetErrorCodeInfo(info.errorCode), &info);
+	}
+}
@@ -0,0 +1,193 @@
+#include "pch.h"
+
+#include "../msverrorsink.h"
+#include "../msverrorcodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+namespace
+{
+	class MsvErrorSinkTestOutput
+	{
+	public:
+		MsvErrorSink::Writer GetWriter()
+		{
+			return [this](const char* data, std::size_t length)
+			{
+				while (m_blocked)
+				{
+					std::this_thread::yield();
+				}
+
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_text.append(data, length);
+				++m_batches;
+			};
+		}
+
+		std::string GetText()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_text;
+		}
+
+		std::size_t GetBatches()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_batches;
+		}
+
+		std::atomic<bool> m_blocked{ false };
+
+	protected:
+		std::mutex m_mutex;
+		std::string m_text;
+		std::size_t m_batches = 0;
+	};
+
+	std::size_t CountLines(const std::string& text)
+	{
+		std::size_t lines = 0;
+		for (char character : text)
+		{
+			lines += character == '\n';
+		}
+
+		return lines;
+	}
+}
+
+
+TEST(MsvErrorSinkTest, ItShouldWriteErrorCodes)
+{
+	MsvErrorSinkTestOutput output;
+	MsvErrorSink sink(output.GetWriter());
+
+	EXPECT_TRUE(sink.Log(MSV_BUSY_ERROR, "fileName", 10, "backend busy"));
+	EXPECT_TRUE(MSV_SINK_LOG(sink, MSV_NOT_FOUND_ERROR, nullptr));
+	sink.Flush();
+
+	std::string text = output.GetText();
+	EXPECT_TRUE(std::regex_search(text, std::regex("^[0-9]{10} 0x-1073741812 fileName:10 backend busy\n")));
+	EXPECT_NE(text.find(" MSV_NOT_FOUND_ERROR\n"), std::string::npos);
+	EXPECT_EQ(sink.GetWrittenCount(), 2);
+	EXPECT_EQ(sink.GetDroppedCount(), 0);
+}
+
+TEST(MsvErrorSinkTest, ItShouldWriteExceptions)
+{
+	MsvErrorSinkTestOutput output;
+	MsvErrorSink sink(output.GetWriter());
+
+	try
+	{
+		MSV_THROW(MSV_PARSE_ERROR, "parse failed");
+	}
+	catch (const MsvException& exception)
+	{
+		EXPECT_TRUE(sink.Log(exception));
+		sink.Flush();
+		EXPECT_EQ(output.GetText(), exception.what());
+	}
+}
+
+TEST(MsvErrorSinkTest, ItShouldTruncateLongMessages)
+{
+	MsvErrorSinkTestOutput output;
+	MsvErrorSink sink(output.GetWriter());
+
+	sink.Log(MSV_BUSY_ERROR, "fileName", 10, std::string(1000, 'x').c_str());
+	sink.Flush();
+
+	EXPECT_NE(output.GetText().find(std::string(MSV_ERROR_SINK_MESSAGE_SIZE - 1, 'x') + "\n"), std::string::npos);
+}
+
+TEST(MsvErrorSinkTest, ItShouldDropWhenQueueIsFull)
+{
+	MsvErrorSinkTestOutput output;
+	MsvErrorSink sink(output.GetWriter(), 8, MsvErrorSinkPolicy::Drop);
+	output.m_blocked = true;
+
+	//the first entry can be taken by blocked writer, the rest fills the queue
+	std::size_t logged = 0;
+	for (int index = 0; index < 100; ++index)
+	{
+		logged += sink.Log(MSV_BUSY_ERROR, "fileName", index);
+	}
+
+	EXPECT_LE(logged, sink.GetCapacity() + 1);
+	EXPECT_EQ(sink.GetDroppedCount(), 100 - logged);
+
+	output.m_blocked = false;
+	sink.Flush();
+	EXPECT_EQ(sink.GetWrittenCount(), logged);
+	EXPECT_EQ(CountLines(output.GetText()), logged);
+}
+
+TEST(MsvErrorSinkTest, ItShouldBlockWhenQueueIsFull)
+{
+	const int threadCount = 4;
+	const int entryCount = 1000;
+	MsvErrorSinkTestOutput output;
+	MsvErrorSink sink(output.GetWriter(), 16, MsvErrorSinkPolicy::Block);
+	std::vector<std::thread> threads;
+
+	for (int thread = 0; thread < threadCount; ++thread)
+	{
+		threads.emplace_back([&sink]()
+		{
+			for (int entry = 0; entry < entryCount; ++entry)
+			{
+				sink.Log(MSV_BUSY_ERROR, "fileName", entry);
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	sink.Flush();
+	EXPECT_EQ(sink.GetDroppedCount(), 0);
+	EXPECT_EQ(sink.GetWrittenCount(), threadCount * entryCount);
+	EXPECT_EQ(CountLines(output.GetText()), threadCount * entryCount);
+	EXPECT_LT(output.GetBatches(), threadCount * entryCount);
+}
+
+TEST(MsvErrorSinkTest, ItShouldFlushOnShutdown)
+{
+	MsvErrorSinkTestOutput output;
+
+	{
+		MsvErrorSink sink(output.GetWriter(), 256);
+		for (int index = 0; index < 200; ++index)
+		{
+			MsvException exception("fileName", index, MSV_BUSY_ERROR, "busy");
+			sink.Log(exception);
+		}
+	}
+
+	EXPECT_EQ(CountLines(output.GetText()), 200);
+}
+
+TEST(MsvErrorSinkTest, ItShouldDropAfterShutdown)
+{
+	MsvErrorSinkTestOutput output;
+	MsvErrorSink sink(output.GetWriter());
+
+	sink.Shutdown();
+	EXPECT_FALSE(sink.Log(MSV_BUSY_ERROR, "fileName", 10));
+	EXPECT_EQ(sink.GetDroppedCount(), 1);
+	sink.Flush();
+}
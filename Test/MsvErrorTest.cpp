@@ -282,3 +282,75 @@ TEST(MsvErrorTest, ItShouldContinueForErrors)
 	for (; i < 2; ++i) { MSV_CONTINUE_FAILED(MSV_ERROR_MAX); EXPECT_TRUE(false); }
 	EXPECT_EQ(i, 2);
 }
+
+static_assert(MsvMakeErrorCode(MsvErrorMask, MsvMarsTechFacility, 0x000E) == MSV_STILL_RUNNING_ERROR, "MarsTech error codes must be from MarsTech facility.");
+static_assert(MsvErrorCodeFacility(MsvMakeErrorCode(MsvWarnMask, 0x123, 0x4567)) == 0x123, "Facility must be extracted at compile time.");
+
+TEST(MsvErrorTest, ItShouldMakeErrorCodeFromSeverityFacilityAndNumber)
+{
+	EXPECT_EQ(MsvMakeErrorCode(MsvSuccessMask, 0, 0), MSV_SUCCESS);
+	EXPECT_EQ(MsvMakeErrorCode(MsvInfoMask, 0x001, 0x0002), static_cast<MsvErrorCode>(0x40010002));
+	EXPECT_EQ(MsvMakeErrorCode(MsvWarnMask, 0xABC, 0xDEF0), static_cast<MsvErrorCode>(0x8ABCDEF0));
+	EXPECT_EQ(MsvMakeErrorCode(MsvErrorMask, 0xFFF, 0xFFFF), static_cast<MsvErrorCode>(0xCFFFFFFF));
+}
+
+TEST(MsvErrorTest, ItShouldTruncateFacilityAndNumber)
+{
+	MsvErrorCode errorCode = MsvMakeErrorCode(MsvErrorMask, 0x1001, 0x10002);
+
+	EXPECT_EQ(MsvErrorCodeFacility(errorCode), 0x001);
+	EXPECT_EQ(MsvErrorCodeNumber(errorCode), 0x0002);
+	EXPECT_EQ(errorCode & 0x30000000, 0);
+}
+
+TEST(MsvErrorTest, ItShouldExtractSeverityFacilityAndNumber)
+{
+	for (MsvErrorCode severityMask : { MsvSuccessMask, MsvInfoMask, MsvWarnMask, MsvErrorMask })
+	{
+		for (uint32_t facility : { 0u, 1u, 0x7FFu, MsvFacilityCount - 1 })
+		{
+			for (uint32_t number : { 0u, 1u, 0x8000u, 0xFFFFu })
+			{
+				MsvErrorCode errorCode = MsvMakeErrorCode(severityMask, facility, number);
+
+				EXPECT_EQ(MsvErrorCodeSeverity(errorCode), static_cast<uint32_t>(severityMask) >> 30);
+				EXPECT_EQ(MsvErrorCodeFacility(errorCode), facility);
+				EXPECT_EQ(MsvErrorCodeNumber(errorCode), number);
+			}
+		}
+	}
+}
+
+TEST(MsvErrorTest, ItShouldKeepSeverityMacrosForFacilities)
+{
+	EXPECT_TRUE(MSV_IS_SUCCESS(MsvMakeErrorCode(MsvSuccessMask, 0x123, 1)));
+	EXPECT_TRUE(MSV_IS_INFO(MsvMakeErrorCode(MsvInfoMask, 0x123, 1)));
+	EXPECT_TRUE(MSV_IS_WARN(MsvMakeErrorCode(MsvWarnMask, 0x123, 1)));
+	EXPECT_TRUE(MSV_IS_ERROR(MsvMakeErrorCode(MsvErrorMask, 0x123, 1)));
+
+	EXPECT_TRUE(MSV_SUCCEEDED(MsvMakeErrorCode(MsvInfoMask, 0xFFF, 0xFFFF)));
+	EXPECT_TRUE(MSV_FAILED(MsvMakeErrorCode(MsvWarnMask, 0, 0)));
+	EXPECT_EQ(CheckAndReturnErrorCode(MsvMakeErrorCode(MsvErrorMask, 0x123, 1)), MsvMakeErrorCode(MsvErrorMask, 0x123, 1));
+}
+
+TEST(MsvErrorTest, ItShouldRouteByFacilityIndex)
+{
+	int routed[MsvFacilityCount] = {};
+
+	++routed[MsvErrorCodeFacility(MSV_BUSY_ERROR)];
+	++routed[MsvErrorCodeFacility(MsvMakeErrorCode(MsvErrorMask, 0x042, 7))];
+	++routed[MsvErrorCodeFacility(MsvMakeErrorCode(MsvWarnMask, 0x042, 8))];
+
+	EXPECT_EQ(routed[MsvMarsTechFacility], 1);
+	EXPECT_EQ(routed[0x042], 2);
+}
+
+#define MSV_ERROR_TEST_STRINGIFY_IMPL(...) #__VA_ARGS__
+#define MSV_ERROR_TEST_STRINGIFY(...) MSV_ERROR_TEST_STRINGIFY_IMPL(__VA_ARGS__)
+
+TEST(MsvErrorTest, ItShouldCompileDisabledHooksToNothing)
+{
+#ifndef MSV_ERROR_COUNTERS
+	EXPECT_STREQ(MSV_ERROR_TEST_STRINGIFY(MSV_ERROR_HOOK(MSV_ERROR_MIN, __FILE__, __LINE__)), "");
+#endif
+}
@@ -0,0 +1,207 @@
+#include "pch.h"
+
+#include "../msvexception.h"
+#include "../msvexceptionhandle.h"
+#include "../msverrorcodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <new>
+#include <string>
+
+MSV_ENABLE_WARNINGS
+
+
+namespace
+{
+	//number of heap allocations done by operator new (other tests allocate from more threads)
+	std::atomic<size_t> allocationCounter(0);
+
+	//number of malloc calls (operator new and C++ runtime allocation of thrown exceptions)
+	std::atomic<size_t> mallocCounter(0);
+}
+
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(std::size_t size);
+
+extern "C" void* malloc(std::size_t size)
+{
+	mallocCounter.fetch_add(1, std::memory_order_relaxed);
+
+	return __libc_malloc(size);
+}
+#endif
+
+void* operator new(std::size_t size)
+{
+	allocationCounter.fetch_add(1, std::memory_order_relaxed);
+
+	if (void* memory = std::malloc(size ? size : 1))
+	{
+		return memory;
+	}
+
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	allocationCounter.fetch_add(1, std::memory_order_relaxed);
+
+	return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+
+
+TEST(MsvExceptionAllocationTest, ItShouldThrowShortMessageWithoutAllocation)
+{
+	size_t allocations = allocationCounter;
+
+	try
+	{
+		MSV_THROW(MSV_BUSY_ERROR, "message");
+	}
+	catch (MsvException& exception)
+	{
+		EXPECT_NE(exception.what()[0], '\0');
+	}
+
+	EXPECT_EQ(allocationCounter - allocations, 0);
+}
+
+TEST(MsvExceptionAllocationTest, ItShouldRethrowShortMessageWithoutAllocation)
+{
+	size_t allocations = allocationCounter;
+
+	try
+	{
+		try
+		{
+			MSV_THROW(MSV_BUSY_ERROR, "message");
+		}
+		catch (MsvException& exception)
+		{
+			MSV_RETHROW(exception, MSV_EXECUTE_ERROR, "message 2");
+		}
+	}
+	catch (MsvException& exception)
+	{
+		EXPECT_NE(exception.what()[0], '\0');
+	}
+
+	EXPECT_EQ(allocationCounter - allocations, 0);
+}
+
+TEST(MsvExceptionAllocationTest, ItShouldStoreLongMessageOnHeap)
+{
+	std::string message(2 * MSV_EXCEPTION_WHAT_SIZE, 'x');
+#ifdef MSV_MEMORY_RESOURCE
+	//default pool can reuse cached blocks - global heap is used directly
+	MsvExceptionMemoryResourceScope scope(std::pmr::new_delete_resource());
+#endif
+	size_t allocations = allocationCounter;
+
+	try
+	{
+		MSV_THROW(MSV_BUSY_ERROR, message.c_str());
+	}
+	catch (MsvException& exception)
+	{
+		EXPECT_NE(std::string(exception.what()).find(message), std::string::npos);
+	}
+
+	EXPECT_GT(allocationCounter - allocations, 0);
+}
+
+TEST(MsvExceptionAllocationTest, ItShouldCopyExceptionWithoutAllocation)
+{
+	MsvException exception("fileName", 10, MSV_BUSY_ERROR, std::string(2 * MSV_EXCEPTION_WHAT_SIZE, 'x').c_str());
+	for (int line = 0; line < 2 * MSV_EXCEPTION_INLINE_FRAMES; ++line)
+	{
+		exception.Rethrowing("fileName", line, MSV_EXECUTE_ERROR, "message");
+	}
+	std::string what(exception.what());
+
+	size_t allocations = allocationCounter;
+	MsvException copy(exception);
+	MsvException assigned("fileName", 10, MSV_BUSY_ERROR, "message");
+	assigned = copy;
+	EXPECT_EQ(allocationCounter - allocations, 0);
+
+	EXPECT_EQ(what, copy.what());
+	EXPECT_EQ(what, assigned.what());
+	EXPECT_EQ(copy.what(), exception.what());
+}
+
+TEST(MsvExceptionAllocationTest, ItShouldTransferExceptionWithoutAllocation)
+{
+	MsvException exception("fileName", 10, MSV_BUSY_ERROR, "message");
+	size_t allocations = allocationCounter;
+	size_t mallocs = mallocCounter;
+
+	try
+	{
+		MsvExceptionHandle handle(std::move(exception));
+		MsvExceptionHandle moved(std::move(handle));
+		handle = std::move(moved);
+		handle.Rethrow();
+	}
+	catch (MsvException& transferred)
+	{
+		EXPECT_EQ(transferred.GetErrorCode(), MSV_BUSY_ERROR);
+	}
+
+	EXPECT_EQ(allocationCounter - allocations, 0);
+#if defined(__GLIBC__)
+	//the only allocation is thrown exception object (C++ runtime allocates it)
+	EXPECT_EQ(mallocCounter - mallocs, 1);
+#endif
+}
+
+#if defined(__GLIBC__)
+TEST(MsvExceptionAllocationTest, ItShouldTransferExceptionWithLessAllocationsThanExceptionPtr)
+{
+	MsvException exception("fileName", 10, MSV_BUSY_ERROR, "message");
+	size_t mallocs = mallocCounter;
+
+	try
+	{
+		MsvExceptionHandle handle(exception);
+		handle.Rethrow();
+	}
+	catch (MsvException&)
+	{
+	}
+
+	size_t handleMallocs = mallocCounter - mallocs;
+	mallocs = mallocCounter;
+
+	try
+	{
+		std::exception_ptr pointer = std::make_exception_ptr(exception);
+		std::rethrow_exception(pointer);
+	}
+	catch (MsvException&)
+	{
+	}
+
+	EXPECT_LT(handleMallocs, mallocCounter - mallocs);
+}
+#endif
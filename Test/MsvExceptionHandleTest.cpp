@@ -0,0 +1,124 @@
+#include "pch.h"
+
+#include "../msverrorcodes.h"
+#include "../msvexceptionhandle.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <future>
+#include <string>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+namespace
+{
+	MsvExceptionHandle CaptureException(MsvErrorCode errorCode, const char* msg)
+	{
+		try
+		{
+			MSV_THROW(errorCode, msg);
+		}
+		catch (MsvException& exception)
+		{
+			return MsvExceptionHandle(std::move(exception));
+		}
+
+		return MsvExceptionHandle();
+	}
+}
+
+
+TEST(MsvExceptionHandleTest, ItShouldBeEmpty)
+{
+	MsvExceptionHandle handle;
+
+	EXPECT_FALSE(handle);
+	EXPECT_EQ(handle.GetErrorCode(), MSV_SUCCESS);
+	EXPECT_EQ(handle.Get(), nullptr);
+}
+
+TEST(MsvExceptionHandleTest, ItShouldCaptureException)
+{
+	MsvExceptionHandle handle = CaptureException(MSV_BUSY_ERROR, "message");
+
+	EXPECT_TRUE(handle);
+	EXPECT_EQ(handle.GetErrorCode(), MSV_BUSY_ERROR);
+	ASSERT_NE(handle.Get(), nullptr);
+	EXPECT_STREQ(handle.Get()->GetFrame(0).message, "message");
+}
+
+TEST(MsvExceptionHandleTest, ItShouldCaptureCopyOfException)
+{
+	MsvException exception("fileName", 10, MSV_OPEN_ERROR, "message");
+	MsvExceptionHandle handle(exception);
+
+	EXPECT_EQ(handle.GetErrorCode(), MSV_OPEN_ERROR);
+	ASSERT_NE(handle.Get(), nullptr);
+	EXPECT_STREQ(handle.Get()->what(), exception.what());
+}
+
+TEST(MsvExceptionHandleTest, ItShouldMoveHandle)
+{
+	MsvExceptionHandle handle = CaptureException(MSV_BUSY_ERROR, "message");
+	std::string what(handle.Get()->what());
+
+	MsvExceptionHandle moved(std::move(handle));
+	EXPECT_FALSE(handle);
+	EXPECT_EQ(handle.Get(), nullptr);
+	ASSERT_NE(moved.Get(), nullptr);
+	EXPECT_EQ(what, moved.Get()->what());
+
+	MsvExceptionHandle assigned = CaptureException(MSV_OPEN_ERROR, "message 2");
+	assigned = std::move(moved);
+	EXPECT_FALSE(moved);
+	ASSERT_NE(assigned.Get(), nullptr);
+	EXPECT_EQ(what, assigned.Get()->what());
+	EXPECT_EQ(assigned.GetErrorCode(), MSV_BUSY_ERROR);
+}
+
+#ifndef MSV_NO_EXCEPTIONS
+TEST(MsvExceptionHandleTest, ItShouldRethrowException)
+{
+	std::string message(2 * MSV_EXCEPTION_WHAT_SIZE, 'x');
+	MsvExceptionHandle handle = CaptureException(MSV_BUSY_ERROR, message.c_str());
+	std::string what(handle.Get()->what());
+
+	try
+	{
+		handle.Rethrow();
+	}
+	catch (MsvException& exception)
+	{
+		EXPECT_EQ(exception.GetErrorCode(), MSV_BUSY_ERROR);
+		EXPECT_EQ(what, exception.what());
+	}
+
+	EXPECT_EQ(handle.GetErrorCode(), MSV_BUSY_ERROR);
+}
+
+TEST(MsvExceptionHandleTest, ItShouldTransferExceptionBetweenThreads)
+{
+	std::promise<MsvExceptionHandle> promise;
+	std::future<MsvExceptionHandle> future = promise.get_future();
+
+	std::thread worker([&promise]()
+	{
+		promise.set_value(CaptureException(MSV_EXECUTE_ERROR, "worker failed"));
+	});
+
+	MsvExceptionHandle handle = future.get();
+	worker.join();
+
+	try
+	{
+		handle.Rethrow();
+	}
+	catch (MsvException& exception)
+	{
+		EXPECT_EQ(exception.GetErrorCode(), MSV_EXECUTE_ERROR);
+		EXPECT_STREQ(exception.GetFrame(0).message, "worker failed");
+	}
+}
+#endif
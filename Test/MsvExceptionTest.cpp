@@ -6,7 +6,14 @@
 
 MSV_DISABLE_ALL_WARNINGS
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <regex>
+#include <string>
+#include <thread>
+#include <vector>
 
 MSV_ENABLE_WARNINGS
 
@@ -37,6 +44,38 @@ TEST(MsvExceptionTest, ItShouldAssignException)
 	EXPECT_EQ(exception1.GetErrorCode(), exception2.GetErrorCode());
 }
 
+TEST(MsvExceptionTest, ItShouldMoveException)
+{
+	MsvException exception1("fileName", 10, 20, "message");
+	std::string what(exception1.what());
+
+	MsvException exception2(std::move(exception1));
+	EXPECT_EQ(what, exception2.what());
+	EXPECT_EQ(exception2.GetErrorCode(), 20);
+	EXPECT_EQ(exception2.GetFrameCount(), 1);
+
+	MsvException exception3("fileName3", 30, 40, "message 3");
+	exception3 = std::move(exception2);
+	EXPECT_EQ(what, exception3.what());
+	EXPECT_EQ(exception3.GetErrorCode(), 20);
+}
+
+TEST(MsvExceptionTest, ItShouldKeepCopiesIndependent)
+{
+	MsvException exception1("fileName", 10, 20, std::string(MSV_EXCEPTION_WHAT_SIZE, 'x').c_str());
+	std::string what(exception1.what());
+
+	MsvException exception2(exception1);
+	exception2.Rethrowing("fileName2", 30, 40, "message 2");
+
+	EXPECT_EQ(what, exception1.what());
+	EXPECT_EQ(exception1.GetFrameCount(), 1);
+	EXPECT_EQ(exception2.GetFrameCount(), 2);
+	EXPECT_EQ(std::string(exception2.what()).find(what), 0);
+	EXPECT_EQ(exception1.GetErrorCode(), 20);
+	EXPECT_EQ(exception2.GetErrorCode(), 40);
+}
+
 TEST(MsvExceptionTest, ItShouldAddRetrowingDataToException)
 {
 	MsvException exception("fileName", 10, 20, "message");
@@ -46,6 +85,158 @@ TEST(MsvExceptionTest, ItShouldAddRetrowingDataToException)
 	EXPECT_EQ(exception.GetErrorCode(), 40);
 }
 
+TEST(MsvExceptionTest, ItShouldAddRetrowingDataToFormattedException)
+{
+	MsvException exception("fileName", 10, 20, "message");
+	const char* what = exception.what();
+	EXPECT_EQ(what, exception.what());
+
+	exception.Rethrowing("fileName2", 30, 40, "message 2");
+
+	EXPECT_TRUE(std::regex_match(exception.what(), std::regex("[0-9]{10} 0x00000020 fileName:10 message\n[0-9]{10} 0x00000040 fileName2:30 message 2\n")));
+	EXPECT_EQ(exception.GetErrorCode(), 40);
+}
+
+TEST(MsvExceptionTest, ItShouldStoreRethrowingDataAsFrames)
+{
+	MsvException exception("fileName", 10, 20, "message");
+	exception.Rethrowing("fileName2", 30, 40, "message 2");
+
+	ASSERT_EQ(exception.GetFrameCount(), 2);
+
+	MsvExceptionFrame frame = exception.GetFrame(0);
+	EXPECT_EQ(frame.errorCode, 20);
+	EXPECT_STREQ(frame.fileName, "fileName");
+	EXPECT_EQ(frame.line, 10);
+	EXPECT_STREQ(frame.message, "message");
+
+	frame = exception.GetFrame(1);
+	EXPECT_EQ(frame.errorCode, 40);
+	EXPECT_STREQ(frame.fileName, "fileName2");
+	EXPECT_EQ(frame.line, 30);
+	EXPECT_STREQ(frame.message, "message 2");
+}
+
+TEST(MsvExceptionTest, ItShouldMeasureElapsedTimeOfFrames)
+{
+	std::chrono::system_clock::time_point before = std::chrono::system_clock::now();
+	MsvException exception("fileName", 10, 20, "message");
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	exception.Rethrowing("fileName2", 30, 40, "message 2");
+
+	EXPECT_EQ(exception.GetFrameElapsed(0).count(), 0);
+	EXPECT_GE(exception.GetFrameElapsed(1), std::chrono::milliseconds(15));
+	EXPECT_LT(exception.GetFrameElapsed(1), std::chrono::seconds(5));
+
+	EXPECT_LT(std::chrono::abs(exception.GetFrameTime(0) - before), std::chrono::seconds(1));
+	EXPECT_GE(exception.GetFrameTime(1), exception.GetFrameTime(0));
+}
+
+TEST(MsvExceptionTest, ItShouldStoreLongRethrowingChain)
+{
+	MsvException exception("fileName", 0, 0, "message 0");
+	for (int line = 1; line < 64; ++line)
+	{
+		exception.Rethrowing("fileName", line, line, ("message " + std::to_string(line)).c_str());
+	}
+
+	MsvException copy(exception);
+	ASSERT_EQ(copy.GetFrameCount(), 64);
+	EXPECT_EQ(copy.GetErrorCode(), 63);
+
+	std::string what(copy.what());
+	std::string expected;
+	for (int line = 0; line < 64; ++line)
+	{
+		EXPECT_EQ(copy.GetFrame(line).line, line);
+		EXPECT_EQ(std::string(copy.GetFrame(line).message), "message " + std::to_string(line));
+		expected += " fileName:" + std::to_string(line) + " message " + std::to_string(line) + "\n";
+	}
+
+	EXPECT_EQ(std::regex_replace(what, std::regex("[0-9]{10} 0x[0-9]{8}"), ""), expected);
+	EXPECT_EQ(what, exception.what());
+}
+
+TEST(MsvExceptionTest, ItShouldWalkFramesFromThrow)
+{
+	MsvException exception("fileName", 0, 0, "message");
+	for (int line = 1; line < 5000; ++line)
+	{
+		exception.Rethrowing("fileName", line, line, "message");
+		if (line == 1000)
+		{
+			exception.what();
+		}
+	}
+
+	int line = 0;
+	exception.ForEachFrame([&line](const MsvExceptionFrame& frame)
+	{
+		EXPECT_EQ(frame.line, line++);
+	});
+	EXPECT_EQ(line, 5000);
+
+	std::string what(exception.what());
+	EXPECT_EQ(std::count(what.begin(), what.end(), '\n'), 5000);
+	EXPECT_NE(what.find(" fileName:999 message\n"), std::string::npos);
+	EXPECT_NE(what.find(" fileName:1001 message\n"), std::string::npos);
+	EXPECT_EQ(what.substr(what.size() - 23), " fileName:4999 message\n");
+}
+
+TEST(MsvExceptionTest, ItShouldFormatWhatConcurrently)
+{
+	MsvException exception("fileName", 0, 0, "message 0");
+	for (int line = 1; line < 64; ++line)
+	{
+		exception.Rethrowing("fileName", line, line, ("message " + std::to_string(line)).c_str());
+	}
+	std::exception_ptr exceptionPtr = std::make_exception_ptr(exception);
+
+	std::atomic<bool> start(false);
+	std::vector<std::string> whats(8);
+	std::vector<std::string> copyWhats(whats.size());
+	std::vector<const char*> whatPointers(whats.size());
+	std::vector<std::thread> threads;
+	for (std::size_t index = 0; index < whats.size(); ++index)
+	{
+		threads.emplace_back([&, index]()
+			{
+				while (!start.load()) {}
+
+				try
+				{
+					std::rethrow_exception(exceptionPtr);
+				}
+				catch (const MsvException& thrown)
+				{
+					MsvException copy(thrown);
+					whatPointers[index] = thrown.what();
+					whats[index] = whatPointers[index];
+					copyWhats[index] = copy.what();
+				}
+			});
+	}
+
+	start.store(true);
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	std::string expected;
+	for (int line = 0; line < 64; ++line)
+	{
+		expected += " fileName:" + std::to_string(line) + " message " + std::to_string(line) + "\n";
+	}
+
+	for (std::size_t index = 0; index < whats.size(); ++index)
+	{
+		EXPECT_EQ(whatPointers[index], whatPointers[0]);
+		EXPECT_EQ(std::regex_replace(whats[index], std::regex("[0-9]{10} 0x[0-9]{8}"), ""), expected);
+		EXPECT_EQ(copyWhats[index], whats[index]);
+	}
+}
+
 TEST(MsvExceptionTest, ItShouldThrowValidException)
 {
 	EXPECT_THROW(MSV_THROW(10, "message"), MsvException);
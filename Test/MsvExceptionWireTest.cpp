@@ -0,0 +1,229 @@
+#include "pch.h"
+
+#include "../msvexceptionwire.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+namespace
+{
+	std::vector<uint8_t> Encode(const MsvException& exception)
+	{
+		std::vector<uint8_t> buffer(MsvExceptionWire::GetSize(exception));
+		EXPECT_EQ(MsvExceptionWire::Write(exception, buffer.data(), buffer.size()), buffer.size());
+
+		return buffer;
+	}
+
+	MsvException CreateException(int frames)
+	{
+		MsvException exception("fileName", 10, MSV_NOT_FOUND_ERROR, "not found");
+		for (int frame = 1; frame < frames; ++frame)
+		{
+			exception.Rethrowing("fileName2", 10 + frame, MSV_BUSY_ERROR, ("rethrow " + std::to_string(frame)).c_str());
+		}
+
+		return exception;
+	}
+
+	void ExpectEqual(const MsvException& exception, const MsvExceptionView& view)
+	{
+		ASSERT_EQ(view.GetFrameCount(), exception.GetFrameCount());
+		EXPECT_EQ(view.GetErrorCode(), exception.GetErrorCode());
+
+		std::size_t index = 0;
+		for (const MsvExceptionWireFrame& wireFrame : view)
+		{
+			MsvExceptionFrame frame = exception.GetFrame(index);
+			EXPECT_EQ(wireFrame.errorCode, frame.errorCode);
+			EXPECT_EQ(wireFrame.line, frame.line);
+			EXPECT_STREQ(wireFrame.fileName, frame.fileName ? frame.fileName : "");
+			EXPECT_EQ(wireFrame.fileNameLength, std::string(wireFrame.fileName).size());
+			EXPECT_STREQ(wireFrame.message, frame.message);
+			EXPECT_EQ(wireFrame.messageLength, std::string(frame.message).size());
+			EXPECT_EQ(wireFrame.time, std::chrono::time_point_cast<std::chrono::nanoseconds>(exception.GetFrameTime(index)));
+			++index;
+		}
+
+		EXPECT_EQ(index, exception.GetFrameCount());
+	}
+}
+
+
+TEST(MsvExceptionWireTest, ItShouldRoundTripException)
+{
+	MsvException exception = CreateException(1);
+	std::vector<uint8_t> buffer = Encode(exception);
+
+	EXPECT_EQ(buffer.size(), MsvExceptionWire::HeaderSize + MsvExceptionWire::FrameHeaderSize + sizeof("fileName") + sizeof("not found"));
+	EXPECT_EQ(std::string(buffer.begin(), buffer.begin() + 4), "MSVE");
+
+	MsvExceptionView view;
+	ASSERT_EQ(view.Parse(buffer.data(), buffer.size()), MSV_SUCCESS);
+	EXPECT_EQ(view.GetSize(), buffer.size());
+	ExpectEqual(exception, view);
+}
+
+TEST(MsvExceptionWireTest, ItShouldRoundTripRethrowChain)
+{
+	MsvException exception = CreateException(64);
+	exception.Rethrowing(nullptr, 0, MSV_PARSE_ERROR, std::string(1000, 'x').c_str());
+	std::vector<uint8_t> buffer = Encode(exception);
+
+	MsvExceptionView view;
+	ASSERT_EQ(view.Parse(buffer.data(), buffer.size()), MSV_SUCCESS);
+	ExpectEqual(exception, view);
+
+	EXPECT_EQ(view.GetFrame(64).messageLength, 1000);
+	EXPECT_EQ(view.GetFrame(64).fileNameLength, 0);
+	EXPECT_EQ(view.GetFrame(3).line, 13);
+}
+
+TEST(MsvExceptionWireTest, ItShouldUseLittleEndian)
+{
+	std::vector<uint8_t> buffer = Encode(CreateException(1));
+
+	EXPECT_EQ(buffer[4], MsvExceptionWire::Version);
+	EXPECT_EQ(buffer[6], 1);
+	EXPECT_EQ(buffer[7], 0);
+
+	//MSV_NOT_FOUND_ERROR 0xC0000003
+	EXPECT_EQ(buffer[8], 0x03);
+	EXPECT_EQ(buffer[11], 0xC0);
+	EXPECT_EQ(buffer[12], buffer.size());
+}
+
+TEST(MsvExceptionWireTest, ItShouldNotWriteToSmallBuffer)
+{
+	MsvException exception = CreateException(2);
+	std::vector<uint8_t> buffer(MsvExceptionWire::GetSize(exception) - 1, 0xAB);
+
+	EXPECT_EQ(MsvExceptionWire::Write(exception, buffer.data(), buffer.size()), 0);
+	EXPECT_EQ(MsvExceptionWire::Write(exception, nullptr, 1000), 0);
+	EXPECT_EQ(buffer[0], 0xAB);
+}
+
+TEST(MsvExceptionWireTest, ItShouldReadUnalignedAndConcatenatedExceptions)
+{
+	MsvException first = CreateException(3);
+	MsvException second = CreateException(5);
+
+	std::vector<uint8_t> buffer(1);
+	std::vector<uint8_t> encoded = Encode(first);
+	buffer.insert(buffer.end(), encoded.begin(), encoded.end());
+	encoded = Encode(second);
+	buffer.insert(buffer.end(), encoded.begin(), encoded.end());
+
+	MsvExceptionView view;
+	ASSERT_EQ(view.Parse(buffer.data() + 1, buffer.size() - 1), MSV_SUCCESS);
+	ExpectEqual(first, view);
+
+	std::size_t offset = 1 + view.GetSize();
+	ASSERT_EQ(view.Parse(buffer.data() + offset, buffer.size() - offset), MSV_SUCCESS);
+	ExpectEqual(second, view);
+	EXPECT_EQ(offset + view.GetSize(), buffer.size());
+}
+
+TEST(MsvExceptionWireTest, ItShouldRejectInvalidHeader)
+{
+	std::vector<uint8_t> buffer = Encode(CreateException(2));
+	MsvExceptionView view;
+
+	EXPECT_EQ(view.Parse(nullptr, 100), MSV_PARSE_ERROR);
+
+	std::vector<uint8_t> invalid = buffer;
+	invalid[0] = 'X';
+	EXPECT_EQ(view.Parse(invalid.data(), invalid.size()), MSV_PARSE_ERROR);
+
+	invalid = buffer;
+	invalid[4] = MsvExceptionWire::Version + 1;
+	EXPECT_EQ(view.Parse(invalid.data(), invalid.size()), MSV_PARSE_ERROR);
+
+	invalid = buffer;
+	invalid[5] = 1;
+	EXPECT_EQ(view.Parse(invalid.data(), invalid.size()), MSV_INVALID_DATA_ERROR);
+
+	invalid = buffer;
+	invalid[6] = 3;
+	EXPECT_EQ(view.Parse(invalid.data(), invalid.size()), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(view.GetFrameCount(), 0);
+	EXPECT_TRUE(view.begin() == view.end());
+}
+
+TEST(MsvExceptionWireTest, ItShouldRejectTruncatedBuffer)
+{
+	std::vector<uint8_t> buffer = Encode(CreateException(4));
+	MsvExceptionView view;
+
+	for (std::size_t size = 0; size < buffer.size(); ++size)
+	{
+		std::vector<uint8_t> truncated(buffer.begin(), buffer.begin() + size);
+		EXPECT_NE(view.Parse(truncated.data(), truncated.size()), MSV_SUCCESS) << "size " << size;
+	}
+}
+
+TEST(MsvExceptionWireTest, ItShouldSurviveFuzzing)
+{
+	std::vector<uint8_t> valid = Encode(CreateException(6));
+	std::mt19937 random(20261018);
+	MsvExceptionView view;
+	std::size_t parsed = 0;
+
+	for (int iteration = 0; iteration < 50000; ++iteration)
+	{
+		std::vector<uint8_t> buffer = valid;
+
+		//mutate bytes, then sometimes truncate or extend (exact-size buffer lets sanitizers catch overreads)
+		int mutations = 1 + static_cast<int>(random() % 8);
+		for (int mutation = 0; mutation < mutations; ++mutation)
+		{
+			std::size_t index = random() % buffer.size();
+			switch (random() % 3)
+			{
+			case 0: buffer[index] = static_cast<uint8_t>(random()); break;
+			case 1: buffer[index] ^= static_cast<uint8_t>(1 << (random() % 8)); break;
+			default: buffer[index] = static_cast<uint8_t>(index < 16 ? 0xFF : 0); break;
+			}
+		}
+
+		switch (random() % 4)
+		{
+		case 0: buffer.resize(random() % buffer.size()); break;
+		case 1: buffer.resize(buffer.size() + random() % 64, static_cast<uint8_t>(random())); break;
+		default: break;
+		}
+
+		if (view.Parse(buffer.data(), buffer.size()) != MSV_SUCCESS)
+		{
+			EXPECT_EQ(view.GetFrameCount(), 0);
+			continue;
+		}
+
+		++parsed;
+		ASSERT_LE(view.GetSize(), buffer.size());
+
+		std::size_t frames = 0;
+		const char* begin = reinterpret_cast<const char*>(buffer.data());
+		for (const MsvExceptionWireFrame& frame : view)
+		{
+			ASSERT_GE(frame.fileName, begin);
+			ASSERT_LT(frame.message + frame.messageLength, begin + view.GetSize());
+			ASSERT_EQ(frame.fileName[frame.fileNameLength], '\0');
+			ASSERT_EQ(frame.message[frame.messageLength], '\0');
+			++frames;
+		}
+
+		ASSERT_EQ(frames, view.GetFrameCount());
+	}
+
+	//most of mutations in strings and codes keep buffer valid
+	EXPECT_GT(parsed, 0);
+}
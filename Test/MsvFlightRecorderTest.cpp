@@ -0,0 +1,216 @@
+#include "pch.h"
+
+//flight recorder is enabled for the whole test binary (MSV_FLIGHT_RECORDER is defined by build)
+#include "../msvflightrecorder.h"
+#include "../msverrorcodes.h"
+#include "../msvexception.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+namespace
+{
+	MsvErrorCode ReturnFailed(MsvErrorCode errorCode)
+	{
+		MSV_RETURN_FAILED(errorCode);
+
+		return MSV_SUCCESS;
+	}
+
+	std::vector<MsvFlightRecord> DumpRecords()
+	{
+		std::vector<MsvFlightRecord> records;
+		MsvFlightRecorder::Dump([&records](const MsvFlightRecord& record) { records.push_back(record); });
+
+		return records;
+	}
+
+	//records of current thread from its ring (rings of other tests' threads are dropped, main thread ring is shared)
+	std::vector<MsvFlightRecord> DumpThreadRecords(uint32_t threadIndex)
+	{
+		std::vector<MsvFlightRecord> records;
+		for (const MsvFlightRecord& record : DumpRecords())
+		{
+			if (record.threadIndex == threadIndex)
+			{
+				records.push_back(record);
+			}
+		}
+
+		return records;
+	}
+
+	uint32_t GetThreadIndex()
+	{
+		MsvFlightRecorder::Record(MSV_SUCCESS, "marker", 0);
+
+		return DumpRecords().back().threadIndex;
+	}
+}
+
+
+TEST(MsvFlightRecorderTest, ItShouldRecordThrowsAndPropagations)
+{
+	std::thread([]()
+	{
+		uint32_t threadIndex = GetThreadIndex();
+
+		ReturnFailed(MSV_NOT_FOUND_ERROR);
+		ReturnFailed(MSV_SUCCESS);
+
+		try
+		{
+			try
+			{
+				MSV_THROW(MSV_PARSE_ERROR, "parse");
+			}
+			catch (MsvException& exception)
+			{
+				MSV_RETHROW(exception, MSV_EXECUTE_ERROR, "rethrow");
+			}
+		}
+		catch (const MsvException&)
+		{
+
+		}
+
+		std::vector<MsvFlightRecord> records = DumpThreadRecords(threadIndex);
+		ASSERT_EQ(records.size(), 4);
+
+		EXPECT_EQ(records[1].errorCode, MSV_NOT_FOUND_ERROR);
+		EXPECT_STREQ(records[1].fileName, __FILE__);
+		EXPECT_GT(records[1].line, 0);
+		EXPECT_EQ(records[2].errorCode, MSV_PARSE_ERROR);
+		EXPECT_STREQ(records[2].fileName, __FILE__);
+		EXPECT_EQ(records[3].errorCode, MSV_EXECUTE_ERROR);
+		EXPECT_GT(records[3].line, records[2].line);
+
+		for (std::size_t index = 1; index < records.size(); ++index)
+		{
+			EXPECT_GE(records[index].timestamp, records[index - 1].timestamp);
+		}
+	}).join();
+}
+
+TEST(MsvFlightRecorderTest, ItShouldKeepOnlyTheLatestRecords)
+{
+	std::thread([]()
+	{
+		uint32_t threadIndex = GetThreadIndex();
+
+		for (int line = 1; line <= MSV_FLIGHT_RECORDER_SIZE + 10; ++line)
+		{
+			MsvFlightRecorder::Record(MSV_BUSY_ERROR, "file", line);
+		}
+
+		std::vector<MsvFlightRecord> records = DumpThreadRecords(threadIndex);
+		ASSERT_EQ(records.size(), MSV_FLIGHT_RECORDER_SIZE);
+		EXPECT_EQ(records.front().line, 11);
+		EXPECT_EQ(records.back().line, MSV_FLIGHT_RECORDER_SIZE + 10);
+	}).join();
+}
+
+TEST(MsvFlightRecorderTest, ItShouldDumpAllThreadsInTimeOrder)
+{
+	const int threadCount = 4;
+	const int recordCount = 50;
+	std::atomic<int> recorded(0);
+	std::atomic<bool> dumped(false);
+	std::vector<std::thread> threads;
+
+	for (int thread = 0; thread < threadCount; ++thread)
+	{
+		threads.emplace_back([&recorded, &dumped, thread]()
+		{
+			for (int record = 0; record < recordCount; ++record)
+			{
+				MsvFlightRecorder::Record(MSV_BUSY_ERROR, "thread", thread);
+				std::this_thread::yield();
+			}
+
+			++recorded;
+			while (!dumped)
+			{
+				std::this_thread::yield();
+			}
+		});
+	}
+
+	while (recorded < threadCount)
+	{
+		std::this_thread::yield();
+	}
+
+	std::vector<MsvFlightRecord> records = DumpRecords();
+	dumped = true;
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	int threadRecords = 0;
+	for (std::size_t index = 0; index < records.size(); ++index)
+	{
+		threadRecords += std::string(records[index].fileName) == "thread";
+		if (index)
+		{
+			EXPECT_GE(records[index].timestamp, records[index - 1].timestamp);
+		}
+	}
+
+	EXPECT_EQ(threadRecords, threadCount * recordCount);
+}
+
+TEST(MsvFlightRecorderTest, ItShouldDumpWhileRecording)
+{
+	std::atomic<bool> stop(false);
+	std::thread writer([&stop]()
+	{
+		while (!stop)
+		{
+			MsvFlightRecorder::Record(MSV_BUSY_ERROR, "writer", 1);
+		}
+	});
+
+	for (int dump = 0; dump < 100; ++dump)
+	{
+		std::vector<MsvFlightRecord> records = DumpRecords();
+		for (std::size_t index = 1; index < records.size(); ++index)
+		{
+			EXPECT_GE(records[index].timestamp, records[index - 1].timestamp);
+		}
+	}
+
+	stop = true;
+	writer.join();
+}
+
+TEST(MsvFlightRecorderTest, ItShouldDumpToFile)
+{
+	ReturnFailed(MSV_NOT_ALLOWED_ERROR);
+
+	std::FILE* file = std::tmpfile();
+	ASSERT_NE(file, nullptr);
+	EXPECT_EQ(MsvFlightRecorder::Dump(file), MSV_SUCCESS);
+
+	std::string text;
+	char buffer[256];
+	std::rewind(file);
+	while (std::size_t read = std::fread(buffer, 1, sizeof(buffer), file))
+	{
+		text.append(buffer, read);
+	}
+	std::fclose(file);
+
+	EXPECT_NE(text.find(" 0xC000000D MSV_NOT_ALLOWED_ERROR "), std::string::npos);
+	EXPECT_NE(text.find(__FILE__), std::string::npos);
+}
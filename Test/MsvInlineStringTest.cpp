@@ -0,0 +1,120 @@
+#include "pch.h"
+
+#include "../msvinlinestring.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <string>
+
+MSV_ENABLE_WARNINGS
+
+
+TEST(MsvInlineStringTest, ItShouldBeEmptyAfterConstruction)
+{
+	MsvInlineString<16> string;
+
+	EXPECT_STREQ(string.GetString(), "");
+	EXPECT_EQ(string.GetLength(), 0);
+	EXPECT_TRUE(string.IsInline());
+	EXPECT_FALSE(string.IsTruncated());
+}
+
+TEST(MsvInlineStringTest, ItShouldStoreShortStringInline)
+{
+	MsvInlineString<16> string;
+
+	EXPECT_TRUE(string.Append("short"));
+	EXPECT_TRUE(string.AppendChar(' '));
+	EXPECT_TRUE(string.Append("string"));
+
+	EXPECT_STREQ(string.GetString(), "short string");
+	EXPECT_EQ(string.GetLength(), 12);
+	EXPECT_TRUE(string.IsInline());
+}
+
+TEST(MsvInlineStringTest, ItShouldMoveLongStringToHeap)
+{
+	MsvInlineString<8> string;
+	std::string longString(100, 'x');
+
+	EXPECT_TRUE(string.Append("abc"));
+	EXPECT_TRUE(string.Append(longString.c_str()));
+
+	EXPECT_EQ(std::string(string.GetString()), "abc" + longString);
+	EXPECT_FALSE(string.IsInline());
+	EXPECT_FALSE(string.IsTruncated());
+}
+
+TEST(MsvInlineStringTest, ItShouldFormatDecimalNumbersLikeStream)
+{
+	MsvInlineString<64> string;
+
+	string.AppendDecimal(20, 8, '0');
+	string.AppendChar(' ');
+	string.AppendDecimal(-1, 8, '0');
+	string.AppendChar(' ');
+	string.AppendDecimal(-1073741824, 8, '0');
+	string.AppendChar(' ');
+	string.AppendDecimal(123);
+
+	EXPECT_STREQ(string.GetString(), "00000020 000000-1 -1073741824 123");
+}
+
+TEST(MsvInlineStringTest, ItShouldFormatHexNumbers)
+{
+	MsvInlineString<32> string;
+
+	string.AppendHex(0xC000000C, 8);
+	string.AppendChar(' ');
+	string.AppendHex(0x2a, 4);
+
+	EXPECT_STREQ(string.GetString(), "C000000C 002A");
+}
+
+TEST(MsvInlineStringTest, ItShouldCopyAndMoveString)
+{
+	MsvInlineString<8> string;
+	string.Append("long enough to be on heap");
+
+	MsvInlineString<8> copy(string);
+	EXPECT_STREQ(copy.GetString(), string.GetString());
+
+	MsvInlineString<8> moved(std::move(copy));
+	EXPECT_STREQ(moved.GetString(), string.GetString());
+	EXPECT_STREQ(copy.GetString(), "");
+
+	MsvInlineString<8> assigned;
+	assigned = moved;
+	EXPECT_STREQ(assigned.GetString(), string.GetString());
+}
+
+#ifdef MSV_MEMORY_RESOURCE
+TEST(MsvInlineStringTest, ItShouldAppendToSharedStringWhenAllocationFails)
+{
+	MsvInlineString<8> string;
+	string.Append("long enough to be on heap");
+	string.Clear();
+	MsvInlineString<8> copy(string);
+	ASSERT_TRUE(copy.IsShared());
+
+	MsvExceptionMemoryResourceScope scope(std::pmr::null_memory_resource());
+	EXPECT_TRUE(copy.Append("abc"));
+	EXPECT_STREQ(copy.GetString(), "abc");
+	EXPECT_FALSE(copy.IsTruncated());
+	EXPECT_TRUE(copy.IsInline());
+	EXPECT_STREQ(string.GetString(), "");
+}
+
+TEST(MsvInlineStringTest, ItShouldTruncateSharedStringWhenAllocationFails)
+{
+	MsvInlineString<8> string;
+	string.Append("long enough to be on heap");
+	MsvInlineString<8> copy(string);
+
+	MsvExceptionMemoryResourceScope scope(std::pmr::null_memory_resource());
+	EXPECT_FALSE(copy.Append("abc"));
+	EXPECT_STREQ(copy.GetString(), "long...");
+	EXPECT_TRUE(copy.IsTruncated());
+	EXPECT_STREQ(string.GetString(), "long enough to be on heap");
+}
+#endif
@@ -0,0 +1,190 @@
+#include "pch.h"
+
+#include "../msverrorcodes.h"
+#include "../msvexception.h"
+#include "../msvmemoryresource.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+#ifdef MSV_MEMORY_RESOURCE
+
+namespace
+{
+	//counts allocations (global heap is upstream), it can fail all allocations
+	class MsvCountingResource :
+		public std::pmr::memory_resource
+	{
+	public:
+		size_t allocations = 0;
+		size_t deallocations = 0;
+		bool fail = false;
+
+	protected:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override
+		{
+			if (fail)
+			{
+				throw std::bad_alloc();
+			}
+
+			++allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* block, std::size_t bytes, std::size_t alignment) override
+		{
+			++deallocations;
+			std::pmr::new_delete_resource()->deallocate(block, bytes, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+
+	//long message is stored on the heap
+	const std::string longMessage(2 * MSV_EXCEPTION_WHAT_SIZE, 'x');
+
+	MsvException MakeException(const char* msg)
+	{
+		try
+		{
+			MSV_THROW(MSV_BUSY_ERROR, msg);
+		}
+		catch (MsvException& exception)
+		{
+			return exception;
+		}
+	}
+}
+
+
+TEST(MsvMemoryResourceTest, ItShouldUseExceptionPoolByDefault)
+{
+	EXPECT_EQ(MsvGetExceptionMemoryResource(), MsvGetExceptionPoolResource());
+}
+
+TEST(MsvMemoryResourceTest, ItShouldReuseFreedBlock)
+{
+	void* memory = MsvAllocateExceptionMemory(100);
+	ASSERT_NE(memory, nullptr);
+	MsvFreeExceptionMemory(memory);
+
+	void* reused = MsvAllocateExceptionMemory(90);
+	EXPECT_EQ(reused, memory);
+
+	void* other = MsvAllocateExceptionMemory(1000);
+	EXPECT_NE(other, memory);
+
+	MsvFreeExceptionMemory(reused);
+	MsvFreeExceptionMemory(other);
+}
+
+TEST(MsvMemoryResourceTest, ItShouldAllocateLargeBlock)
+{
+	void* memory = MsvAllocateExceptionMemory(4 * MsvExceptionPoolResource::MaxClassSize);
+	ASSERT_NE(memory, nullptr);
+
+	std::memset(memory, 'x', 4 * MsvExceptionPoolResource::MaxClassSize);
+	MsvFreeExceptionMemory(memory);
+}
+
+TEST(MsvMemoryResourceTest, ItShouldAllocateFromScopeResource)
+{
+	MsvCountingResource resource;
+
+	{
+		MsvException exception("fileName", 10, MSV_BUSY_ERROR, "message");
+
+		{
+			MsvExceptionMemoryResourceScope scope(&resource);
+			EXPECT_EQ(MsvGetExceptionMemoryResource(), &resource);
+
+			exception = MakeException(longMessage.c_str());
+			EXPECT_NE(std::string(exception.what()).find(longMessage), std::string::npos);
+		}
+
+		EXPECT_EQ(MsvGetExceptionMemoryResource(), MsvGetExceptionPoolResource());
+		EXPECT_GT(resource.allocations, resource.deallocations);
+	}
+
+	//exception destroyed out of the scope - memory is returned to its resource
+	EXPECT_EQ(resource.deallocations, resource.allocations);
+}
+
+TEST(MsvMemoryResourceTest, ItShouldAllocateFromProcessResource)
+{
+	MsvCountingResource resource;
+	EXPECT_EQ(MsvSetExceptionMemoryResource(&resource), nullptr);
+
+	std::thread worker([]()
+	{
+		MsvException exception = MakeException(longMessage.c_str());
+		EXPECT_NE(exception.what()[0], '\0');
+	});
+	worker.join();
+
+	EXPECT_EQ(MsvSetExceptionMemoryResource(nullptr), &resource);
+	EXPECT_GT(resource.allocations, 0);
+	EXPECT_EQ(resource.deallocations, resource.allocations);
+}
+
+TEST(MsvMemoryResourceTest, ItShouldPreferThreadResource)
+{
+	MsvCountingResource processResource;
+	MsvCountingResource threadResource;
+	MsvSetExceptionMemoryResource(&processResource);
+
+	{
+		MsvExceptionMemoryResourceScope scope(&threadResource);
+		MsvException exception = MakeException(longMessage.c_str());
+		EXPECT_NE(exception.what()[0], '\0');
+	}
+
+	MsvSetExceptionMemoryResource(nullptr);
+	EXPECT_EQ(processResource.allocations, 0);
+	EXPECT_GT(threadResource.allocations, 0);
+}
+
+TEST(MsvMemoryResourceTest, ItShouldTruncateMessageWhenResourceFails)
+{
+	MsvCountingResource resource;
+	resource.fail = true;
+	MsvExceptionMemoryResourceScope scope(&resource);
+
+	MsvException exception = MakeException(longMessage.c_str());
+
+	EXPECT_EQ(exception.GetErrorCode(), MSV_BUSY_ERROR);
+	EXPECT_LT(std::strlen(exception.GetFrame(0).message), MSV_EXCEPTION_MESSAGE_SIZE);
+	EXPECT_EQ(resource.allocations, 0);
+}
+
+TEST(MsvMemoryResourceTest, ItShouldKeepExceptionOfExitedThread)
+{
+	MsvException exception("fileName", 10, MSV_BUSY_ERROR, "message");
+
+	std::thread worker([&exception]()
+	{
+		exception = MakeException(longMessage.c_str());
+		for (int line = 0; line < 2 * MSV_EXCEPTION_INLINE_FRAMES; ++line)
+		{
+			exception.Rethrowing("fileName", line, MSV_EXECUTE_ERROR, longMessage.c_str());
+		}
+	});
+	worker.join();
+
+	EXPECT_EQ(exception.GetFrameCount(), 2 * MSV_EXCEPTION_INLINE_FRAMES + 1);
+	EXPECT_STREQ(exception.GetFrame(1).message, longMessage.c_str());
+	EXPECT_NE(std::string(exception.what()).find(longMessage), std::string::npos);
+}
+
+#endif // MSV_MEMORY_RESOURCE
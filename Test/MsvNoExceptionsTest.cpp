@@ -0,0 +1,160 @@
+#include "pch.h"
+
+//the same tests are built with exceptions (MsvErrorTest) and without them (MsvNoExceptionsTest with failure handler,
+//MsvNoExceptionsReturnTest with MSV_NO_EXCEPTIONS_RETURN)
+#include "../msverrorcodes.h"
+#include "../msvexception.h"
+#include "../msvresult.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+MSV_ENABLE_WARNINGS
+
+
+namespace
+{
+	MsvErrorCode Throw(MsvErrorCode errorCode)
+	{
+		MSV_THROW(errorCode, "no exceptions");
+	}
+
+	MsvErrorCode ThrowFailed(MsvErrorCode errorCode)
+	{
+		MSV_THROW_FAILED(errorCode, "no exceptions");
+
+		return MSV_SUCCESS;
+	}
+
+	MsvResult<int> ThrowResult(MsvErrorCode errorCode)
+	{
+		MSV_THROW_FAILED(errorCode, "no exceptions");
+
+		return 42;
+	}
+
+	MsvErrorCode Rethrow(MsvException& exception)
+	{
+		MSV_RETHROW(exception, MSV_OPEN_ERROR, "rethrow");
+	}
+
+#if defined(MSV_NO_EXCEPTIONS) && !defined(MSV_NO_EXCEPTIONS_RETURN)
+	//failure handler records failure to stderr and aborts - it must not return and jumping out of it (longjmp) would
+	//skip destructors, so failures are checked by death tests
+	[[noreturn]] void RecordingFailureHandler(const MsvException& exception)
+	{
+		std::fprintf(stderr, "failure %d frames %zu message %s\n", exception.GetErrorCode(), exception.GetFrameCount(), exception.GetFrame(exception.GetFrameCount() - 1).message);
+		std::fflush(stderr);
+		std::abort();
+	}
+
+	template<typename Function>
+	void RaiseFailure(Function function)
+	{
+		MsvSetFailureHandler(&RecordingFailureHandler);
+		function();
+	}
+
+	//regex of failure recorded by RecordingFailureHandler
+	std::string FailureRegex(MsvErrorCode errorCode)
+	{
+		return "failure " + std::to_string(errorCode) + " ";
+	}
+#elif !defined(MSV_NO_EXCEPTIONS)
+	//returns errorcode of caught exception or MSV_SUCCESS when function returned
+	template<typename Function>
+	MsvErrorCode CatchFailure(Function function)
+	{
+		try
+		{
+			function();
+		}
+		catch (const MsvException& exception)
+		{
+			return exception.GetErrorCode();
+		}
+
+		return MSV_SUCCESS;
+	}
+#endif
+}
+
+#if defined(MSV_NO_EXCEPTIONS) && !defined(MSV_NO_EXCEPTIONS_RETURN)
+#define EXPECT_FAILURE(errorCode, ...) EXPECT_DEATH(RaiseFailure([&]() { __VA_ARGS__; }), FailureRegex(errorCode))
+#define EXPECT_NO_FAILURE(...) { __VA_ARGS__; }
+#elif !defined(MSV_NO_EXCEPTIONS)
+#define EXPECT_FAILURE(errorCode, ...) EXPECT_EQ(CatchFailure([&]() { __VA_ARGS__; }), errorCode)
+#define EXPECT_NO_FAILURE(...) EXPECT_EQ(CatchFailure([&]() { __VA_ARGS__; }), MSV_SUCCESS)
+#endif
+
+
+#ifdef MSV_NO_EXCEPTIONS_RETURN
+TEST(MsvNoExceptionsTest, ItShouldReturnThrownErrorCode)
+{
+	EXPECT_EQ(Throw(MSV_BUSY_ERROR), MSV_BUSY_ERROR);
+	EXPECT_EQ(ThrowFailed(MSV_STILL_RUNNING_WARN), MSV_STILL_RUNNING_WARN);
+	EXPECT_EQ(ThrowFailed(MSV_NOT_FOUND_INFO), MSV_SUCCESS);
+
+	MsvResult<int> result = ThrowResult(MSV_PARSE_ERROR);
+	EXPECT_TRUE(result.Failed());
+	EXPECT_EQ(result.GetErrorCode(), MSV_PARSE_ERROR);
+	EXPECT_EQ(ThrowResult(MSV_SUCCESS).GetValue(), 42);
+}
+
+TEST(MsvNoExceptionsTest, ItShouldAddFrameAndReturnRethrownErrorCode)
+{
+	MsvException exception(__FILE__, __LINE__, MSV_BUSY_ERROR, "original");
+
+	EXPECT_EQ(Rethrow(exception), MSV_OPEN_ERROR);
+	EXPECT_EQ(exception.GetFrameCount(), 2);
+	EXPECT_EQ(exception.GetErrorCode(), MSV_OPEN_ERROR);
+}
+#else
+TEST(MsvNoExceptionsTest, ItShouldRaiseThrownErrorCode)
+{
+	EXPECT_FAILURE(MSV_BUSY_ERROR, Throw(MSV_BUSY_ERROR));
+	EXPECT_FAILURE(MSV_STILL_RUNNING_WARN, ThrowFailed(MSV_STILL_RUNNING_WARN));
+	EXPECT_NO_FAILURE(ThrowFailed(MSV_NOT_FOUND_INFO));
+	EXPECT_FAILURE(MSV_PARSE_ERROR, ThrowResult(MSV_PARSE_ERROR));
+}
+
+TEST(MsvNoExceptionsTest, ItShouldRaiseRethrownException)
+{
+	MsvException exception(__FILE__, __LINE__, MSV_BUSY_ERROR, "original");
+
+	EXPECT_FAILURE(MSV_OPEN_ERROR, Rethrow(exception));
+#ifndef MSV_NO_EXCEPTIONS
+	EXPECT_EQ(exception.GetFrameCount(), 2);
+#endif
+}
+
+TEST(MsvNoExceptionsTest, ItShouldRaiseFailedValue)
+{
+	EXPECT_NO_FAILURE(int value = MSV_VALUE_OR_THROW(ThrowResult(MSV_SUCCESS), "value"); EXPECT_EQ(value, 42));
+	EXPECT_FAILURE(MSV_OPEN_ERROR, MSV_VALUE_OR_THROW(ThrowResult(MSV_OPEN_ERROR), "value"));
+}
+
+#ifdef MSV_NO_EXCEPTIONS
+TEST(MsvNoExceptionsTest, ItShouldPassExceptionToFailureHandler)
+{
+	MsvException exception(__FILE__, __LINE__, MSV_BUSY_ERROR, "original");
+
+	EXPECT_DEATH(RaiseFailure([&exception]() { Rethrow(exception); }), FailureRegex(MSV_OPEN_ERROR) + "frames 2 message rethrow");
+}
+
+TEST(MsvNoExceptionsDeathTest, ItShouldAbortByDefaultFailureHandler)
+{
+	EXPECT_DEATH(Throw(MSV_BUSY_ERROR), "no exceptions");
+}
+#endif
+#endif
+
+TEST(MsvNoExceptionsTest, ItShouldKeepSuccessPath)
+{
+	EXPECT_EQ(ThrowFailed(MSV_SUCCESS), MSV_SUCCESS);
+	EXPECT_EQ(ThrowResult(MSV_ALREADY_SET_INFO).GetValue(), 42);
+	EXPECT_EQ(MsvCatchResult([]() { return 7; }).GetValue(), 7);
+}
@@ -0,0 +1,248 @@
+#include "pch.h"
+
+#include "../msverrorcodes.h"
+#include "../msvexception.h"
+#include "../msvresult.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+MSV_ENABLE_WARNINGS
+
+
+namespace
+{
+	//when set, every allocation request fails
+	bool failAllocations = false;
+
+	//number of operator new calls while allocations fail
+	size_t failedNewCounter = 0;
+
+	//number of malloc calls while allocations fail
+	size_t failedMallocCounter = 0;
+
+	//long message (it does not fit to inline message buffer)
+	const std::string longMessage(3 * MSV_EXCEPTION_MESSAGE_SIZE, 'x');
+
+	//runs allocation failure scope (allocators are restored even when test fails)
+	class MsvFailingAllocations
+	{
+	public:
+		MsvFailingAllocations() noexcept
+		{
+			failedNewCounter = 0;
+			failedMallocCounter = 0;
+			failAllocations = true;
+		}
+
+		~MsvFailingAllocations() noexcept
+		{
+			failAllocations = false;
+		}
+	};
+}
+
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(std::size_t size);
+
+//C++ runtime allocates thrown exceptions by malloc - it must fail too (runtime emergency pool is used then)
+extern "C" void* malloc(std::size_t size)
+{
+	if (failAllocations)
+	{
+		++failedMallocCounter;
+		return nullptr;
+	}
+
+	return __libc_malloc(size);
+}
+#endif
+
+void* operator new(std::size_t size)
+{
+	if (failAllocations)
+	{
+		++failedNewCounter;
+		throw std::bad_alloc();
+	}
+
+	if (void* memory = std::malloc(size ? size : 1))
+	{
+		return memory;
+	}
+
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	if (failAllocations)
+	{
+		++failedNewCounter;
+		return nullptr;
+	}
+
+	return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+
+
+TEST(MsvOutOfMemoryTest, ItShouldThrowAllocationErrorWithoutAllocations)
+{
+	MsvErrorCode errorCode = MSV_SUCCESS;
+	size_t messageLength = 0;
+	bool truncated = false;
+	bool whatSet = false;
+
+	{
+		MsvFailingAllocations failingAllocations;
+
+		try
+		{
+			MSV_THROW(MSV_ALLOCATION_ERROR, longMessage.c_str());
+		}
+		catch (const MsvException& exception)
+		{
+			const char* message = exception.GetFrame(0).message;
+			errorCode = exception.GetErrorCode();
+			messageLength = std::strlen(message);
+			truncated = messageLength >= 3 && std::strcmp(message + messageLength - 3, "...") == 0;
+			whatSet = std::strstr(exception.what(), "xxx...") != nullptr;
+		}
+
+		//allocation errors never ask operator new for memory
+		EXPECT_EQ(failedNewCounter, 0);
+	}
+
+	EXPECT_EQ(errorCode, MSV_ALLOCATION_ERROR);
+	EXPECT_EQ(messageLength + 1, MSV_EXCEPTION_ALLOCATION_MESSAGE_SIZE);
+	EXPECT_TRUE(truncated);
+	EXPECT_TRUE(whatSet);
+}
+
+TEST(MsvOutOfMemoryTest, ItShouldRethrowAllocationErrorWithoutAllocations)
+{
+	MsvErrorCode errorCode = MSV_SUCCESS;
+	size_t frameCount = 0;
+	bool whatSet = false;
+
+	{
+		MsvFailingAllocations failingAllocations;
+
+		try
+		{
+			try
+			{
+				MSV_THROW(MSV_ALLOCATION_ERROR, longMessage.c_str());
+			}
+			catch (MsvException& exception)
+			{
+				MSV_RETHROW(exception, MSV_ALLOCATION_ERROR, longMessage.c_str());
+			}
+		}
+		catch (const MsvException& exception)
+		{
+			errorCode = exception.GetErrorCode();
+			frameCount = exception.GetFrameCount();
+			whatSet = exception.what()[0] != '\0';
+		}
+
+		EXPECT_EQ(failedNewCounter, 0);
+	}
+
+	EXPECT_EQ(errorCode, MSV_ALLOCATION_ERROR);
+	EXPECT_EQ(frameCount, 2);
+	EXPECT_TRUE(whatSet);
+}
+
+TEST(MsvOutOfMemoryTest, ItShouldThrowOtherErrorsWhenAllocationsFail)
+{
+	MsvErrorCode errorCode = MSV_SUCCESS;
+	size_t messageLength = 0;
+
+	{
+		MsvFailingAllocations failingAllocations;
+
+		try
+		{
+			MSV_THROW(MSV_BUSY_ERROR, longMessage.c_str());
+		}
+		catch (const MsvException& exception)
+		{
+			errorCode = exception.GetErrorCode();
+			messageLength = std::strlen(exception.GetFrame(0).message);
+		}
+	}
+
+	//heap allocation has been tried and failed - message is truncated
+	EXPECT_EQ(errorCode, MSV_BUSY_ERROR);
+	EXPECT_LT(messageLength, MSV_EXCEPTION_MESSAGE_SIZE);
+}
+
+TEST(MsvOutOfMemoryTest, ItShouldThrowFailedResultWhenAllocationsFail)
+{
+	MsvErrorCode errorCode = MSV_SUCCESS;
+
+	{
+		MsvFailingAllocations failingAllocations;
+
+		try
+		{
+			MsvResult<int> result = MsvFailure(MSV_ALLOCATION_ERROR);
+			MSV_VALUE_OR_THROW(result, "value is not available");
+		}
+		catch (const MsvException& exception)
+		{
+			errorCode = exception.GetErrorCode();
+		}
+
+		EXPECT_EQ(failedNewCounter, 0);
+	}
+
+	EXPECT_EQ(errorCode, MSV_ALLOCATION_ERROR);
+}
+
+#if defined(__GLIBC__)
+TEST(MsvOutOfMemoryTest, ItShouldThrowWhenRuntimeCannotAllocateException)
+{
+	MsvErrorCode errorCode = MSV_SUCCESS;
+	size_t failedMallocs = 0;
+
+	{
+		MsvFailingAllocations failingAllocations;
+
+		try
+		{
+			MSV_THROW(MSV_ALLOCATION_ERROR, "out of memory");
+		}
+		catch (const MsvException& exception)
+		{
+			errorCode = exception.GetErrorCode();
+		}
+
+		failedMallocs = failedMallocCounter;
+	}
+
+	//thrown object has been placed to C++ runtime emergency storage
+	EXPECT_GT(failedMallocs, 0);
+	EXPECT_EQ(errorCode, MSV_ALLOCATION_ERROR);
+}
+#endif
@@ -0,0 +1,172 @@
+#include "pch.h"
+
+#include "../msvresult.h"
+#include "../msverrorcodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+MSV_ENABLE_WARNINGS
+
+
+static_assert(std::is_trivially_copyable<MsvResult<int>>::value, "MsvResult<int> must be trivially copyable.");
+static_assert(std::is_trivially_copyable<MsvResult<double>>::value, "MsvResult<double> must be trivially copyable.");
+static_assert(std::is_trivially_copyable<MsvResult<void>>::value, "MsvResult<void> must be trivially copyable.");
+static_assert(!std::is_trivially_copyable<MsvResult<std::string>>::value, "MsvResult<std::string> must not be trivially copyable.");
+
+struct MsvResultTestPair
+{
+	int64_t value;
+	MsvErrorCode errorCode;
+};
+
+static_assert(sizeof(MsvResult<int>) == 2 * sizeof(MsvErrorCode), "MsvResult<int> must not have discriminant.");
+static_assert(sizeof(MsvResult<int64_t>) == sizeof(MsvResultTestPair), "MsvResult<int64_t> must not have discriminant.");
+static_assert(sizeof(MsvResult<void>) == sizeof(MsvErrorCode), "MsvResult<void> must not have discriminant.");
+
+static_assert(MsvResult<int>(42).GetValue() == 42, "MsvResult must be constexpr.");
+static_assert(MsvResult<int>(MsvFailure(MSV_NOT_FOUND_ERROR)).Failed(), "MsvResult must be constexpr.");
+static_assert(MsvResult<int>(MsvFailure(MSV_NOT_FOUND_ERROR)).GetErrorCode() == MSV_NOT_FOUND_ERROR, "MsvResult must keep failed errorcode.");
+static_assert(MsvResult<int>(MsvFailure(MSV_STILL_RUNNING_WARN)).GetErrorCode() == MSV_STILL_RUNNING_WARN, "MsvResult must keep failed errorcode.");
+static_assert(MsvResult<int>(MsvFailure(MSV_NOT_FOUND_INFO)).Failed(), "MsvResult without value must be failed.");
+
+
+MsvResult<int> MsvResultTestParse(int value)
+{
+	if (value < 0)
+	{
+		return MsvFailure(MSV_INVALID_DATA_ERROR);
+	}
+
+	return value;
+}
+
+MsvResult<int> MsvResultTestDouble(int value)
+{
+	MSV_TRY(int parsed, MsvResultTestParse(value));
+
+	return parsed * 2;
+}
+
+MsvErrorCode MsvResultTestCode(int value)
+{
+	MSV_TRY(int parsed, MsvResultTestDouble(value));
+	MSV_TRY_VOID(MsvResult<void>(parsed > 10 ? MSV_ALREADY_EXISTS_INFO : MSV_SUCCESS));
+
+	return MSV_SUCCESS;
+}
+
+
+TEST(MsvResultTest, ItShouldHoldValue)
+{
+	MsvResult<int> result(42);
+
+	EXPECT_TRUE(result.HasValue());
+	EXPECT_TRUE(static_cast<bool>(result));
+	EXPECT_FALSE(result.Failed());
+	EXPECT_EQ(result.GetErrorCode(), MSV_SUCCESS);
+	EXPECT_EQ(result.GetValue(), 42);
+	EXPECT_EQ(result.GetValueOr(7), 42);
+}
+
+TEST(MsvResultTest, ItShouldHoldFailure)
+{
+	MsvResult<int> result = MsvFailure(MSV_NOT_FOUND_ERROR);
+
+	EXPECT_FALSE(result.HasValue());
+	EXPECT_FALSE(static_cast<bool>(result));
+	EXPECT_TRUE(result.Failed());
+	EXPECT_EQ(result.GetErrorCode(), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(result.GetValueOr(7), 7);
+}
+
+TEST(MsvResultTest, ItShouldHoldValueWithInfo)
+{
+	MsvResult<int> result(MSV_ALREADY_EXISTS_INFO, std::in_place, 5);
+
+	EXPECT_TRUE(result.HasValue());
+	EXPECT_EQ(result.GetErrorCode(), MSV_ALREADY_EXISTS_INFO);
+	EXPECT_EQ(result.GetValue(), 5);
+}
+
+TEST(MsvResultTest, ItShouldTreatWarningAsFailure)
+{
+	MsvResult<int> result = MsvFailure(MSV_STILL_RUNNING_WARN);
+
+	EXPECT_FALSE(result.HasValue());
+	EXPECT_EQ(result.GetErrorCode(), MSV_STILL_RUNNING_WARN);
+}
+
+TEST(MsvResultTest, ItShouldPropagateFailure)
+{
+	EXPECT_EQ(MsvResultTestDouble(4).GetValue(), 8);
+	EXPECT_EQ(MsvResultTestDouble(-1).GetErrorCode(), MSV_INVALID_DATA_ERROR);
+
+	EXPECT_EQ(MsvResultTestCode(2), MSV_SUCCESS);
+	EXPECT_EQ(MsvResultTestCode(8), MSV_SUCCESS);
+	EXPECT_EQ(MsvResultTestCode(-1), MSV_INVALID_DATA_ERROR);
+}
+
+TEST(MsvResultTest, ItShouldCopyAndMoveNotTrivialValue)
+{
+	MsvResult<std::string> result(std::string("not trivially copyable value"));
+	MsvResult<std::string> copy(result);
+	MsvResult<std::string> failed = MsvFailure(MSV_NOT_FOUND_ERROR);
+
+	EXPECT_EQ(copy.GetValue(), "not trivially copyable value");
+
+	failed = copy;
+	EXPECT_EQ(failed.GetValue(), "not trivially copyable value");
+
+	copy = MsvFailure(MSV_NOT_FOUND_ERROR);
+	EXPECT_TRUE(copy.Failed());
+
+	MsvResult<std::string> moved(std::move(result));
+	EXPECT_EQ(moved.GetValue(), "not trivially copyable value");
+
+	std::string value = std::move(moved).GetValue();
+	EXPECT_EQ(value, "not trivially copyable value");
+}
+
+TEST(MsvResultTest, ItShouldHoldMoveOnlyValue)
+{
+	MsvResult<std::unique_ptr<int>> result(std::make_unique<int>(3));
+	MsvResult<std::unique_ptr<int>> moved(std::move(result));
+
+	std::unique_ptr<int> value = MSV_VALUE_OR_THROW(moved, "no value");
+	EXPECT_EQ(*value, 3);
+}
+
+TEST(MsvResultTest, ItShouldThrowFailedResult)
+{
+	MsvResult<int> result = MsvFailure(MSV_NOT_FOUND_ERROR);
+
+	try
+	{
+		MSV_VALUE_OR_THROW(result, "not found");
+		FAIL();
+	}
+	catch (const MsvException& exception)
+	{
+		EXPECT_EQ(exception.GetErrorCode(), MSV_NOT_FOUND_ERROR);
+		EXPECT_NE(std::string(exception.what()).find("not found"), std::string::npos);
+	}
+
+	MsvResult<int> succeeded(1);
+	EXPECT_EQ(MSV_VALUE_OR_THROW(succeeded, "not thrown"), 1);
+}
+
+TEST(MsvResultTest, ItShouldCatchException)
+{
+	MsvResult<int> result = MsvCatchResult([]() -> int { MSV_THROW(MSV_BUSY_ERROR, "busy"); });
+	EXPECT_EQ(result.GetErrorCode(), MSV_BUSY_ERROR);
+
+	MsvResult<int> value = MsvCatchResult([]() { return 6; });
+	EXPECT_EQ(value.GetValue(), 6);
+
+	MsvResult<void> empty = MsvCatchResult([]() {});
+	EXPECT_TRUE(empty.HasValue());
+}
@@ -0,0 +1,195 @@
+#include "pch.h"
+
+//stack traces are enabled for the whole test binary (MSV_EXCEPTION_STACK_TRACE is defined by build)
+#include "../msvstacktrace.h"
+#include "../msverrorcodes.h"
+#include "../msvexception.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdlib>
+#include <new>
+#include <string>
+
+MSV_ENABLE_WARNINGS
+
+
+namespace
+{
+	//number of heap allocations done by operator new
+	size_t allocationCounter = 0;
+}
+
+void* operator new(std::size_t size)
+{
+	++allocationCounter;
+
+	if (void* memory = std::malloc(size ? size : 1))
+	{
+		return memory;
+	}
+
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	++allocationCounter;
+
+	return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+
+
+//prevents tail calls (caller frames would be missing in traces)
+volatile int msvStackTraceTestCalls = 0;
+
+//external linkage - symbols are exported from test binary (dladdr does not see local symbols)
+MSV_NOINLINE void MsvStackTraceTestThrow()
+{
+	MSV_THROW(MSV_BUSY_ERROR, "message");
+}
+
+MSV_NOINLINE void MsvStackTraceTestCallThrow()
+{
+	MsvStackTraceTestThrow();
+	++msvStackTraceTestCalls;
+}
+
+MSV_NOINLINE MsvStackTrace MsvStackTraceTestCapture()
+{
+	MsvStackTrace stackTrace;
+	stackTrace.Capture();
+
+	return stackTrace;
+}
+
+
+TEST(MsvStackTraceTest, ItShouldCaptureCallerFirst)
+{
+	MsvStackTrace stackTrace = MsvStackTraceTestCapture();
+
+	ASSERT_GT(stackTrace.GetSize(), 1);
+	EXPECT_LE(stackTrace.GetSize(), MSV_STACK_TRACE_DEPTH);
+	EXPECT_EQ(MsvStackTraceSymbolizer::Resolve(stackTrace.GetAddress(0)).function, "MsvStackTraceTestCapture()");
+}
+
+TEST(MsvStackTraceTest, ItShouldSkipCallers)
+{
+	MsvStackTrace stackTrace;
+	stackTrace.Capture();
+
+	MsvStackTrace skipped;
+	skipped.Capture(1);
+
+	ASSERT_GT(skipped.GetSize(), 0);
+	EXPECT_EQ(MsvStackTraceSymbolizer::Resolve(skipped.GetAddress(0)).function, MsvStackTraceSymbolizer::Resolve(stackTrace.GetAddress(1)).function);
+}
+
+TEST(MsvStackTraceTest, ItShouldCaptureThrowSite)
+{
+	try
+	{
+		MsvStackTraceTestCallThrow();
+		FAIL();
+	}
+	catch (const MsvException& exception)
+	{
+		ASSERT_GT(exception.GetStackTrace().GetSize(), 1);
+		EXPECT_EQ(MsvStackTraceSymbolizer::Resolve(exception.GetStackTrace().GetAddress(0)).function, "MsvStackTraceTestThrow()");
+		EXPECT_EQ(MsvStackTraceSymbolizer::Resolve(exception.GetStackTrace().GetAddress(1)).function, "MsvStackTraceTestCallThrow()");
+
+		std::string trace = exception.GetStackTrace().ToString();
+
+		size_t throwPosition = trace.find("MsvStackTraceTestThrow()");
+		size_t callPosition = trace.find("MsvStackTraceTestCallThrow()");
+		EXPECT_NE(throwPosition, std::string::npos);
+		EXPECT_NE(callPosition, std::string::npos);
+		EXPECT_LT(throwPosition, callPosition);
+		EXPECT_EQ(trace.compare(0, 3, "#0 "), 0);
+		EXPECT_EQ(trace.back(), '\n');
+	}
+}
+
+TEST(MsvStackTraceTest, ItShouldKeepTraceInCopiesAndRethrows)
+{
+	try
+	{
+		try
+		{
+			MsvStackTraceTestCallThrow();
+		}
+		catch (MsvException& exception)
+		{
+			MsvException copy(exception);
+			ASSERT_EQ(copy.GetStackTrace().GetSize(), exception.GetStackTrace().GetSize());
+			for (size_t index = 0; index < copy.GetStackTrace().GetSize(); ++index)
+			{
+				EXPECT_EQ(copy.GetStackTrace().GetAddress(index), exception.GetStackTrace().GetAddress(index));
+			}
+
+			MSV_RETHROW(exception, MSV_OPEN_ERROR, "rethrow");
+		}
+	}
+	catch (const MsvException& exception)
+	{
+		EXPECT_EQ(exception.GetFrameCount(), 2);
+		EXPECT_NE(exception.GetStackTrace().ToString().find("MsvStackTraceTestThrow()"), std::string::npos);
+	}
+}
+
+TEST(MsvStackTraceTest, ItShouldCaptureWithoutAllocation)
+{
+	size_t allocations = allocationCounter;
+
+	try
+	{
+		MsvStackTraceTestCallThrow();
+	}
+	catch (const MsvException& exception)
+	{
+		EXPECT_GT(exception.GetStackTrace().GetSize(), 0);
+	}
+
+	EXPECT_EQ(allocationCounter - allocations, 0);
+}
+
+TEST(MsvStackTraceTest, ItShouldSymbolizeAddressOnlyOnce)
+{
+	MsvStackTrace stackTrace = MsvStackTraceTestCapture();
+
+	const MsvStackTraceSymbol& symbol = MsvStackTraceSymbolizer::Resolve(stackTrace.GetAddress(0));
+	size_t cacheSize = MsvStackTraceSymbolizer::GetCacheSize();
+
+	for (int index = 0; index < 10; ++index)
+	{
+		MsvStackTrace repeated = MsvStackTraceTestCapture();
+		EXPECT_EQ(&MsvStackTraceSymbolizer::Resolve(repeated.GetAddress(0)), &symbol);
+	}
+
+	EXPECT_EQ(MsvStackTraceSymbolizer::GetCacheSize(), cacheSize);
+	EXPECT_FALSE(symbol.module.empty());
+	EXPECT_GT(symbol.offset, 0);
+}
+
+TEST(MsvStackTraceTest, ItShouldFormatEmptyTrace)
+{
+	MsvStackTrace stackTrace;
+
+	EXPECT_EQ(stackTrace.GetSize(), 0);
+	EXPECT_EQ(stackTrace.ToString(), "");
+}
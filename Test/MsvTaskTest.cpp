@@ -0,0 +1,210 @@
+#include "pch.h"
+
+//coroutines need C++20 - the test binary is built by C++20 (all tests are skipped without coroutines)
+#include "../msverrorcodes.h"
+#include "../msvtask.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <string>
+
+MSV_ENABLE_WARNINGS
+
+
+#ifdef MSV_COROUTINES
+
+namespace
+{
+	//statements executed after awaits (short circuited coroutines must not continue)
+	int continuedCounter = 0;
+
+	//destroyed locals of coroutines
+	int destroyedCounter = 0;
+
+	//coroutine suspended by asynchronous operation
+	std::coroutine_handle<> pendingCoroutine;
+
+	struct MsvTaskTestLocal
+	{
+		~MsvTaskTestLocal()
+		{
+			++destroyedCounter;
+		}
+	};
+
+	//simulates asynchronous operation completed later by ResumePending
+	struct MsvTaskTestOperation
+	{
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> coroutine) noexcept { pendingCoroutine = coroutine; }
+		int await_resume() const noexcept { return 5; }
+	};
+
+	void ResumePending()
+	{
+		std::coroutine_handle<> coroutine = std::exchange(pendingCoroutine, nullptr);
+		coroutine.resume();
+	}
+
+	MsvTask<int> ReturnValue(int value)
+	{
+		co_return value;
+	}
+
+	MsvTask<int> ReturnFailure(MsvErrorCode errorCode)
+	{
+		co_return MsvFailure(errorCode);
+	}
+
+	MsvTask<int> AddValues(MsvTask<int> first, MsvTask<int> second)
+	{
+		int value = co_await first;
+		++continuedCounter;
+		value += co_await second;
+		++continuedCounter;
+
+		co_return value;
+	}
+
+	MsvTask<int> AddNested(MsvTask<int> first, MsvTask<int> second)
+	{
+		MsvTaskTestLocal local;
+		int value = co_await AddValues(std::move(first), std::move(second));
+		++continuedCounter;
+
+		co_return value;
+	}
+
+	MsvTask<void> CheckValue(MsvTask<int> task)
+	{
+		MsvResult<int> result = co_await task.AwaitResult();
+		++continuedCounter;
+
+		co_return result.Failed() ? MSV_NOT_FOUND_INFO : MSV_SUCCESS;
+	}
+
+	MsvTask<std::string> ReturnString()
+	{
+		co_return std::string(100, 's');
+	}
+
+	MsvTask<int> Throw()
+	{
+		MSV_THROW(MSV_PARSE_ERROR, "task failed");
+		co_return 0;
+	}
+
+	MsvTask<int> AwaitOperation()
+	{
+		int value = co_await MsvTaskTestOperation();
+
+		co_return value;
+	}
+}
+
+
+TEST(MsvTaskTest, ItShouldBeLazy)
+{
+	MsvTask<int> task = ReturnValue(7);
+	EXPECT_FALSE(task.IsDone());
+	EXPECT_EQ(task.GetResult().GetErrorCode(), MSV_STILL_RUNNING_ERROR);
+
+	task.Start();
+	EXPECT_TRUE(task.IsDone());
+	EXPECT_EQ(task.GetResult().GetValue(), 7);
+}
+
+TEST(MsvTaskTest, ItShouldReturnValueOfAwaitedTasks)
+{
+	continuedCounter = 0;
+	destroyedCounter = 0;
+
+	MsvResult<int> result = AddNested(ReturnValue(1), ReturnValue(2)).Run();
+
+	ASSERT_TRUE(result.HasValue());
+	EXPECT_EQ(result.GetValue(), 3);
+	EXPECT_EQ(continuedCounter, 3);
+	EXPECT_EQ(destroyedCounter, 1);
+}
+
+TEST(MsvTaskTest, ItShouldShortCircuitAwaitingTasks)
+{
+	continuedCounter = 0;
+	destroyedCounter = 0;
+
+	{
+		MsvTask<int> task = AddNested(ReturnFailure(MSV_BUSY_ERROR), ReturnValue(2));
+		task.Start();
+
+		EXPECT_TRUE(task.IsDone());
+		EXPECT_EQ(task.GetResult().GetErrorCode(), MSV_BUSY_ERROR);
+		EXPECT_EQ(continuedCounter, 0);
+		EXPECT_EQ(destroyedCounter, 0);
+	}
+
+	//locals of short circuited coroutine are destroyed with task
+	EXPECT_EQ(destroyedCounter, 1);
+}
+
+TEST(MsvTaskTest, ItShouldShortCircuitOnLaterAwait)
+{
+	continuedCounter = 0;
+
+	MsvResult<int> result = AddValues(ReturnValue(1), ReturnFailure(MSV_OPEN_ERROR)).Run();
+
+	EXPECT_EQ(result.GetErrorCode(), MSV_OPEN_ERROR);
+	EXPECT_EQ(continuedCounter, 1);
+}
+
+TEST(MsvTaskTest, ItShouldShortCircuitByAlreadyFailedTask)
+{
+	MsvTask<int> failed = ReturnFailure(MSV_CLOSE_ERROR);
+	failed.Start();
+
+	MsvResult<int> result = AddValues(std::move(failed), ReturnValue(2)).Run();
+
+	EXPECT_EQ(result.GetErrorCode(), MSV_CLOSE_ERROR);
+}
+
+TEST(MsvTaskTest, ItShouldAwaitResultWithoutShortCircuit)
+{
+	continuedCounter = 0;
+
+	EXPECT_EQ(CheckValue(ReturnFailure(MSV_BUSY_ERROR)).Run().GetErrorCode(), MSV_NOT_FOUND_INFO);
+	EXPECT_EQ(CheckValue(ReturnValue(1)).Run().GetErrorCode(), MSV_SUCCESS);
+	EXPECT_EQ(continuedCounter, 2);
+}
+
+TEST(MsvTaskTest, ItShouldReturnNonTrivialValue)
+{
+	MsvResult<std::string> result = ReturnString().Run();
+
+	ASSERT_TRUE(result.HasValue());
+	EXPECT_EQ(result.GetValue(), std::string(100, 's'));
+}
+
+#ifndef MSV_NO_EXCEPTIONS
+TEST(MsvTaskTest, ItShouldConvertThrownExceptionToFailure)
+{
+	MsvResult<int> result = AddValues(ReturnValue(1), Throw()).Run();
+
+	EXPECT_EQ(result.GetErrorCode(), MSV_PARSE_ERROR);
+}
+#endif
+
+TEST(MsvTaskTest, ItShouldResumeAwaitingTaskAfterAsynchronousOperation)
+{
+	MsvTask<int> task = AddValues(AwaitOperation(), ReturnValue(2));
+
+	task.Start();
+	EXPECT_FALSE(task.IsDone());
+	EXPECT_EQ(task.GetResult().GetErrorCode(), MSV_STILL_RUNNING_ERROR);
+	ASSERT_TRUE(pendingCoroutine);
+
+	ResumePending();
+
+	EXPECT_TRUE(task.IsDone());
+	EXPECT_EQ(task.GetResult().GetValue(), 7);
+}
+
+#endif // MSV_COROUTINES
@@ -0,0 +1,62 @@
+#include "pch.h"
+
+#include "../msvtimestamp.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <chrono>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+TEST(MsvTimestampTest, ItShouldBeMonotonic)
+{
+	MsvTimestamp first = MsvTimestampNow();
+	MsvTimestamp second = MsvTimestampNow();
+
+	EXPECT_LE(first, second);
+	EXPECT_GE(MsvTimestampElapsed(first, second).count(), 0);
+}
+
+TEST(MsvTimestampTest, ItShouldMeasureElapsedTime)
+{
+	MsvTimestamp start = MsvTimestampNow();
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	MsvTimestamp end = MsvTimestampNow();
+
+	EXPECT_GE(MsvTimestampElapsed(start, end), std::chrono::milliseconds(15));
+	EXPECT_LT(MsvTimestampElapsed(start, end), std::chrono::seconds(5));
+	EXPECT_EQ(MsvTimestampElapsed(end, start), -MsvTimestampElapsed(start, end));
+}
+
+TEST(MsvTimestampTest, ItShouldConvertToSystemTime)
+{
+	std::chrono::system_clock::time_point before = std::chrono::system_clock::now();
+	std::chrono::system_clock::time_point converted = MsvTimestampToSystemTime(MsvTimestampNow());
+	std::chrono::system_clock::time_point after = std::chrono::system_clock::now();
+
+	EXPECT_GT(converted, before - std::chrono::milliseconds(50));
+	EXPECT_LT(converted, after + std::chrono::milliseconds(50));
+}
+
+TEST(MsvTimestampTest, ItShouldKeepCalibration)
+{
+	const MsvTimestampCalibration& calibration = MsvTimestampGetCalibration();
+
+	EXPECT_TRUE(MsvTimestampCalibrated);
+	EXPECT_EQ(&calibration, &MsvTimestampGetCalibration());
+	EXPECT_GT(calibration.tickNanoseconds, 0.0);
+}
+
+TEST(MsvTimestampTest, ItShouldCountNanosecondsWithoutTimeStampCounter)
+{
+	if (MsvTimestampUseTsc())
+	{
+		EXPECT_EQ(MSV_TIMESTAMP_SOURCE, MSV_TIMESTAMP_TSC);
+		return;
+	}
+
+	EXPECT_EQ(MsvTimestampGetCalibration().tickNanoseconds, 1.0);
+	EXPECT_EQ(MsvTimestampElapsed(0, 1000).count(), 1000);
+}
@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include "mheaders/MsvCompiler.h"
+#include "../msverror.h"
 MSV_DISABLE_ALL_WARNINGS
 
 #include "gtest/gtest.h"
@@ -38,7 +38,20 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 #define MARSTECH_ERROR_H
 
 
+#if defined(__has_include)
+#if __has_include("mheaders/MsvCompiler.h")
 #include "mheaders/MsvCompiler.h"
+#endif
+#else
+#include "mheaders/MsvCompiler.h"
+#endif
+
+#ifndef MSV_DISABLE_ALL_WARNINGS
+//MarsTech Headers are not available - warnings are not disabled for system headers
+#define MSV_DISABLE_ALL_WARNINGS
+#define MSV_ENABLE_WARNINGS
+#endif
+
 MSV_DISABLE_ALL_WARNINGS
 
 #include <cstdint>
@@ -49,10 +62,13 @@ MSV_ENABLE_WARNINGS
 /**************************************************************************************************//**
 * @brief			MarsTech ErrorCode type.
 * @details		Typedef from int32_t. It is 4-byte type (DWORD) and its two highest bits is severity.
+*					Optional facility (owning module) is stored in bits 27-16 and error code number in bits 15-0
+*					(bits 29-28 are reserved and zero). MarsTech error codes are from facility 0.
 * @see			MsvSuccessMask
 * @see			MsvInfoMask
 * @see			MsvWarnMask
 * @see			MsvErrorMask
+* @see			MsvMakeErrorCode
 ******************************************************************************************************/
 typedef int32_t MsvErrorCode;
 
@@ -86,6 +102,219 @@ MsvErrorCode const MsvWarnMask = 0x80000000;
 MsvErrorCode const MsvErrorMask = 0xC0000000;
 
 
+/**************************************************************************************************//**
+* @brief			Facility mask.
+* @details		Bits of facility (owning module) in errorcode (MsvErrorCode & MsvFacilityMask).
+* @see			MsvErrorCodeFacility
+******************************************************************************************************/
+MsvErrorCode const MsvFacilityMask = 0x0FFF0000;
+
+/**************************************************************************************************//**
+* @brief			Facility shift.
+* @details		Position of the lowest facility bit in errorcode.
+******************************************************************************************************/
+uint32_t const MsvFacilityShift = 16;
+
+/**************************************************************************************************//**
+* @brief			Facility count.
+* @details		Count of facilities (12 bits) - tables indexed by @ref MsvErrorCodeFacility have this size.
+******************************************************************************************************/
+uint32_t const MsvFacilityCount = 0x1000;
+
+/**************************************************************************************************//**
+* @brief			Error code number mask.
+* @details		Bits of error code number (unique within severity and facility) in errorcode.
+* @see			MsvErrorCodeNumber
+******************************************************************************************************/
+MsvErrorCode const MsvNumberMask = 0x0000FFFF;
+
+/**************************************************************************************************//**
+* @brief			MarsTech facility.
+* @details		Facility of MarsTech error codes (msverrorcodes.h) and of error codes without facility.
+******************************************************************************************************/
+uint32_t const MsvMarsTechFacility = 0;
+
+
+/**************************************************************************************************//**
+* @brief			Make errorcode.
+* @details		Composes errorcode from severity, facility and error code number (like HRESULT). Facility and
+*					number are truncated to their bit widths (facility 0-4095, number 0-65535).
+* @param[in]	severityMask		Severity mask (@ref MsvSuccessMask, @ref MsvInfoMask, @ref MsvWarnMask or
+*										@ref MsvErrorMask).
+* @param[in]	facility				Facility (owning module).
+* @param[in]	number				Error code number (unique within severity and facility).
+* @returns		MsvErrorCode		Composed errorcode.
+* @see			MsvErrorCodeSeverity
+* @see			MsvErrorCodeFacility
+* @see			MsvErrorCodeNumber
+******************************************************************************************************/
+constexpr MsvErrorCode MsvMakeErrorCode(MsvErrorCode severityMask, uint32_t facility, uint32_t number) noexcept
+{
+	return static_cast<MsvErrorCode>((static_cast<uint32_t>(severityMask) & 0xC0000000u) | ((facility << MsvFacilityShift) & static_cast<uint32_t>(MsvFacilityMask)) | (number & static_cast<uint32_t>(MsvNumberMask)));
+}
+
+/**************************************************************************************************//**
+* @brief			Get error code severity.
+* @param[in]	errorCode		The errorcode.
+* @returns		uint32_t			Severity (0 - success, 1 - info, 2 - warning, 3 - error).
+******************************************************************************************************/
+constexpr uint32_t MsvErrorCodeSeverity(MsvErrorCode errorCode) noexcept
+{
+	return static_cast<uint32_t>(errorCode) >> 30;
+}
+
+/**************************************************************************************************//**
+* @brief			Get error code index.
+* @details		Returns error code without severity bits. It is used as index to per severity tables.
+* @param[in]	errorCode		The errorcode.
+* @returns		uint32_t			Error code without severity.
+******************************************************************************************************/
+constexpr uint32_t MsvErrorCodeIndex(MsvErrorCode errorCode) noexcept
+{
+	return static_cast<uint32_t>(errorCode) & 0x3FFFFFFF;
+}
+
+
+/**************************************************************************************************//**
+* @brief			Get error code facility.
+* @details		Facility can be used as direct index to per facility tables (see @ref MsvFacilityCount).
+* @param[in]	errorCode		The errorcode.
+* @returns		uint32_t			Facility (owning module) of errorcode.
+******************************************************************************************************/
+constexpr uint32_t MsvErrorCodeFacility(MsvErrorCode errorCode) noexcept
+{
+	return (static_cast<uint32_t>(errorCode) & static_cast<uint32_t>(MsvFacilityMask)) >> MsvFacilityShift;
+}
+
+/**************************************************************************************************//**
+* @brief			Get error code number.
+* @param[in]	errorCode		The errorcode.
+* @returns		uint32_t			Error code number (without severity and facility).
+******************************************************************************************************/
+constexpr uint32_t MsvErrorCodeNumber(MsvErrorCode errorCode) noexcept
+{
+	return static_cast<uint32_t>(errorCode) & static_cast<uint32_t>(MsvNumberMask);
+}
+
+
+#ifndef MSV_NO_BRANCH_HINTS
+#if defined(__GNUC__) || defined(__clang__)
+/**************************************************************************************************//**
+* @def			MSV_LIKELY(condition)
+* @brief			Likely condition.
+* @details		Tells compiler the condition is usually true (hot path). It is used by MarsTech Error macros
+*					for success branches. Define MSV_NO_BRANCH_HINTS to disable branch hints.
+* @param[in]	condition		The condition.
+* @see			MSV_UNLIKELY
+******************************************************************************************************/
+#define MSV_LIKELY(condition) __builtin_expect(!!(condition), 1)
+
+/**************************************************************************************************//**
+* @def			MSV_UNLIKELY(condition)
+* @brief			Unlikely condition.
+* @details		Tells compiler the condition is usually false - the branch is moved out of the hot path (GCC
+*					places such blocks to the cold section). It is used by MarsTech Error macros for failure
+*					branches. Define MSV_NO_BRANCH_HINTS to disable branch hints.
+* @param[in]	condition		The condition.
+* @see			MSV_LIKELY
+* @see			MSV_UNLIKELY_BRANCH
+******************************************************************************************************/
+#define MSV_UNLIKELY(condition) __builtin_expect(!!(condition), 0)
+#endif
+
+#if defined(__has_cpp_attribute)
+#if __has_cpp_attribute(unlikely) && __cplusplus >= 202002L
+/**************************************************************************************************//**
+* @def			MSV_UNLIKELY_BRANCH
+* @brief			Unlikely branch attribute.
+* @details		C++20 [[unlikely]] attribute placed after condition of failure branches (it is empty for older
+*					standards). Define MSV_NO_BRANCH_HINTS to disable branch hints.
+* @see			MSV_UNLIKELY
+******************************************************************************************************/
+#define MSV_UNLIKELY_BRANCH [[unlikely]]
+#endif
+#endif
+#endif // !MSV_NO_BRANCH_HINTS
+
+#ifndef MSV_LIKELY
+#define MSV_LIKELY(condition) (condition)
+#define MSV_UNLIKELY(condition) (condition)
+#endif
+
+#ifndef MSV_UNLIKELY_BRANCH
+#define MSV_UNLIKELY_BRANCH
+#endif
+
+#if defined(_MSC_VER)
+/**************************************************************************************************//**
+* @def			MSV_NOINLINE
+* @brief			Never inline function.
+* @details		Keeps function out of its callers (cold paths, stack walking).
+******************************************************************************************************/
+#define MSV_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__) || defined(__clang__)
+#define MSV_NOINLINE __attribute__((noinline))
+#else
+#define MSV_NOINLINE
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+/**************************************************************************************************//**
+* @def			MSV_COLD
+* @brief			Cold function.
+* @details		Tells compiler the function is rarely called - it is optimized for size and placed to the cold
+*					section (.text.unlikely), callers treat paths to it as unlikely. It is empty for MSVC.
+******************************************************************************************************/
+#define MSV_COLD __attribute__((cold))
+#else
+#define MSV_COLD
+#endif
+
+
+#ifdef MSV_ERROR_COUNTERS
+/**************************************************************************************************//**
+* @def			MSV_ERROR_COUNTERS_HOOK(msvErrorCode)
+* @brief			Count errorcode.
+* @details		Increments counter of errorcode (see @ref MsvErrorCounters). Counters are enabled by defining
+*					MSV_ERROR_COUNTERS (it must be same in all translation units), otherwise it is empty.
+* @param[in]	msvErrorCode		The errorcode to count.
+******************************************************************************************************/
+#define MSV_ERROR_COUNTERS_HOOK(msvErrorCode) MsvErrorCounters::Increment(msvErrorCode);
+#else
+#define MSV_ERROR_COUNTERS_HOOK(msvErrorCode)
+#endif // MSV_ERROR_COUNTERS
+
+#ifdef MSV_FLIGHT_RECORDER
+/**************************************************************************************************//**
+* @def			MSV_FLIGHT_RECORDER_HOOK(msvErrorCode, fileName, line)
+* @brief			Record errorcode.
+* @details		Records errorcode to flight recorder of current thread (see @ref MsvFlightRecorder). Flight
+*					recorder is enabled by defining MSV_FLIGHT_RECORDER (it must be same in all translation units),
+*					otherwise it is empty.
+* @param[in]	msvErrorCode		The errorcode to record.
+* @param[in]	fileName				Filename where errorcode has been produced.
+* @param[in]	line					Line number where errorcode has been produced.
+******************************************************************************************************/
+#define MSV_FLIGHT_RECORDER_HOOK(msvErrorCode, fileName, line) MsvFlightRecorder::Record(msvErrorCode, fileName, line);
+#else
+#define MSV_FLIGHT_RECORDER_HOOK(msvErrorCode, fileName, line)
+#endif // MSV_FLIGHT_RECORDER
+
+/**************************************************************************************************//**
+* @def			MSV_ERROR_HOOK(msvErrorCode, fileName, line)
+* @brief			Error instrumentation hook.
+* @details		Called by failure branches of propagation macros (@ref MSV_RETURN_FAILED, @ref MSV_TRY) and by
+*					@ref MsvException (@ref MSV_THROW, @ref MSV_THROW_FAILED, @ref MSV_RETHROW). It compiles to
+*					nothing when no instrumentation is enabled.
+* @param[in]	msvErrorCode		The errorcode.
+* @param[in]	fileName				Filename where errorcode has been produced.
+* @param[in]	line					Line number where errorcode has been produced.
+* @see			MSV_ERROR_COUNTERS_HOOK
+* @see			MSV_FLIGHT_RECORDER_HOOK
+******************************************************************************************************/
+#define MSV_ERROR_HOOK(msvErrorCode, fileName, line) MSV_ERROR_COUNTERS_HOOK(msvErrorCode) MSV_FLIGHT_RECORDER_HOOK(msvErrorCode, fileName, line)
+
+
 /**************************************************************************************************//**
 * @def			MSV_IS_SUCCESS(checkErrorCode)
 * @brief			Check success errorcode.
@@ -96,7 +325,7 @@ MsvErrorCode const MsvErrorMask = 0xC0000000;
 * @see			MsvErrorCode
 * @see			MsvSuccessMask
 ******************************************************************************************************/
-#define MSV_IS_SUCCESS(checkErrorCode) (((checkErrorCode) & 0xC0000000) == MsvSuccessMask)
+#define MSV_IS_SUCCESS(checkErrorCode) ((static_cast<uint32_t>(checkErrorCode) & 0xC0000000u) == static_cast<uint32_t>(MsvSuccessMask))
 
 /**************************************************************************************************//**
 * @def			MSV_IS_INFO(checkErrorCode)
@@ -108,7 +337,7 @@ MsvErrorCode const MsvErrorMask = 0xC0000000;
 * @see			MsvErrorCode
 * @see			MsvInfoMask
 ******************************************************************************************************/
-#define MSV_IS_INFO(checkErrorCode) (((checkErrorCode) & 0xC0000000) == MsvInfoMask)
+#define MSV_IS_INFO(checkErrorCode) ((static_cast<uint32_t>(checkErrorCode) & 0xC0000000u) == static_cast<uint32_t>(MsvInfoMask))
 
 /**************************************************************************************************//**
 * @def			MSV_IS_WARN(checkErrorCode)
@@ -120,7 +349,7 @@ MsvErrorCode const MsvErrorMask = 0xC0000000;
 * @see			MsvErrorCode
 * @see			MsvWarnMask
 ******************************************************************************************************/
-#define MSV_IS_WARN(checkErrorCode) (((checkErrorCode) & 0xC0000000) == MsvWarnMask)
+#define MSV_IS_WARN(checkErrorCode) ((static_cast<uint32_t>(checkErrorCode) & 0xC0000000u) == static_cast<uint32_t>(MsvWarnMask))
 
 /**************************************************************************************************//**
 * @def			MSV_IS_WARN(checkErrorCode)
@@ -132,7 +361,7 @@ MsvErrorCode const MsvErrorMask = 0xC0000000;
 * @see			MsvErrorCode
 * @see			MsvErrorMask
 ******************************************************************************************************/
-#define MSV_IS_ERROR(checkErrorCode) (((checkErrorCode) & 0xC0000000) == MsvErrorMask)
+#define MSV_IS_ERROR(checkErrorCode) ((static_cast<uint32_t>(checkErrorCode) & 0xC0000000u) == static_cast<uint32_t>(MsvErrorMask))
 
 
 /**************************************************************************************************//**
@@ -167,12 +396,13 @@ MsvErrorCode const MsvErrorMask = 0xC0000000;
 * @param[in]	checkErrorCode		The errorcode to check.
 * @see			MsvErrorCode
 * @see			MSV_FAILED
+* @see			MSV_UNLIKELY
 * @warning		Ends current function/method if failed errorcode is received.
 ******************************************************************************************************/
 #define MSV_RETURN_FAILED(checkErrorCode) \
 { \
 	MsvErrorCode msvErrRF = (checkErrorCode); \
-	if (MSV_FAILED(msvErrRF)) { return msvErrRF; } \
+	if (MSV_UNLIKELY(MSV_FAILED(msvErrRF))) MSV_UNLIKELY_BRANCH { MSV_ERROR_HOOK(msvErrRF, __FILE__, __LINE__) return msvErrRF; } \
 }
 
 /**************************************************************************************************//**
@@ -182,9 +412,10 @@ MsvErrorCode const MsvErrorMask = 0xC0000000;
 * @param[in]	checkErrorCode		The errorcode to check.
 * @see			MsvErrorCode
 * @see			MSV_FAILED
+* @see			MSV_UNLIKELY
 * @warning		Ends current loop if failed errorcode is received.
 ******************************************************************************************************/
-#define MSV_BREAK_FAILED(checkErrorCode) if (MSV_FAILED(checkErrorCode)) { break; }
+#define MSV_BREAK_FAILED(checkErrorCode) if (MSV_UNLIKELY(MSV_FAILED(checkErrorCode))) MSV_UNLIKELY_BRANCH { break; }
 
 /**************************************************************************************************//**
 * @def			MSV_CONTINUE_FAILED(checkErrorCode)
@@ -194,10 +425,19 @@ MsvErrorCode const MsvErrorMask = 0xC0000000;
 * @param[in]	checkErrorCode		The errorcode to check.
 * @see			MsvErrorCode
 * @see			MSV_FAILED
+* @see			MSV_UNLIKELY
 * @warning		Invokes continue of current loop if failed errorcode is received.
 ******************************************************************************************************/
-#define MSV_CONTINUE_FAILED(checkErrorCode) if (MSV_FAILED(checkErrorCode)) { continue; }
+#define MSV_CONTINUE_FAILED(checkErrorCode) if (MSV_UNLIKELY(MSV_FAILED(checkErrorCode))) MSV_UNLIKELY_BRANCH { continue; }
+
+
+#ifdef MSV_ERROR_COUNTERS
+#include "msverrorcounters.h"
+#endif // MSV_ERROR_COUNTERS
 
+#ifdef MSV_FLIGHT_RECORDER
+#include "msvflightrecorder.h"
+#endif // MSV_FLIGHT_RECORDER
 
 #endif // !MARSTECH_ERROR_H
 
@@ -0,0 +1,726 @@
+/**************************************************************************************************//**
+* @defgroup		MSVERROR MarsTech Error Handling
+* @brief			MarsTech Error
+* @details		Contains implementation and all definitions of MarsTech Error.
+* @copyright	GNU General Public License (GPLv3).
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Error Batch
+* @details		Contains batch classification of error code arrays (SSE2/AVX2 kernels with runtime dispatch).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Error.
+
+MarsTech Error is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Error is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MarsTech Error. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_ERROR_BATCH_H
+#define MARSTECH_ERROR_BATCH_H
+
+
+#include "msverror.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#define MSV_ERROR_BATCH_X86
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+#ifdef MSV_ERROR_BATCH_X86
+#if defined(__GNUC__) || defined(__clang__)
+/**************************************************************************************************//**
+* @def			MSV_ERROR_BATCH_AVX2
+* @brief			AVX2 function attribute.
+* @details		Compiles function for AVX2 without enabling AVX2 for whole translation unit (MSVC does not need
+*					it). Such functions are called only when CPU supports AVX2 (runtime dispatch).
+******************************************************************************************************/
+#define MSV_ERROR_BATCH_AVX2 __attribute__((target("avx2")))
+#else
+#define MSV_ERROR_BATCH_AVX2
+#endif
+#endif
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech error batch instruction set.
+* @details	Instruction set of batch classification kernels.
+******************************************************************************************************/
+enum class MsvErrorBatchIsa
+{
+	Scalar,			///< Portable scalar kernels (the same as loop with MSV_FAILED, MSV_IS_* macros).
+	Sse2,				///< SSE2 kernels (4 error codes per instruction).
+	Avx2				///< AVX2 kernels (8 error codes per instruction).
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech error severity counts.
+* @details	Count of error codes of each severity.
+******************************************************************************************************/
+struct MsvErrorSeverityCounts
+{
+	/**************************************************************************************************//**
+	* @brief		Counts indexed by severity (0 - success, 1 - info, 2 - warning, 3 - error).
+	* @see		MsvErrorCodeSeverity
+	******************************************************************************************************/
+	std::size_t counts[4];
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech error batch kernel.
+* @details	Batch classification of error code arrays for one instruction set. Use @ref MsvErrorBatch which
+*				dispatches to the best supported one.
+* @tparam		Isa		Instruction set.
+******************************************************************************************************/
+template<MsvErrorBatchIsa Isa>
+class MsvErrorBatchKernel;
+
+/**************************************************************************************************//**
+* @brief		MarsTech scalar error batch kernel.
+* @details	Portable fallback and tail processing of SIMD kernels.
+******************************************************************************************************/
+template<>
+class MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Check any failed.
+	* @param[in]	codes		Error codes.
+	* @param[in]	count		Count of error codes.
+	* @retval		true		When some error code failed (@ref MSV_FAILED).
+	* @retval		false		When all error codes succeeded.
+	******************************************************************************************************/
+	static bool AnyFailed(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		for (std::size_t index = 0; index < count; ++index)
+		{
+			if (MSV_FAILED(codes[index]))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Find first failed.
+	* @param[in]	codes		Error codes.
+	* @param[in]	count		Count of error codes.
+	* @returns		std::size_t		Index of the first failed error code or count when all succeeded.
+	******************************************************************************************************/
+	static std::size_t FirstFailed(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		for (std::size_t index = 0; index < count; ++index)
+		{
+			if (MSV_FAILED(codes[index]))
+			{
+				return index;
+			}
+		}
+
+		return count;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Count severities.
+	* @param[in]	codes		Error codes.
+	* @param[in]	count		Count of error codes.
+	* @returns		MsvErrorSeverityCounts		Count of error codes of each severity.
+	******************************************************************************************************/
+	static MsvErrorSeverityCounts CountSeverities(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		//separate counters (no store to load dependency between neighbouring error codes)
+		std::size_t infos = 0;
+		std::size_t warnings = 0;
+		std::size_t errors = 0;
+		for (std::size_t index = 0; index < count; ++index)
+		{
+			uint32_t severity = MsvErrorCodeSeverity(codes[index]);
+			infos += severity == 1;
+			warnings += severity == 2;
+			errors += severity == 3;
+		}
+
+		MsvErrorSeverityCounts counts = { { count - infos - warnings - errors, infos, warnings, errors } };
+
+		return counts;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get max severity.
+	* @param[in]	codes		Error codes.
+	* @param[in]	count		Count of error codes.
+	* @returns		uint32_t		The worst severity (0 - success, 1 - info, 2 - warning, 3 - error), 0 for no codes.
+	******************************************************************************************************/
+	static uint32_t MaxSeverity(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		uint32_t severity = 0;
+		for (std::size_t index = 0; index < count && severity < 3; ++index)
+		{
+			if (MsvErrorCodeSeverity(codes[index]) > severity)
+			{
+				severity = MsvErrorCodeSeverity(codes[index]);
+			}
+		}
+
+		return severity;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get lowest bit.
+	* @param[in]	mask		Not zero mask.
+	* @returns		std::size_t		Index of the lowest set bit.
+	******************************************************************************************************/
+	static std::size_t LowestBit(uint32_t mask) noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<std::size_t>(__builtin_ctz(mask));
+#elif defined(_MSC_VER)
+		unsigned long index = 0;
+		_BitScanForward(&index, mask);
+
+		return index;
+#else
+		std::size_t index = 0;
+		for (; !(mask & 1); mask >>= 1, ++index) {}
+
+		return index;
+#endif
+	}
+};
+
+
+#ifdef MSV_ERROR_BATCH_X86
+/**************************************************************************************************//**
+* @brief		MarsTech SSE2 error batch kernel.
+* @details	Classifies 4 error codes per instruction (16 per loop iteration). SSE2 is baseline of x86-64.
+* @see			MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>
+******************************************************************************************************/
+template<>
+class MsvErrorBatchKernel<MsvErrorBatchIsa::Sse2>
+{
+public:
+	/**************************************************************************************************//**
+	* @copydoc		MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::AnyFailed
+	******************************************************************************************************/
+	static bool AnyFailed(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		return FirstFailed(codes, count) != count;
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc		MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::FirstFailed
+	******************************************************************************************************/
+	static std::size_t FirstFailed(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		std::size_t index = 0;
+		for (; index + 16 <= count; index += 16)
+		{
+			__m128i any = _mm_or_si128(_mm_or_si128(Load(codes + index), Load(codes + index + 4)), _mm_or_si128(Load(codes + index + 8), Load(codes + index + 12)));
+			if (SignMask(any))
+			{
+				break;
+			}
+		}
+
+		for (; index + 4 <= count; index += 4)
+		{
+			if (uint32_t mask = SignMask(Load(codes + index)))
+			{
+				return index + MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::LowestBit(mask);
+			}
+		}
+
+		return index + MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::FirstFailed(codes + index, count - index);
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc		MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::CountSeverities
+	******************************************************************************************************/
+	static MsvErrorSeverityCounts CountSeverities(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		MsvErrorSeverityCounts counts = { { 0, 0, 0, 0 } };
+		std::size_t index = 0;
+
+		while (index + 4 <= count)
+		{
+			//32 bit lane counters are flushed before they could overflow
+			std::size_t end = count - index > (std::size_t(1) << 20) ? index + (std::size_t(1) << 20) : count;
+			__m128i infos = _mm_setzero_si128();
+			__m128i warnings = _mm_setzero_si128();
+			__m128i errors = _mm_setzero_si128();
+
+			for (; index + 4 <= end; index += 4)
+			{
+				__m128i severity = _mm_srli_epi32(Load(codes + index), 30);
+				infos = _mm_sub_epi32(infos, _mm_cmpeq_epi32(severity, _mm_set1_epi32(1)));
+				warnings = _mm_sub_epi32(warnings, _mm_cmpeq_epi32(severity, _mm_set1_epi32(2)));
+				errors = _mm_sub_epi32(errors, _mm_cmpeq_epi32(severity, _mm_set1_epi32(3)));
+			}
+
+			counts.counts[1] += Sum(infos);
+			counts.counts[2] += Sum(warnings);
+			counts.counts[3] += Sum(errors);
+		}
+
+		counts.counts[0] = index - counts.counts[1] - counts.counts[2] - counts.counts[3];
+
+		MsvErrorSeverityCounts tail = MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::CountSeverities(codes + index, count - index);
+		for (std::size_t severity = 0; severity < 4; ++severity)
+		{
+			counts.counts[severity] += tail.counts[severity];
+		}
+
+		return counts;
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc		MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::MaxSeverity
+	* @details		Severity bits are ORed - error (both bits in one code) ends the scan.
+	******************************************************************************************************/
+	static uint32_t MaxSeverity(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		__m128i any = _mm_setzero_si128();
+		std::size_t index = 0;
+
+		for (; index + 16 <= count; index += 16)
+		{
+			__m128i first = Load(codes + index);
+			__m128i second = Load(codes + index + 4);
+			__m128i third = Load(codes + index + 8);
+			__m128i fourth = Load(codes + index + 12);
+
+			__m128i errors = _mm_or_si128(_mm_or_si128(ErrorBit(first), ErrorBit(second)), _mm_or_si128(ErrorBit(third), ErrorBit(fourth)));
+			if (SignMask(errors))
+			{
+				return 3;
+			}
+
+			any = _mm_or_si128(any, _mm_or_si128(_mm_or_si128(first, second), _mm_or_si128(third, fourth)));
+		}
+
+		for (; index + 4 <= count; index += 4)
+		{
+			__m128i value = Load(codes + index);
+			if (SignMask(ErrorBit(value)))
+			{
+				return 3;
+			}
+
+			any = _mm_or_si128(any, value);
+		}
+
+		uint32_t severity = SignMask(any) ? 2 : SignMask(_mm_slli_epi32(any, 1)) ? 1 : 0;
+		uint32_t tail = MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::MaxSeverity(codes + index, count - index);
+
+		return tail > severity ? tail : severity;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Load 4 error codes (unaligned).
+	******************************************************************************************************/
+	static __m128i Load(const MsvErrorCode* codes) noexcept
+	{
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(codes));
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get sign bits (failed error codes) of 4 lanes.
+	******************************************************************************************************/
+	static uint32_t SignMask(__m128i value) noexcept
+	{
+		return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(value)));
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get sign bit set for error severity lanes (both severity bits set).
+	******************************************************************************************************/
+	static __m128i ErrorBit(__m128i value) noexcept
+	{
+		return _mm_and_si128(value, _mm_slli_epi32(value, 1));
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Sum 4 lane counters.
+	******************************************************************************************************/
+	static std::size_t Sum(__m128i value) noexcept
+	{
+		alignas(16) uint32_t lanes[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), value);
+
+		return std::size_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+	}
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech AVX2 error batch kernel.
+* @details	Classifies 8 error codes per instruction (32 per loop iteration). It must be used only when CPU
+*				supports AVX2 (see @ref MsvErrorBatch::GetIsa).
+* @see			MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>
+******************************************************************************************************/
+template<>
+class MsvErrorBatchKernel<MsvErrorBatchIsa::Avx2>
+{
+public:
+	/**************************************************************************************************//**
+	* @copydoc		MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::AnyFailed
+	******************************************************************************************************/
+	MSV_ERROR_BATCH_AVX2 static bool AnyFailed(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		return FirstFailed(codes, count) != count;
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc		MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::FirstFailed
+	******************************************************************************************************/
+	MSV_ERROR_BATCH_AVX2 static std::size_t FirstFailed(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		std::size_t index = 0;
+		for (; index + 32 <= count; index += 32)
+		{
+			__m256i any = _mm256_or_si256(_mm256_or_si256(Load(codes + index), Load(codes + index + 8)), _mm256_or_si256(Load(codes + index + 16), Load(codes + index + 24)));
+			if (SignMask(any))
+			{
+				break;
+			}
+		}
+
+		for (; index + 8 <= count; index += 8)
+		{
+			if (uint32_t mask = SignMask(Load(codes + index)))
+			{
+				return index + MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::LowestBit(mask);
+			}
+		}
+
+		return index + MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::FirstFailed(codes + index, count - index);
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc		MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::CountSeverities
+	******************************************************************************************************/
+	MSV_ERROR_BATCH_AVX2 static MsvErrorSeverityCounts CountSeverities(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		MsvErrorSeverityCounts counts = { { 0, 0, 0, 0 } };
+		std::size_t index = 0;
+
+		while (index + 8 <= count)
+		{
+			//32 bit lane counters are flushed before they could overflow
+			std::size_t end = count - index > (std::size_t(1) << 20) ? index + (std::size_t(1) << 20) : count;
+			__m256i infos = _mm256_setzero_si256();
+			__m256i warnings = _mm256_setzero_si256();
+			__m256i errors = _mm256_setzero_si256();
+
+			for (; index + 8 <= end; index += 8)
+			{
+				__m256i severity = _mm256_srli_epi32(Load(codes + index), 30);
+				infos = _mm256_sub_epi32(infos, _mm256_cmpeq_epi32(severity, _mm256_set1_epi32(1)));
+				warnings = _mm256_sub_epi32(warnings, _mm256_cmpeq_epi32(severity, _mm256_set1_epi32(2)));
+				errors = _mm256_sub_epi32(errors, _mm256_cmpeq_epi32(severity, _mm256_set1_epi32(3)));
+			}
+
+			counts.counts[1] += Sum(infos);
+			counts.counts[2] += Sum(warnings);
+			counts.counts[3] += Sum(errors);
+		}
+
+		counts.counts[0] = index - counts.counts[1] - counts.counts[2] - counts.counts[3];
+
+		MsvErrorSeverityCounts tail = MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::CountSeverities(codes + index, count - index);
+		for (std::size_t severity = 0; severity < 4; ++severity)
+		{
+			counts.counts[severity] += tail.counts[severity];
+		}
+
+		return counts;
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc		MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::MaxSeverity
+	* @details		Severity bits are ORed - error (both bits in one code) ends the scan.
+	******************************************************************************************************/
+	MSV_ERROR_BATCH_AVX2 static uint32_t MaxSeverity(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		__m256i any = _mm256_setzero_si256();
+		std::size_t index = 0;
+
+		for (; index + 32 <= count; index += 32)
+		{
+			__m256i first = Load(codes + index);
+			__m256i second = Load(codes + index + 8);
+			__m256i third = Load(codes + index + 16);
+			__m256i fourth = Load(codes + index + 24);
+
+			__m256i errors = _mm256_or_si256(_mm256_or_si256(ErrorBit(first), ErrorBit(second)), _mm256_or_si256(ErrorBit(third), ErrorBit(fourth)));
+			if (SignMask(errors))
+			{
+				return 3;
+			}
+
+			any = _mm256_or_si256(any, _mm256_or_si256(_mm256_or_si256(first, second), _mm256_or_si256(third, fourth)));
+		}
+
+		for (; index + 8 <= count; index += 8)
+		{
+			__m256i value = Load(codes + index);
+			if (SignMask(ErrorBit(value)))
+			{
+				return 3;
+			}
+
+			any = _mm256_or_si256(any, value);
+		}
+
+		uint32_t severity = SignMask(any) ? 2 : SignMask(_mm256_slli_epi32(any, 1)) ? 1 : 0;
+		uint32_t tail = MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::MaxSeverity(codes + index, count - index);
+
+		return tail > severity ? tail : severity;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Load 8 error codes (unaligned).
+	******************************************************************************************************/
+	MSV_ERROR_BATCH_AVX2 static __m256i Load(const MsvErrorCode* codes) noexcept
+	{
+		return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes));
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get sign bits (failed error codes) of 8 lanes.
+	******************************************************************************************************/
+	MSV_ERROR_BATCH_AVX2 static uint32_t SignMask(__m256i value) noexcept
+	{
+		return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(value)));
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get sign bit set for error severity lanes (both severity bits set).
+	******************************************************************************************************/
+	MSV_ERROR_BATCH_AVX2 static __m256i ErrorBit(__m256i value) noexcept
+	{
+		return _mm256_and_si256(value, _mm256_slli_epi32(value, 1));
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Sum 8 lane counters.
+	******************************************************************************************************/
+	MSV_ERROR_BATCH_AVX2 static std::size_t Sum(__m256i value) noexcept
+	{
+		alignas(32) uint32_t lanes[8];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), value);
+
+		return std::size_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+	}
+};
+#endif // MSV_ERROR_BATCH_X86
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech error batch.
+* @details	Batch classification of error code arrays (for example one error code per item of executed
+*				batch). Each call dispatches to the best kernel supported by CPU (detected once).
+* @note		Container overloads take any contiguous container with data() and size() (std::vector,
+*				std::array, std::span).
+******************************************************************************************************/
+class MsvErrorBatch
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Get instruction set.
+	* @details		Detects the best instruction set supported by CPU (and operating system) once.
+	* @returns		MsvErrorBatchIsa		Instruction set used by batch functions.
+	******************************************************************************************************/
+	static MsvErrorBatchIsa GetIsa() noexcept
+	{
+		static const MsvErrorBatchIsa isa = DetectIsa();
+
+		return isa;
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc		MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::AnyFailed
+	******************************************************************************************************/
+	static bool AnyFailed(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		switch (GetIsa())
+		{
+#ifdef MSV_ERROR_BATCH_X86
+		case MsvErrorBatchIsa::Avx2:
+			return MsvErrorBatchKernel<MsvErrorBatchIsa::Avx2>::AnyFailed(codes, count);
+		case MsvErrorBatchIsa::Sse2:
+			return MsvErrorBatchKernel<MsvErrorBatchIsa::Sse2>::AnyFailed(codes, count);
+#endif
+		default:
+			return MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::AnyFailed(codes, count);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc		MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::FirstFailed
+	******************************************************************************************************/
+	static std::size_t FirstFailed(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		switch (GetIsa())
+		{
+#ifdef MSV_ERROR_BATCH_X86
+		case MsvErrorBatchIsa::Avx2:
+			return MsvErrorBatchKernel<MsvErrorBatchIsa::Avx2>::FirstFailed(codes, count);
+		case MsvErrorBatchIsa::Sse2:
+			return MsvErrorBatchKernel<MsvErrorBatchIsa::Sse2>::FirstFailed(codes, count);
+#endif
+		default:
+			return MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::FirstFailed(codes, count);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc		MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::CountSeverities
+	******************************************************************************************************/
+	static MsvErrorSeverityCounts CountSeverities(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		switch (GetIsa())
+		{
+#ifdef MSV_ERROR_BATCH_X86
+		case MsvErrorBatchIsa::Avx2:
+			return MsvErrorBatchKernel<MsvErrorBatchIsa::Avx2>::CountSeverities(codes, count);
+		case MsvErrorBatchIsa::Sse2:
+			return MsvErrorBatchKernel<MsvErrorBatchIsa::Sse2>::CountSeverities(codes, count);
+#endif
+		default:
+			return MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::CountSeverities(codes, count);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc		MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::MaxSeverity
+	******************************************************************************************************/
+	static uint32_t MaxSeverity(const MsvErrorCode* codes, std::size_t count) noexcept
+	{
+		switch (GetIsa())
+		{
+#ifdef MSV_ERROR_BATCH_X86
+		case MsvErrorBatchIsa::Avx2:
+			return MsvErrorBatchKernel<MsvErrorBatchIsa::Avx2>::MaxSeverity(codes, count);
+		case MsvErrorBatchIsa::Sse2:
+			return MsvErrorBatchKernel<MsvErrorBatchIsa::Sse2>::MaxSeverity(codes, count);
+#endif
+		default:
+			return MsvErrorBatchKernel<MsvErrorBatchIsa::Scalar>::MaxSeverity(codes, count);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Check any failed (container overload).
+	* @see			AnyFailed(const MsvErrorCode*, std::size_t)
+	******************************************************************************************************/
+	template<class Codes>
+	static bool AnyFailed(const Codes& codes) noexcept
+	{
+		return AnyFailed(codes.data(), codes.size());
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Find first failed (container overload).
+	* @see			FirstFailed(const MsvErrorCode*, std::size_t)
+	******************************************************************************************************/
+	template<class Codes>
+	static std::size_t FirstFailed(const Codes& codes) noexcept
+	{
+		return FirstFailed(codes.data(), codes.size());
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Count severities (container overload).
+	* @see			CountSeverities(const MsvErrorCode*, std::size_t)
+	******************************************************************************************************/
+	template<class Codes>
+	static MsvErrorSeverityCounts CountSeverities(const Codes& codes) noexcept
+	{
+		return CountSeverities(codes.data(), codes.size());
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get max severity (container overload).
+	* @see			MaxSeverity(const MsvErrorCode*, std::size_t)
+	******************************************************************************************************/
+	template<class Codes>
+	static uint32_t MaxSeverity(const Codes& codes) noexcept
+	{
+		return MaxSeverity(codes.data(), codes.size());
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Detect instruction set.
+	* @returns		MsvErrorBatchIsa		The best instruction set supported by CPU and operating system.
+	******************************************************************************************************/
+	static MsvErrorBatchIsa DetectIsa() noexcept
+	{
+#if defined(MSV_ERROR_BATCH_X86) && (defined(__GNUC__) || defined(__clang__))
+		__builtin_cpu_init();
+
+		return __builtin_cpu_supports("avx2") ? MsvErrorBatchIsa::Avx2 : MsvErrorBatchIsa::Sse2;
+#elif defined(MSV_ERROR_BATCH_X86) && defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+		{
+			return MsvErrorBatchIsa::Sse2;
+		}
+
+		//OSXSAVE and AVX, operating system saves YMM registers
+		__cpuid(info, 1);
+		if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+		{
+			return MsvErrorBatchIsa::Sse2;
+		}
+
+		__cpuidex(info, 7, 0);
+
+		return (info[1] & (1 << 5)) ? MsvErrorBatchIsa::Avx2 : MsvErrorBatchIsa::Sse2;
+#else
+		return MsvErrorBatchIsa::Scalar;
+#endif
+	}
+};
+
+
+#endif // !MARSTECH_ERROR_BATCH_H
+
+/** @} */	//End of group MPLS.
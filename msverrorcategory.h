@@ -0,0 +1,224 @@
+/**************************************************************************************************//**
+* @defgroup		MSVERROR MarsTech Error Handling
+* @brief			MarsTech Error
+* @details		Contains implementation and all definitions of MarsTech Error.
+* @copyright	GNU General Public License (GPLv3).
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Error Category
+* @details		Contains std::error_category of MarsTech error codes and conversions to/from std::error_code.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Error.
+
+MarsTech Error is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Error is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MarsTech Error. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_ERROR_CATEGORY_H
+#define MARSTECH_ERROR_CATEGORY_H
+
+
+#include "msverrorcodes.h"
+#include "msverrorregistry.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <string>
+#include <system_error>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech error code equivalence.
+* @details	Pair of MarsTech error code and equivalent std::errc.
+* @see		MsvErrorCodeEquivalences
+******************************************************************************************************/
+struct MsvErrorCodeEquivalence
+{
+	/**************************************************************************************************//**
+	* @brief		MarsTech error code.
+	******************************************************************************************************/
+	MsvErrorCode errorCode;
+
+	/**************************************************************************************************//**
+	* @brief		Equivalent generic error condition.
+	******************************************************************************************************/
+	std::errc condition;
+};
+
+/**************************************************************************************************//**
+* @brief		MarsTech error code equivalences.
+* @details	MarsTech error codes which are equivalent to std::errc. When more error codes are equivalent to
+*				the same std::errc, the first one is used for conversion from std::error_code.
+* @see		MsvErrorCategory::default_error_condition
+* @see		MsvErrorCodeFromErrorCode
+******************************************************************************************************/
+inline constexpr MsvErrorCodeEquivalence MsvErrorCodeEquivalences[] =
+{
+	{ MSV_ALLOCATION_ERROR,			std::errc::not_enough_memory },
+	{ MSV_NOT_FOUND_ERROR,			std::errc::no_such_file_or_directory },
+	{ MSV_DOES_NOT_EXIST_ERROR,		std::errc::no_such_file_or_directory },
+	{ MSV_ALREADY_EXISTS_ERROR,		std::errc::file_exists },
+	{ MSV_INVALID_DATA_ERROR,		std::errc::invalid_argument },
+	{ MSV_BUSY_ERROR,					std::errc::device_or_resource_busy },
+	{ MSV_NOT_ALLOWED_ERROR,		std::errc::operation_not_permitted },
+	{ MSV_STILL_RUNNING_ERROR,		std::errc::operation_in_progress }
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech error category.
+* @details	Category of std::error_code with MarsTech error code value. Messages are descriptions from
+*				error code registry (static strings - @ref GetDescription does not allocate). Error codes from
+*				@ref MsvErrorCodeEquivalences compare equal to their std::errc.
+* @note		Value of std::error_code is true for all non zero error codes (even for info and warning
+*				codes) - use MSV_FAILED to check failure.
+* @see		MsvGetErrorCategory
+* @see		make_error_code
+******************************************************************************************************/
+class MsvErrorCategory :
+	public std::error_category
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Get category name.
+	* @returns		const char*		Category name.
+	******************************************************************************************************/
+	const char* name() const noexcept override
+	{
+		return "MarsTech";
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get message.
+	* @details		Returns description of error code (see @ref GetDescription).
+	* @param[in]	errorCode		The errorcode.
+	* @returns		std::string		Description of error code.
+	* @note			std::error_category interface requires std::string - use @ref GetDescription to avoid
+	*					the copy.
+	******************************************************************************************************/
+	std::string message(int errorCode) const override
+	{
+		return GetDescription(errorCode);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get default error condition.
+	* @param[in]	errorCode		The errorcode.
+	* @returns		std::error_condition		Generic condition for error codes from @ref MsvErrorCodeEquivalences,
+	*													MarsTech condition otherwise.
+	******************************************************************************************************/
+	std::error_condition default_error_condition(int errorCode) const noexcept override
+	{
+		for (const MsvErrorCodeEquivalence& equivalence : MsvErrorCodeEquivalences)
+		{
+			if (equivalence.errorCode == errorCode)
+			{
+				return std::make_error_condition(equivalence.condition);
+			}
+		}
+
+		return std::error_condition(errorCode, *this);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get description.
+	* @details		Static string - it never allocates.
+	* @param[in]	errorCode		The errorcode.
+	* @returns		const char*		Description of registered error code or generic description of not
+	*										registered error code.
+	******************************************************************************************************/
+	static const char* GetDescription(MsvErrorCode errorCode) noexcept
+	{
+		if (const char* description = MsvErrorCodeDescription(errorCode))
+		{
+			return description;
+		}
+
+		return MSV_FAILED(errorCode) ? "Unknown MarsTech error." : "Unknown MarsTech status.";
+	}
+};
+
+
+/**************************************************************************************************//**
+* @brief			Get MarsTech error category.
+* @returns		const MsvErrorCategory&		The only instance of MarsTech error category.
+******************************************************************************************************/
+inline const MsvErrorCategory& MsvGetErrorCategory() noexcept
+{
+	static const MsvErrorCategory category;
+
+	return category;
+}
+
+/**************************************************************************************************//**
+* @brief			Make error code.
+* @details		Converts MarsTech error code to std::error_code (@ref MsvErrorCategory).
+* @param[in]	errorCode		The errorcode.
+* @returns		std::error_code		Error code with MarsTech category.
+******************************************************************************************************/
+inline std::error_code make_error_code(MsvErrorCode errorCode) noexcept
+{
+	return std::error_code(errorCode, MsvGetErrorCategory());
+}
+
+/**************************************************************************************************//**
+* @brief			Convert std::error_code to MarsTech error code.
+* @details		MarsTech error codes are returned as they are, error codes equivalent to generic error
+*					condition from @ref MsvErrorCodeEquivalences are converted to MarsTech error code.
+* @param[in]	errorCode		The std::error_code.
+* @returns		MsvErrorCode		MSV_SUCCESS for no error, converted errorcode or MSV_UNKNOWN_ERROR when
+*										there is no equivalent MarsTech error code.
+******************************************************************************************************/
+inline MsvErrorCode MsvErrorCodeFromErrorCode(const std::error_code& errorCode) noexcept
+{
+	if (!errorCode)
+	{
+		return MSV_SUCCESS;
+	}
+
+	if (errorCode.category() == MsvGetErrorCategory())
+	{
+		return errorCode.value();
+	}
+
+	std::error_condition condition = errorCode.default_error_condition();
+	if (condition.category() == std::generic_category())
+	{
+		for (const MsvErrorCodeEquivalence& equivalence : MsvErrorCodeEquivalences)
+		{
+			if (static_cast<int>(equivalence.condition) == condition.value())
+			{
+				return equivalence.errorCode;
+			}
+		}
+	}
+
+	return MSV_UNKNOWN_ERROR;
+}
+
+
+#endif // !MARSTECH_ERROR_CATEGORY_H
+
+/** @} */	//End of group MPLS.
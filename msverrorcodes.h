@@ -38,7 +38,55 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 #define MARSTECH_ERROR_CODES_H
 
 
-#include "MsvError.h"
+#include "msverror.h"
+
+
+/**************************************************************************************************//**
+* @def			MSV_ERROR_CODE_LIST(MSV_ERROR_CODE_ENTRY)
+* @brief			List of MarsTech error codes.
+* @details		List of all MarsTech error codes with descriptions. It calls MSV_ERROR_CODE_ENTRY(errorCode,
+*					value, description) for each error code. Error code registry (msverrorregistry.h) is generated
+*					from it. New error code is added here and as documented constant below (static_asserts check
+*					the constants match the list).
+* @param[in]	MSV_ERROR_CODE_ENTRY		Macro called for each error code.
+* @see			MsvErrorCodeName
+* @see			MsvErrorCodeDescription
+******************************************************************************************************/
+#define MSV_ERROR_CODE_LIST(MSV_ERROR_CODE_ENTRY) \
+	/* Success error codes */ \
+	MSV_ERROR_CODE_ENTRY(MSV_SUCCESS, 0x00000000, "Main success errorcode without any added information.") \
+	/* Info error codes */ \
+	MSV_ERROR_CODE_ENTRY(MSV_ALREADY_INITIALIZED_INFO, 0x40000000, "Something has been already initialized.") \
+	MSV_ERROR_CODE_ENTRY(MSV_NOT_INITIALIZED_INFO, 0x40000001, "Something is not initialized.") \
+	MSV_ERROR_CODE_ENTRY(MSV_ALREADY_RUNNING_INFO, 0x40000002, "Something is already running.") \
+	MSV_ERROR_CODE_ENTRY(MSV_NOT_RUNNING_INFO, 0x40000003, "Something is not running.") \
+	MSV_ERROR_CODE_ENTRY(MSV_ALREADY_REQUESTED_INFO, 0x40000004, "Some action has been already requested.") \
+	MSV_ERROR_CODE_ENTRY(MSV_ALREADY_REGISTERED_INFO, 0x40000005, "Something (usually callback) has been already registered.") \
+	MSV_ERROR_CODE_ENTRY(MSV_NOT_REGISTERED_INFO, 0x40000006, "Something (usually callback) is not registered.") \
+	MSV_ERROR_CODE_ENTRY(MSV_ALREADY_SET_INFO, 0x40000007, "Something has been already set.") \
+	MSV_ERROR_CODE_ENTRY(MSV_NOT_SET_INFO, 0x40000008, "Something is not set.") \
+	MSV_ERROR_CODE_ENTRY(MSV_EXPIRED_INFO, 0x40000009, "Something is expired.") \
+	MSV_ERROR_CODE_ENTRY(MSV_NOT_FOUND_INFO, 0x4000000A, "Something has not been found.") \
+	MSV_ERROR_CODE_ENTRY(MSV_ALREADY_EXISTS_INFO, 0x4000000B, "Something already exists.") \
+	/* Warning error codes */ \
+	MSV_ERROR_CODE_ENTRY(MSV_STILL_RUNNING_WARN, 0x80000000, "Something is still running, but it shouldn't.") \
+	/* Error error codes */ \
+	MSV_ERROR_CODE_ENTRY(MSV_ALLOCATION_ERROR, 0xC0000000, "Create (allocate) some memory/object failed.") \
+	MSV_ERROR_CODE_ENTRY(MSV_NOT_INITIALIZED_ERROR, 0xC0000001, "Object must be initialized before doing this action.") \
+	MSV_ERROR_CODE_ENTRY(MSV_NOT_REQUESTED_ERROR, 0xC0000002, "Some action has not been requested, but it should be.") \
+	MSV_ERROR_CODE_ENTRY(MSV_NOT_FOUND_ERROR, 0xC0000003, "Something has not been found.") \
+	MSV_ERROR_CODE_ENTRY(MSV_DOES_NOT_EXIST_ERROR, 0xC0000004, "Something does not exist, but it should.") \
+	MSV_ERROR_CODE_ENTRY(MSV_ALREADY_EXISTS_ERROR, 0xC0000005, "Something already exists, but it shouldn't.") \
+	MSV_ERROR_CODE_ENTRY(MSV_PARSE_ERROR, 0xC0000006, "Parsing data failed.") \
+	/* do not use it as general error - it is meant as unknown object, ID etc. */ \
+	MSV_ERROR_CODE_ENTRY(MSV_UNKNOWN_ERROR, 0xC0000007, "Something is unknown (some object, ID etc.).") \
+	MSV_ERROR_CODE_ENTRY(MSV_INVALID_DATA_ERROR, 0xC0000008, "Some data are invalid (parameters, received data, file, etc.).") \
+	MSV_ERROR_CODE_ENTRY(MSV_OPEN_ERROR, 0xC0000009, "Failed to open anything (file, socket, database, etc.).") \
+	MSV_ERROR_CODE_ENTRY(MSV_CLOSE_ERROR, 0xC000000A, "Failed to close anything (file, socket, database, etc.).") \
+	MSV_ERROR_CODE_ENTRY(MSV_EXECUTE_ERROR, 0xC000000B, "Failed to execute something (action, SQL command, etc.).") \
+	MSV_ERROR_CODE_ENTRY(MSV_BUSY_ERROR, 0xC000000C, "Something is busy and can not perform action.") \
+	MSV_ERROR_CODE_ENTRY(MSV_NOT_ALLOWED_ERROR, 0xC000000D, "Trying to execute or do some action which is not allowed.") \
+	MSV_ERROR_CODE_ENTRY(MSV_STILL_RUNNING_ERROR, 0xC000000E, "Something is still running, but it shouldn't.")
 
 
 /********************************************************************************************************************************
@@ -298,6 +346,14 @@ MsvErrorCode const MSV_NOT_ALLOWED_ERROR				= 0xC000000D;
 MsvErrorCode const MSV_STILL_RUNNING_ERROR			= 0xC000000E;
 
 
+//each error code constant must match MSV_ERROR_CODE_LIST
+#define MSV_ERROR_CODE_CHECK(errorCode, value, description) static_assert(errorCode == static_cast<MsvErrorCode>(value), #errorCode " does not match MSV_ERROR_CODE_LIST.");
+
+MSV_ERROR_CODE_LIST(MSV_ERROR_CODE_CHECK)
+
+#undef MSV_ERROR_CODE_CHECK
+
+
 #endif // !MARSTECH_ERROR_CODES_H
 
 /** @} */	//End of group MPLS.
@@ -0,0 +1,521 @@
+/**************************************************************************************************//**
+* @defgroup		MSVERROR MarsTech Error Handling
+* @brief			MarsTech Error
+* @details		Contains implementation and all definitions of MarsTech Error.
+* @copyright	GNU General Public License (GPLv3).
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Error Collector
+* @details		Contains lock-free collector of failures reported by parallel workers.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Error.
+
+MarsTech Error is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Error is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MarsTech Error. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_ERROR_COLLECTOR_H
+#define MARSTECH_ERROR_COLLECTOR_H
+
+
+#include "msverrorcodes.h"
+#include "msvexception.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech error collector.
+* @details	Aggregates failures of parallel workers (thread pool tasks) without locks:
+*				- first error wins - the first reported failed errorcode (@ref GetFirstError),
+*				- worst severity wins - the first errorcode with the worst severity (@ref GetWorstError),
+*				- bounded capture of all failed errorcodes (@ref ForEachError, the rest is counted as dropped),
+*				- one full @ref MsvException per distinct errorcode (@ref GetException).
+*				Reports are striped - workers write to per thread stripes of errorcodes (cache line each) and shared
+*				state is written only when it changes (the first failure, worse severity, new distinct errorcode),
+*				so reporting scales with count of threads even when most tasks fail.
+* @note		Reporting methods never block, allocate or throw. Succeeded errorcodes are ignored.
+******************************************************************************************************/
+class MsvErrorCollector
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	capacity					Count of captured errorcodes (all failures, the rest is dropped).
+	* @param[in]	exceptionCapacity		Count of distinct errorcodes with stored exceptions.
+	* @throws		std::bad_alloc			When storage can't be allocated.
+	******************************************************************************************************/
+	explicit MsvErrorCollector(std::size_t capacity = 1024, std::size_t exceptionCapacity = 64) :
+		m_firstError(MSV_SUCCESS),
+		m_worstError(MSV_SUCCESS),
+		m_stripeCount(GetStripeCount()),
+		m_stripeCapacity((capacity + m_stripeCount - 1) / m_stripeCount),
+		m_stripes(new Stripe[m_stripeCount]),
+		m_errors(new std::atomic<MsvErrorCode>[m_stripeCount * m_stripeCapacity]),
+		m_exceptionMask(RoundCapacity(exceptionCapacity * 2) - 1),
+		m_exceptionSlots(new ExceptionSlot[m_exceptionMask + 1]),
+		m_exceptionCapacity(exceptionCapacity),
+		m_exceptionCount(0),
+		m_exceptions(new ExceptionStorage[exceptionCapacity])
+	{
+		for (std::size_t index = 0; index < m_stripeCount; ++index)
+		{
+			m_stripes[index].count.store(0, std::memory_order_relaxed);
+			m_stripes[index].dropped.store(0, std::memory_order_relaxed);
+		}
+
+		for (std::size_t index = 0; index < m_stripeCount * m_stripeCapacity; ++index)
+		{
+			m_errors[index].store(MSV_SUCCESS, std::memory_order_relaxed);
+		}
+
+		for (std::size_t index = 0; index <= m_exceptionMask; ++index)
+		{
+			m_exceptionSlots[index].errorCode.store(MSV_SUCCESS, std::memory_order_relaxed);
+			m_exceptionSlots[index].exception.store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	MsvErrorCollector(const MsvErrorCollector&) = delete;
+	MsvErrorCollector& operator=(const MsvErrorCollector&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Destructor.
+	* @details		Destroys stored exceptions. Workers must not report anymore.
+	******************************************************************************************************/
+	~MsvErrorCollector() noexcept
+	{
+		std::size_t count = m_exceptionCount.load(std::memory_order_acquire);
+		for (std::size_t index = 0; index < count && index < m_exceptionCapacity; ++index)
+		{
+			m_exceptions[index].exception.~MsvException();
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Report errorcode.
+	* @details		Updates the first and the worst error and captures errorcode (when there is free space).
+	* @param[in]	errorCode		Result of worker (succeeded errorcodes are ignored).
+	******************************************************************************************************/
+	void Report(MsvErrorCode errorCode) noexcept
+	{
+		if (MSV_SUCCEEDED(errorCode))
+		{
+			return;
+		}
+
+		UpdateFirst(errorCode);
+		UpdateWorst(errorCode);
+		Capture(errorCode);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Report exception.
+	* @details		Reports its errorcode and stores copy of the exception when it is the first one with its
+	*					errorcode (copying @ref MsvException never allocates).
+	* @param[in]	exception		Exception thrown by worker.
+	******************************************************************************************************/
+	void Report(const MsvException& exception) noexcept
+	{
+		MsvErrorCode errorCode = exception.GetErrorCode();
+		if (MSV_SUCCEEDED(errorCode))
+		{
+			return;
+		}
+
+		Report(errorCode);
+		Store(exception);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Check failed.
+	* @retval		true		When some failed errorcode has been reported.
+	* @retval		false		When nothing has failed.
+	******************************************************************************************************/
+	bool Failed() const noexcept
+	{
+		return MSV_FAILED(GetFirstError());
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get first error.
+	* @returns		MsvErrorCode		The first reported failed errorcode or MSV_SUCCESS.
+	******************************************************************************************************/
+	MsvErrorCode GetFirstError() const noexcept
+	{
+		return m_firstError.load(std::memory_order_acquire);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get worst error.
+	* @returns		MsvErrorCode		The first reported errorcode with the worst severity or MSV_SUCCESS.
+	******************************************************************************************************/
+	MsvErrorCode GetWorstError() const noexcept
+	{
+		return m_worstError.load(std::memory_order_acquire);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get error count.
+	* @returns		std::size_t		Count of reported failures (captured and dropped).
+	******************************************************************************************************/
+	std::size_t GetErrorCount() const noexcept
+	{
+		std::size_t count = 0;
+		for (std::size_t index = 0; index < m_stripeCount; ++index)
+		{
+			std::size_t stripeCount = m_stripes[index].count.load(std::memory_order_relaxed);
+			count += (stripeCount < m_stripeCapacity ? stripeCount : m_stripeCapacity) + m_stripes[index].dropped.load(std::memory_order_relaxed);
+		}
+
+		return count;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get dropped count.
+	* @returns		std::size_t		Count of reported failures which have not been captured (no free space).
+	******************************************************************************************************/
+	std::size_t GetDroppedCount() const noexcept
+	{
+		std::size_t count = 0;
+		for (std::size_t index = 0; index < m_stripeCount; ++index)
+		{
+			count += m_stripes[index].dropped.load(std::memory_order_relaxed);
+		}
+
+		return count;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get capacity.
+	* @returns		std::size_t		Count of errorcodes which can be captured.
+	* @note			Capacity is split to per thread stripes - thread continues to other stripes when its own
+	*					one is full.
+	******************************************************************************************************/
+	std::size_t GetCapacity() const noexcept
+	{
+		return m_stripeCount * m_stripeCapacity;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Iterate captured errorcodes.
+	* @details		Calls callback for each captured errorcode (ordered by stripes, in report order within one
+	*					stripe). Errorcodes being captured concurrently may be skipped.
+	* @param[in]	callback		Callable with MsvErrorCode argument.
+	******************************************************************************************************/
+	template<class Callback>
+	void ForEachError(Callback&& callback) const
+	{
+		for (std::size_t stripe = 0; stripe < m_stripeCount; ++stripe)
+		{
+			std::size_t count = m_stripes[stripe].count.load(std::memory_order_acquire);
+			count = count < m_stripeCapacity ? count : m_stripeCapacity;
+
+			for (std::size_t index = 0; index < count; ++index)
+			{
+				MsvErrorCode errorCode = m_errors[stripe * m_stripeCapacity + index].load(std::memory_order_acquire);
+				if (MSV_FAILED(errorCode))
+				{
+					callback(errorCode);
+				}
+			}
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get exception.
+	* @param[in]	errorCode		The errorcode.
+	* @returns		const MsvException*		The first reported exception with errorcode or nullptr when no such
+	*													exception has been stored (yet).
+	* @note			Stored exception is valid for the lifetime of collector and it is never changed.
+	******************************************************************************************************/
+	const MsvException* GetException(MsvErrorCode errorCode) const noexcept
+	{
+		for (std::size_t probe = 0, index = Hash(errorCode); probe <= m_exceptionMask; ++probe, index = (index + 1) & m_exceptionMask)
+		{
+			MsvErrorCode slotCode = m_exceptionSlots[index].errorCode.load(std::memory_order_acquire);
+			if (slotCode == errorCode)
+			{
+				return m_exceptionSlots[index].exception.load(std::memory_order_acquire);
+			}
+
+			if (slotCode == MSV_SUCCESS)
+			{
+				break;
+			}
+		}
+
+		return nullptr;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Stripe of captured errorcodes.
+	* @details	Count of claimed entries (it may exceed stripe capacity when stripe is full) and count of dropped
+	*				errorcodes reported by threads of this stripe. Each stripe has own cache line.
+	******************************************************************************************************/
+	struct alignas(64) Stripe
+	{
+		std::atomic<std::size_t> count;
+		std::atomic<std::size_t> dropped;
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Exception slot.
+	* @details	Open addressing table entry - errorcode is claimed by CAS, exception is published when it has
+	*				been copied to exception storage.
+	******************************************************************************************************/
+	struct ExceptionSlot
+	{
+		std::atomic<MsvErrorCode> errorCode;
+		std::atomic<const MsvException*> exception;
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Exception storage.
+	* @details	Uninitialized storage of one exception (constructed by @ref Store).
+	******************************************************************************************************/
+	struct ExceptionStorage
+	{
+		ExceptionStorage() noexcept {}
+		~ExceptionStorage() noexcept {}
+
+		union
+		{
+			MsvException exception;
+		};
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Get stripe count.
+	* @returns		std::size_t		Power of two not lower than count of hardware threads (1 - 256).
+	******************************************************************************************************/
+	static std::size_t GetStripeCount() noexcept
+	{
+		std::size_t threads = std::thread::hardware_concurrency();
+		std::size_t count = 1;
+		while (count < threads && count < 256)
+		{
+			count <<= 1;
+		}
+
+		return count;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Round capacity.
+	* @param[in]	capacity		Requested capacity.
+	* @returns		std::size_t		The lowest power of two not lower than capacity (at least 2).
+	******************************************************************************************************/
+	static std::size_t RoundCapacity(std::size_t capacity) noexcept
+	{
+		std::size_t rounded = 2;
+		while (rounded < capacity)
+		{
+			rounded <<= 1;
+		}
+
+		return rounded;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get thread stripe.
+	* @details		Threads get stripes round robin on their first report (collectors share the assignment).
+	* @returns		std::size_t		Stripe index of current thread (must be masked by stripe count).
+	******************************************************************************************************/
+	static std::size_t GetThreadStripe() noexcept
+	{
+		static std::atomic<std::size_t> nextStripe(0);
+		static thread_local std::size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed);
+
+		return stripe;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Hash errorcode.
+	* @param[in]	errorCode		The errorcode.
+	* @returns		std::size_t		Index of the first probed exception slot.
+	******************************************************************************************************/
+	std::size_t Hash(MsvErrorCode errorCode) const noexcept
+	{
+		return static_cast<std::size_t>((static_cast<uint32_t>(errorCode) * 0x9E3779B1u) >> 16) & m_exceptionMask;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Update first error.
+	* @details		Only the first failure writes (CAS from MSV_SUCCESS), later ones just read.
+	* @param[in]	errorCode		Failed errorcode.
+	******************************************************************************************************/
+	void UpdateFirst(MsvErrorCode errorCode) noexcept
+	{
+		MsvErrorCode expected = MSV_SUCCESS;
+		if (m_firstError.load(std::memory_order_relaxed) == MSV_SUCCESS)
+		{
+			m_firstError.compare_exchange_strong(expected, errorCode, std::memory_order_release, std::memory_order_relaxed);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Update worst error.
+	* @details		Writes only when errorcode has worse severity than the current worst error.
+	* @param[in]	errorCode		Failed errorcode.
+	******************************************************************************************************/
+	void UpdateWorst(MsvErrorCode errorCode) noexcept
+	{
+		MsvErrorCode worst = m_worstError.load(std::memory_order_relaxed);
+		while (MsvErrorCodeSeverity(errorCode) > MsvErrorCodeSeverity(worst))
+		{
+			if (m_worstError.compare_exchange_weak(worst, errorCode, std::memory_order_release, std::memory_order_relaxed))
+			{
+				return;
+			}
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Capture errorcode.
+	* @details		Appends errorcode to stripe of current thread, to the next not full stripe when it is full
+	*					or counts it as dropped when all stripes are full (full stripes are only read).
+	* @param[in]	errorCode		Failed errorcode.
+	******************************************************************************************************/
+	void Capture(MsvErrorCode errorCode) noexcept
+	{
+		std::size_t threadStripe = GetThreadStripe() & (m_stripeCount - 1);
+
+		for (std::size_t probe = 0, stripe = threadStripe; probe < m_stripeCount; ++probe, stripe = (stripe + 1) & (m_stripeCount - 1))
+		{
+			if (m_stripes[stripe].count.load(std::memory_order_relaxed) < m_stripeCapacity)
+			{
+				std::size_t index = m_stripes[stripe].count.fetch_add(1, std::memory_order_acq_rel);
+				if (index < m_stripeCapacity)
+				{
+					m_errors[stripe * m_stripeCapacity + index].store(errorCode, std::memory_order_release);
+					return;
+				}
+			}
+		}
+
+		m_stripes[threadStripe].dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Store exception.
+	* @details		Claims slot of errorcode (when it has no slot yet) and copies exception to the next free
+	*					storage. Exception is not stored when the storage is full.
+	* @param[in]	exception		Exception with failed errorcode.
+	******************************************************************************************************/
+	void Store(const MsvException& exception) noexcept
+	{
+		MsvErrorCode errorCode = exception.GetErrorCode();
+
+		for (std::size_t probe = 0, index = Hash(errorCode); probe <= m_exceptionMask; ++probe, index = (index + 1) & m_exceptionMask)
+		{
+			ExceptionSlot& slot = m_exceptionSlots[index];
+			MsvErrorCode slotCode = slot.errorCode.load(std::memory_order_acquire);
+
+			if (slotCode == MSV_SUCCESS && slot.errorCode.compare_exchange_strong(slotCode, errorCode, std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				std::size_t storage = m_exceptionCount.fetch_add(1, std::memory_order_relaxed);
+				if (storage < m_exceptionCapacity)
+				{
+					new (&m_exceptions[storage].exception) MsvException(exception);
+					slot.exception.store(&m_exceptions[storage].exception, std::memory_order_release);
+				}
+				return;
+			}
+
+			if (slotCode == errorCode)
+			{
+				return;
+			}
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		The first reported failed errorcode (MSV_SUCCESS when nothing has failed).
+	******************************************************************************************************/
+	alignas(64) std::atomic<MsvErrorCode> m_firstError;
+
+	/**************************************************************************************************//**
+	* @brief		The first reported errorcode with the worst severity.
+	******************************************************************************************************/
+	alignas(64) std::atomic<MsvErrorCode> m_worstError;
+
+	/**************************************************************************************************//**
+	* @brief		Count of stripes (power of two).
+	******************************************************************************************************/
+	alignas(64) std::size_t m_stripeCount;
+
+	/**************************************************************************************************//**
+	* @brief		Count of errorcodes captured by one stripe.
+	******************************************************************************************************/
+	std::size_t m_stripeCapacity;
+
+	/**************************************************************************************************//**
+	* @brief		Stripes (counters of reported errorcodes).
+	******************************************************************************************************/
+	std::unique_ptr<Stripe[]> m_stripes;
+
+	/**************************************************************************************************//**
+	* @brief		Captured errorcodes (stripe after stripe, MSV_SUCCESS for not yet written ones).
+	******************************************************************************************************/
+	std::unique_ptr<std::atomic<MsvErrorCode>[]> m_errors;
+
+	/**************************************************************************************************//**
+	* @brief		Exception table mask (size - 1, size is power of two).
+	******************************************************************************************************/
+	std::size_t m_exceptionMask;
+
+	/**************************************************************************************************//**
+	* @brief		Exception table (open addressing by errorcode, twice as big as exception capacity).
+	******************************************************************************************************/
+	std::unique_ptr<ExceptionSlot[]> m_exceptionSlots;
+
+	/**************************************************************************************************//**
+	* @brief		Count of exceptions which can be stored.
+	******************************************************************************************************/
+	std::size_t m_exceptionCapacity;
+
+	/**************************************************************************************************//**
+	* @brief		Count of claimed exception storages (it may exceed capacity).
+	******************************************************************************************************/
+	alignas(64) std::atomic<std::size_t> m_exceptionCount;
+
+	/**************************************************************************************************//**
+	* @brief		Stored exceptions (in order of their errorcodes' first reports).
+	******************************************************************************************************/
+	std::unique_ptr<ExceptionStorage[]> m_exceptions;
+};
+
+
+#endif // !MARSTECH_ERROR_COLLECTOR_H
+
+/** @} */	//End of group MPLS.
@@ -0,0 +1,425 @@
+/**************************************************************************************************//**
+* @defgroup		MSVERROR MarsTech Error Handling
+* @brief			MarsTech Error
+* @details		Contains implementation and all definitions of MarsTech Error.
+* @copyright	GNU General Public License (GPLv3).
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Error Counters
+* @details		Contains per-code error counters (thread-local shards) and their Prometheus export.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Error.
+
+MarsTech Error is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Error is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MarsTech Error. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_ERROR_COUNTERS_H
+#define MARSTECH_ERROR_COUNTERS_H
+
+
+#include "msverror.h"
+#include "msverrorregistry.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <system_error>
+
+MSV_ENABLE_WARNINGS
+
+
+#ifndef MSV_ERROR_COUNTERS_CODES
+/**************************************************************************************************//**
+* @def			MSV_ERROR_COUNTERS_CODES
+* @brief			Counted codes per severity.
+* @details		Count of errorcodes (per severity) which have own counter (errorcodes with index lower than this
+*					value). Other errorcodes are counted together per severity. Define it before including MarsTech
+*					Error headers to change it (it must be same in all translation units).
+* @see			MsvErrorCodeIndex
+******************************************************************************************************/
+#define MSV_ERROR_COUNTERS_CODES 64
+#endif // !MSV_ERROR_COUNTERS_CODES
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech error counters snapshot.
+* @details	Counts of errorcodes aggregated from all thread shards (see @ref MsvErrorCounters::GetSnapshot).
+******************************************************************************************************/
+class MsvErrorCountersSnapshot
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Severity count.
+	* @details	Success, info, warning and error.
+	******************************************************************************************************/
+	static constexpr std::size_t SeverityCount = 4;
+
+	/**************************************************************************************************//**
+	* @brief		Counter count per severity.
+	* @details	One counter for each counted errorcode and one for all other errorcodes.
+	******************************************************************************************************/
+	static constexpr std::size_t CounterCount = MSV_ERROR_COUNTERS_CODES + 1;
+
+	/**************************************************************************************************//**
+	* @brief			Get counter slot.
+	* @details		Returns counter index of errorcode (in the row of its severity).
+	* @param[in]	errorCode		Errorcode.
+	* @returns		std::size_t		Counter index (the last one for not counted errorcodes).
+	******************************************************************************************************/
+	static constexpr std::size_t GetCounterIndex(MsvErrorCode errorCode) noexcept
+	{
+		return MsvErrorCodeIndex(errorCode) < MSV_ERROR_COUNTERS_CODES ? MsvErrorCodeIndex(errorCode) : MSV_ERROR_COUNTERS_CODES;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates snapshot with zero counts.
+	******************************************************************************************************/
+	MsvErrorCountersSnapshot() noexcept :
+		m_counts()
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get count.
+	* @param[in]	errorCode		Errorcode.
+	* @returns		uint64_t			Count of errorcode (errorcodes with index not lower than
+	*										@ref MSV_ERROR_COUNTERS_CODES share one count per severity).
+	******************************************************************************************************/
+	uint64_t GetCount(MsvErrorCode errorCode) const noexcept
+	{
+		return m_counts[MsvErrorCodeSeverity(errorCode)][GetCounterIndex(errorCode)];
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get severity count.
+	* @param[in]	severity		Severity (0 success, 1 info, 2 warning, 3 error).
+	* @returns		uint64_t		Count of all errorcodes with the severity.
+	******************************************************************************************************/
+	uint64_t GetSeverityCount(uint32_t severity) const noexcept
+	{
+		uint64_t count = 0;
+		for (std::size_t index = 0; index < CounterCount; ++index)
+		{
+			count += m_counts[severity][index];
+		}
+
+		return count;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Add count.
+	* @param[in]	severity		Severity (0 success, 1 info, 2 warning, 3 error).
+	* @param[in]	index			Counter index.
+	* @param[in]	count			Count to add.
+	******************************************************************************************************/
+	void AddCount(std::size_t severity, std::size_t index, uint64_t count) noexcept
+	{
+		m_counts[severity][index] += count;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Write Prometheus text.
+	* @details		Writes counts in Prometheus text exposition format - metric msv_errors_total (labels
+	*					severity, code and name) and msv_errors_severity_total (label severity). Zero counts are
+	*					not written (except severity totals).
+	* @param[in]	stream		Output stream.
+	* @returns		std::ostream&		The stream.
+	******************************************************************************************************/
+	std::ostream& WritePrometheus(std::ostream& stream) const
+	{
+		static const char* const severityNames[SeverityCount] = { "success", "info", "warning", "error" };
+
+		stream << "# HELP msv_errors_total Count of produced MarsTech errorcodes.\n";
+		stream << "# TYPE msv_errors_total counter\n";
+
+		for (std::size_t severity = 0; severity < SeverityCount; ++severity)
+		{
+			for (std::size_t index = 0; index < CounterCount; ++index)
+			{
+				if (!m_counts[severity][index])
+				{
+					continue;
+				}
+
+				stream << "msv_errors_total{severity=\"" << severityNames[severity] << "\",code=\"";
+
+				if (index < MSV_ERROR_COUNTERS_CODES)
+				{
+					MsvErrorCode errorCode = static_cast<MsvErrorCode>((static_cast<uint32_t>(severity) << 30) | static_cast<uint32_t>(index));
+					const char* name = MsvErrorCodeName(errorCode);
+					char code[11];
+					std::snprintf(code, sizeof(code), "0x%08X", static_cast<uint32_t>(errorCode));
+
+					stream << code << "\",name=\"" << (name ? name : "") << "\"} ";
+				}
+				else
+				{
+					stream << "other\",name=\"\"} ";
+				}
+
+				stream << m_counts[severity][index] << '\n';
+			}
+		}
+
+		stream << "# HELP msv_errors_severity_total Count of produced MarsTech errorcodes per severity.\n";
+		stream << "# TYPE msv_errors_severity_total counter\n";
+
+		for (uint32_t severity = 0; severity < SeverityCount; ++severity)
+		{
+			stream << "msv_errors_severity_total{severity=\"" << severityNames[severity] << "\"} " << GetSeverityCount(severity) << '\n';
+		}
+
+		return stream;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Write Prometheus file.
+	* @details		Writes counts in Prometheus text exposition format to the file. File is written to temporary
+	*					file (filePath + ".tmp") and renamed then (it atomically replaces existing file), so readers
+	*					(e.g. textfile collector) never see missing or partially written file.
+	* @param[in]	filePath		Output file path.
+	* @retval		MSV_SUCCESS			On success.
+	* @retval		MSV_OPEN_ERROR		When file can't be written.
+	* @see			WritePrometheus(std::ostream&)
+	******************************************************************************************************/
+	MsvErrorCode WritePrometheus(const char* filePath) const
+	{
+		std::string tempPath = std::string(filePath) + ".tmp";
+
+		{
+			std::ofstream file(tempPath, std::ios::out | std::ios::trunc);
+			if (!file || !WritePrometheus(file) || !file.flush())
+			{
+				return MSV_OPEN_ERROR;
+			}
+		}
+
+		//replaces existing file on Windows too (std::rename does not)
+		std::error_code error;
+		std::filesystem::rename(tempPath, filePath, error);
+		if (error)
+		{
+			std::filesystem::remove(tempPath, error);
+			return MSV_OPEN_ERROR;
+		}
+
+		return MSV_SUCCESS;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Counts.
+	* @details	Counts per severity and counter index.
+	******************************************************************************************************/
+	uint64_t m_counts[SeverityCount][CounterCount];
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech error counter shard.
+* @details	Counters of one thread. Only the owner thread increments them (relaxed load and store - there are
+*				no read-modify-write atomics), other threads only read them (snapshot).
+******************************************************************************************************/
+class MsvErrorCounterShard
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	******************************************************************************************************/
+	MsvErrorCounterShard() noexcept
+	{
+		for (std::size_t severity = 0; severity < MsvErrorCountersSnapshot::SeverityCount; ++severity)
+		{
+			for (std::size_t index = 0; index < MsvErrorCountersSnapshot::CounterCount; ++index)
+			{
+				m_counts[severity][index].store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Increment count.
+	* @param[in]	errorCode		Errorcode to count.
+	* @warning		It must be called by the owner thread only.
+	******************************************************************************************************/
+	void Increment(MsvErrorCode errorCode) noexcept
+	{
+		std::atomic<uint64_t>& counter = m_counts[MsvErrorCodeSeverity(errorCode)][MsvErrorCountersSnapshot::GetCounterIndex(errorCode)];
+		counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Add counts to snapshot.
+	* @param[in]	snapshot		Snapshot to add counts to.
+	******************************************************************************************************/
+	void AddTo(MsvErrorCountersSnapshot& snapshot) const noexcept
+	{
+		for (std::size_t severity = 0; severity < MsvErrorCountersSnapshot::SeverityCount; ++severity)
+		{
+			for (std::size_t index = 0; index < MsvErrorCountersSnapshot::CounterCount; ++index)
+			{
+				snapshot.AddCount(severity, index, m_counts[severity][index].load(std::memory_order_relaxed));
+			}
+		}
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Counts.
+	* @details	Counts per severity and counter index.
+	******************************************************************************************************/
+	std::atomic<uint64_t> m_counts[MsvErrorCountersSnapshot::SeverityCount][MsvErrorCountersSnapshot::CounterCount];
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech error counters.
+* @details	Process wide per-code error counters. Each thread increments its own shard (created on the first
+*				increment), so threads never contend. Counts of finished threads are kept.
+* @note		Counters are incremented by @ref MsvException (@ref MSV_THROW, @ref MSV_THROW_FAILED,
+*				@ref MSV_RETHROW) and by failure branches of propagation macros (@ref MSV_RETURN_FAILED,
+*				@ref MSV_TRY) when @ref MSV_ERROR_COUNTERS is defined.
+* @see		MSV_ERROR_COUNTERS
+******************************************************************************************************/
+class MsvErrorCounters
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Increment count.
+	* @details		Increments count of errorcode in shard of current thread.
+	* @param[in]	errorCode		Errorcode to count.
+	******************************************************************************************************/
+	static void Increment(MsvErrorCode errorCode) noexcept
+	{
+		GetThreadShard().shard.Increment(errorCode);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get snapshot.
+	* @details		Aggregates counts of all shards (including shards of finished threads).
+	* @returns		MsvErrorCountersSnapshot		Aggregated counts.
+	* @note			Counts incremented concurrently may or may not be included.
+	******************************************************************************************************/
+	static MsvErrorCountersSnapshot GetSnapshot()
+	{
+		Registry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+
+		MsvErrorCountersSnapshot snapshot = registry.retired;
+		for (const ThreadShard* threadShard = registry.first; threadShard; threadShard = threadShard->next)
+		{
+			threadShard->shard.AddTo(snapshot);
+		}
+
+		return snapshot;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Thread shard.
+	* @details	Registers shard on construction and moves its counts to retired counts on thread exit.
+	******************************************************************************************************/
+	struct ThreadShard
+	{
+		ThreadShard() noexcept :
+			previous(nullptr)
+		{
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+
+			next = registry.first;
+			if (next)
+			{
+				next->previous = this;
+			}
+			registry.first = this;
+		}
+
+		~ThreadShard() noexcept
+		{
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+
+			shard.AddTo(registry.retired);
+			(previous ? previous->next : registry.first) = next;
+			if (next)
+			{
+				next->previous = previous;
+			}
+		}
+
+		MsvErrorCounterShard shard;
+		ThreadShard* previous;
+		ThreadShard* next;
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Shard registry.
+	* @details	Live shards (linked list - registration never allocates) and counts of finished threads.
+	******************************************************************************************************/
+	struct Registry
+	{
+		std::mutex mutex;
+		ThreadShard* first = nullptr;
+		MsvErrorCountersSnapshot retired;
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Get registry.
+	* @returns		Registry&		Process wide shard registry.
+	******************************************************************************************************/
+	static Registry& GetRegistry()
+	{
+		static Registry registry;
+
+		return registry;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get thread shard.
+	* @returns		ThreadShard&		Shard of current thread (created by the first call).
+	******************************************************************************************************/
+	static ThreadShard& GetThreadShard()
+	{
+		static thread_local ThreadShard threadShard;
+
+		return threadShard;
+	}
+};
+
+
+#endif // !MARSTECH_ERROR_COUNTERS_H
+
+/** @} */	//End of group MPLS.
@@ -0,0 +1,318 @@
+/**************************************************************************************************//**
+* @defgroup		MSVERROR MarsTech Error Handling
+* @brief			MarsTech Error
+* @details		Contains implementation and all definitions of MarsTech Error.
+* @copyright	GNU General Public License (GPLv3).
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Error Code Registry
+* @details		Contains compile-time registry of MarsTech error codes (names and descriptions).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Error.
+
+MarsTech Error is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Error is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MarsTech Error. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_ERROR_REGISTRY_H
+#define MARSTECH_ERROR_REGISTRY_H
+
+
+#include "msverrorcodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech error code info.
+* @details	Registered error code with its name and description.
+* @see		MSV_ERROR_CODE_LIST
+******************************************************************************************************/
+struct MsvErrorCodeInfo
+{
+	/**************************************************************************************************//**
+	* @brief		Registered error code.
+	******************************************************************************************************/
+	MsvErrorCode errorCode;
+
+	/**************************************************************************************************//**
+	* @brief		Name of error code (for example "MSV_BUSY_ERROR").
+	******************************************************************************************************/
+	const char* name;
+
+	/**************************************************************************************************//**
+	* @brief		Description of error code.
+	******************************************************************************************************/
+	const char* description;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Registered error codes.
+* @details	All error codes from @ref MSV_ERROR_CODE_LIST in definition order.
+******************************************************************************************************/
+inline constexpr MsvErrorCodeInfo MsvErrorCodeInfos[] =
+{
+#define MSV_ERROR_CODE_INFO(errorCode, value, description) { errorCode, #errorCode, description },
+	MSV_ERROR_CODE_LIST(MSV_ERROR_CODE_INFO)
+#undef MSV_ERROR_CODE_INFO
+};
+
+/**************************************************************************************************//**
+* @brief		Registered error code count.
+******************************************************************************************************/
+inline constexpr std::size_t MsvErrorCodeInfoCount = sizeof(MsvErrorCodeInfos) / sizeof(MsvErrorCodeInfos[0]);
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech error code table.
+* @details	Table of registered error codes of one severity indexed by @ref MsvErrorCodeIndex. It is built
+*				at compile time from @ref MsvErrorCodeInfos.
+* @note		Registered error codes are from @ref MsvMarsTechFacility, so index is error code number.
+* @tparam		Severity		Severity of error codes in table (0 - success, 1 - info, 2 - warning, 3 - error).
+******************************************************************************************************/
+template<uint32_t Severity>
+class MsvErrorCodeTable
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Get table size.
+	* @returns		std::size_t		The highest index of registered error code with Severity + 1.
+	******************************************************************************************************/
+	static constexpr std::size_t GetSize() noexcept
+	{
+		std::size_t size = 0;
+		for (const MsvErrorCodeInfo& info : MsvErrorCodeInfos)
+		{
+			if (MsvErrorCodeSeverity(info.errorCode) == Severity && MsvErrorCodeIndex(info.errorCode) >= size)
+			{
+				size = MsvErrorCodeIndex(info.errorCode) + 1;
+			}
+		}
+
+		return size;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Build table.
+	* @returns		std::array		Pointers to registered error code infos (nullptr for not registered indexes).
+	******************************************************************************************************/
+	static constexpr std::array<const MsvErrorCodeInfo*, GetSize()> Build() noexcept
+	{
+		std::array<const MsvErrorCodeInfo*, GetSize()> table = {};
+		for (std::size_t index = 0; index < MsvErrorCodeInfoCount; ++index)
+		{
+			if (MsvErrorCodeSeverity(MsvErrorCodeInfos[index].errorCode) == Severity)
+			{
+				table[MsvErrorCodeIndex(MsvErrorCodeInfos[index].errorCode)] = &MsvErrorCodeInfos[index];
+			}
+		}
+
+		return table;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Table of registered error code infos.
+	******************************************************************************************************/
+	static constexpr std::array<const MsvErrorCodeInfo*, GetSize()> Table = Build();
+
+	/**************************************************************************************************//**
+	* @brief			Find error code info.
+	* @param[in]	index		Error code index (@ref MsvErrorCodeIndex).
+	* @returns		const MsvErrorCodeInfo*		Error code info or nullptr when it is not registered.
+	******************************************************************************************************/
+	static constexpr const MsvErrorCodeInfo* Find(uint32_t index) noexcept
+	{
+		return index < Table.size() ? Table[index] : nullptr;
+	}
+};
+
+
+/**************************************************************************************************//**
+* @brief			Get error code info.
+* @details		Finds registered error code in per severity table (direct index - O(1)).
+* @param[in]	errorCode		The errorcode.
+* @returns		const MsvErrorCodeInfo*		Error code info or nullptr when errorCode is not registered.
+******************************************************************************************************/
+constexpr const MsvErrorCodeInfo* MsvGetErrorCodeInfo(MsvErrorCode errorCode) noexcept
+{
+	switch (MsvErrorCodeSeverity(errorCode))
+	{
+	case 0:
+		return MsvErrorCodeTable<0>::Find(MsvErrorCodeIndex(errorCode));
+	case 1:
+		return MsvErrorCodeTable<1>::Find(MsvErrorCodeIndex(errorCode));
+	case 2:
+		return MsvErrorCodeTable<2>::Find(MsvErrorCodeIndex(errorCode));
+	default:
+		return MsvErrorCodeTable<3>::Find(MsvErrorCodeIndex(errorCode));
+	}
+}
+
+/**************************************************************************************************//**
+* @brief			Get error code name.
+* @param[in]	errorCode		The errorcode.
+* @returns		const char*		Name of error code (for example "MSV_BUSY_ERROR") or nullptr when errorCode
+*										is not registered.
+* @see			MSV_ERROR_CODE_LIST
+******************************************************************************************************/
+constexpr const char* MsvErrorCodeName(MsvErrorCode errorCode) noexcept
+{
+	const MsvErrorCodeInfo* info = MsvGetErrorCodeInfo(errorCode);
+
+	return info ? info->name : nullptr;
+}
+
+/**************************************************************************************************//**
+* @brief			Get error code description.
+* @param[in]	errorCode		The errorcode.
+* @returns		const char*		Description of error code or nullptr when errorCode is not registered.
+* @see			MSV_ERROR_CODE_LIST
+******************************************************************************************************/
+constexpr const char* MsvErrorCodeDescription(MsvErrorCode errorCode) noexcept
+{
+	const MsvErrorCodeInfo* info = MsvGetErrorCodeInfo(errorCode);
+
+	return info ? info->description : nullptr;
+}
+
+
+/**************************************************************************************************//**
+* @brief			Check registered error codes are unique.
+* @retval		true		When there are no two registered error codes with the same value.
+* @retval		false		When some value is registered more times.
+******************************************************************************************************/
+constexpr bool MsvErrorCodesAreUnique() noexcept
+{
+	for (std::size_t index = 0; index < MsvErrorCodeInfoCount; ++index)
+	{
+		for (std::size_t next = index + 1; next < MsvErrorCodeInfoCount; ++next)
+		{
+			if (MsvErrorCodeInfos[index].errorCode == MsvErrorCodeInfos[next].errorCode)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/**************************************************************************************************//**
+* @brief			Check name suffix.
+* @param[in]	name		Name to check.
+* @param[in]	suffix	Expected suffix.
+* @retval		true		When name ends with suffix.
+* @retval		false		When name does not end with suffix.
+******************************************************************************************************/
+constexpr bool MsvErrorCodeNameEndsWith(const char* name, const char* suffix) noexcept
+{
+	std::size_t nameLength = 0;
+	std::size_t suffixLength = 0;
+	for (; name[nameLength]; ++nameLength) {}
+	for (; suffix[suffixLength]; ++suffixLength) {}
+
+	if (suffixLength > nameLength)
+	{
+		return false;
+	}
+
+	for (std::size_t index = 0; index < suffixLength; ++index)
+	{
+		if (name[nameLength - suffixLength + index] != suffix[index])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**************************************************************************************************//**
+* @brief			Check registered error code severities.
+* @details		Error codes with _INFO, _WARN and _ERROR suffix must have info, warning and error severity.
+*					Other error codes must have success severity.
+* @retval		true		When all registered error codes have severity matching their names.
+* @retval		false		When some error code has wrong severity.
+******************************************************************************************************/
+constexpr bool MsvErrorCodeSeveritiesMatchNames() noexcept
+{
+	for (const MsvErrorCodeInfo& info : MsvErrorCodeInfos)
+	{
+		bool valid = MsvErrorCodeSeverity(info.errorCode) == 0;
+		if (MsvErrorCodeNameEndsWith(info.name, "_INFO"))
+		{
+			valid = MsvErrorCodeSeverity(info.errorCode) == 1;
+		}
+		else if (MsvErrorCodeNameEndsWith(info.name, "_WARN"))
+		{
+			valid = MsvErrorCodeSeverity(info.errorCode) == 2;
+		}
+		else if (MsvErrorCodeNameEndsWith(info.name, "_ERROR"))
+		{
+			valid = MsvErrorCodeSeverity(info.errorCode) == 3;
+		}
+
+		if (!valid)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**************************************************************************************************//**
+* @brief			Check registered error code facilities.
+* @details		Registered error codes must be composed as @ref MsvMakeErrorCode composes them with
+*					@ref MsvMarsTechFacility (per severity tables are indexed by error code number then).
+* @retval		true		When all registered error codes are from MarsTech facility.
+* @retval		false		When some error code has other facility or reserved bits set.
+******************************************************************************************************/
+constexpr bool MsvErrorCodesAreMarsTechFacility() noexcept
+{
+	for (const MsvErrorCodeInfo& info : MsvErrorCodeInfos)
+	{
+		if (MsvMakeErrorCode(info.errorCode, MsvMarsTechFacility, MsvErrorCodeNumber(info.errorCode)) != info.errorCode)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static_assert(MsvErrorCodesAreUnique(), "Registered error codes must be unique.");
+static_assert(MsvErrorCodeSeveritiesMatchNames(), "Severity of registered error code must match its suffix (_INFO, _WARN, _ERROR).");
+static_assert(MsvErrorCodesAreMarsTechFacility(), "Registered error codes must be from MarsTech facility.");
+
+
+#endif // !MARSTECH_ERROR_REGISTRY_H
+
+/** @} */	//End of group MPLS.
@@ -0,0 +1,621 @@
+/**************************************************************************************************//**
+* @defgroup		MSVERROR MarsTech Error Handling
+* @brief			MarsTech Error
+* @details		Contains implementation and all definitions of MarsTech Error.
+* @copyright	GNU General Public License (GPLv3).
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Error Sink
+* @details		Contains asynchronous batched error-logging sink (bounded lock-free MPSC queue and background writer).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Error.
+
+MarsTech Error is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Error is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MarsTech Error. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_ERROR_SINK_H
+#define MARSTECH_ERROR_SINK_H
+
+
+#include "msverror.h"
+#include "msverrorregistry.h"
+#include "msvexception.h"
+#include "msvinlinestring.h"
+#include "msvtimestamp.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+#ifndef MSV_ERROR_SINK_MESSAGE_SIZE
+/**************************************************************************************************//**
+* @def			MSV_ERROR_SINK_MESSAGE_SIZE
+* @brief			Sink message size.
+* @details		Size of message buffer of logged errorcodes (including terminating zero). Longer messages are
+*					truncated. Define it before including this header to change it.
+******************************************************************************************************/
+#define MSV_ERROR_SINK_MESSAGE_SIZE 96
+#endif // !MSV_ERROR_SINK_MESSAGE_SIZE
+
+#ifndef MSV_ERROR_SINK_BATCH
+/**************************************************************************************************//**
+* @def			MSV_ERROR_SINK_BATCH
+* @brief			Sink batch size.
+* @details		Maximal count of entries formatted to one batch (one writer call). Define it before including
+*					this header to change it.
+******************************************************************************************************/
+#define MSV_ERROR_SINK_BATCH 64
+#endif // !MSV_ERROR_SINK_BATCH
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech error sink policy.
+* @details	What to do when sink queue is full.
+******************************************************************************************************/
+enum class MsvErrorSinkPolicy
+{
+	Drop,		///< New entry is dropped (and counted - see @ref MsvErrorSink::GetDroppedCount).
+	Block		///< Caller waits until there is free space in queue.
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech error sink.
+* @details	Catch sites hand exceptions or errorcodes to the sink through bounded lock-free MPSC queue (no locks,
+*				no allocations) and background thread formats and writes them in batches. Memory is bounded by
+*				queue capacity. When queue is full, entry is dropped or caller waits (see @ref MsvErrorSinkPolicy).
+*				All queued entries are written on @ref Flush and on @ref Shutdown (called by destructor).
+* @note		Exceptions are written as formatted by @ref MsvException::what, errorcodes in the same line format.
+* @see		MSV_SINK_LOG
+******************************************************************************************************/
+class MsvErrorSink
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Writer.
+	* @details	Called by background thread with formatted batch (data and its length). It must not throw.
+	******************************************************************************************************/
+	typedef std::function<void(const char*, std::size_t)> Writer;
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates queue and starts background thread.
+	* @param[in]	writer		Writer of formatted batches.
+	* @param[in]	capacity		Queue capacity (it is rounded up to power of two).
+	* @param[in]	policy		What to do when queue is full.
+	* @throws		std::bad_alloc, std::system_error		When queue or thread can't be created.
+	******************************************************************************************************/
+	explicit MsvErrorSink(Writer writer, std::size_t capacity = 1024, MsvErrorSinkPolicy policy = MsvErrorSinkPolicy::Drop) :
+		m_writer(std::move(writer)),
+		m_mask(RoundCapacity(capacity) - 1),
+		m_slots(new Slot[m_mask + 1]),
+		m_policy(policy),
+		m_enqueuePosition(0),
+		m_dequeuePosition(0),
+		m_producers(0),
+		m_processedPosition(0),
+		m_flushRequests(0),
+		m_stopped(false),
+		m_droppedCount(0),
+		m_writtenCount(0),
+		m_running(true)
+	{
+		for (std::size_t index = 0; index <= m_mask; ++index)
+		{
+			m_slots[index].sequence.store(index, std::memory_order_relaxed);
+		}
+
+		m_thread = std::thread(&MsvErrorSink::Run, this);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates sink writing batches to the file.
+	* @param[in]	file			Output file (e.g. stderr). It is flushed after each batch.
+	* @param[in]	capacity		Queue capacity (it is rounded up to power of two).
+	* @param[in]	policy		What to do when queue is full.
+	******************************************************************************************************/
+	explicit MsvErrorSink(std::FILE* file, std::size_t capacity = 1024, MsvErrorSinkPolicy policy = MsvErrorSinkPolicy::Drop) :
+		MsvErrorSink([file](const char* data, std::size_t length) { std::fwrite(data, 1, length, file); std::fflush(file); }, capacity, policy)
+	{
+
+	}
+
+	MsvErrorSink(const MsvErrorSink&) = delete;
+	MsvErrorSink& operator=(const MsvErrorSink&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Destructor.
+	* @details		Writes all queued entries and stops background thread.
+	* @see			Shutdown
+	******************************************************************************************************/
+	~MsvErrorSink() noexcept
+	{
+		Shutdown();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Log exception.
+	* @details		Queues copy of the exception (copying @ref MsvException never allocates).
+	* @param[in]	exception		Exception to log.
+	* @retval		true				When exception has been queued.
+	* @retval		false				When it has been dropped (queue is full or sink is shut down).
+	******************************************************************************************************/
+	bool Log(const MsvException& exception) noexcept
+	{
+		std::size_t position = 0;
+		Slot* slot = Acquire(position);
+		if (!slot)
+		{
+			return false;
+		}
+
+		new (&slot->exception) MsvException(exception);
+		slot->isException = true;
+		Publish(slot, position);
+
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Log errorcode.
+	* @param[in]	errorCode		Errorcode to log.
+	* @param[in]	fileName			Filename where errorcode has been produced (only pointer is stored - it is
+	*										usually __FILE__).
+	* @param[in]	line				Line number where errorcode has been produced.
+	* @param[in]	msg				Message (it is copied and truncated to @ref MSV_ERROR_SINK_MESSAGE_SIZE). Name
+	*										of registered errorcode is written when it is nullptr.
+	* @retval		true				When errorcode has been queued.
+	* @retval		false				When it has been dropped (queue is full or sink is shut down).
+	* @see			MSV_SINK_LOG
+	******************************************************************************************************/
+	bool Log(MsvErrorCode errorCode, const char* fileName, int line, const char* msg = nullptr) noexcept
+	{
+		std::size_t position = 0;
+		Slot* slot = Acquire(position);
+		if (!slot)
+		{
+			return false;
+		}
+
+		if (!msg)
+		{
+			msg = MsvErrorCodeName(errorCode);
+		}
+
+		slot->isException = false;
+		slot->code.errorCode = errorCode;
+		slot->code.fileName = fileName;
+		slot->code.line = line;
+		slot->code.timestamp = MsvTimestampNow();
+
+		std::size_t length = msg ? std::strlen(msg) : 0;
+		length = length < MSV_ERROR_SINK_MESSAGE_SIZE ? length : MSV_ERROR_SINK_MESSAGE_SIZE - 1;
+		std::memcpy(slot->code.message, msg ? msg : "", length);
+		slot->code.message[length] = '\0';
+
+		Publish(slot, position);
+
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Flush.
+	* @details		Waits until all entries queued before the call are written.
+	******************************************************************************************************/
+	void Flush()
+	{
+		std::size_t target = m_enqueuePosition.load(std::memory_order_acquire);
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		++m_flushRequests;
+		m_wakeUp.notify_one();
+		while (m_processedPosition < target && !m_stopped)
+		{
+			m_processed.wait_for(lock, std::chrono::milliseconds(10));
+		}
+		--m_flushRequests;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Shutdown.
+	* @details		Writes all queued entries and stops background thread. Entries logged later are dropped.
+	******************************************************************************************************/
+	void Shutdown() noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_running.store(false, std::memory_order_seq_cst);
+			m_wakeUp.notify_one();
+		}
+
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get dropped count.
+	* @returns		uint64_t		Count of dropped entries (queue was full or sink was shut down).
+	******************************************************************************************************/
+	uint64_t GetDroppedCount() const noexcept
+	{
+		return m_droppedCount.load(std::memory_order_relaxed);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get written count.
+	* @returns		uint64_t		Count of written entries.
+	******************************************************************************************************/
+	uint64_t GetWrittenCount() const noexcept
+	{
+		return m_writtenCount.load(std::memory_order_relaxed);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get capacity.
+	* @returns		std::size_t		Queue capacity.
+	******************************************************************************************************/
+	std::size_t GetCapacity() const noexcept
+	{
+		return m_mask + 1;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Queue slot.
+	* @details	Sequence equals position when slot is free for producer of the position and position + 1 when
+	*				entry is ready for consumer (bounded MPMC queue by Dmitry Vyukov with single consumer).
+	******************************************************************************************************/
+	struct Slot
+	{
+		struct CodeEntry
+		{
+			MsvErrorCode errorCode;
+			int line;
+			const char* fileName;
+			MsvTimestamp timestamp;
+			char message[MSV_ERROR_SINK_MESSAGE_SIZE];
+		};
+
+		Slot() noexcept {}
+		~Slot() noexcept {}
+
+		std::atomic<std::size_t> sequence;
+		bool isException;
+
+		union
+		{
+			MsvException exception;
+			CodeEntry code;
+		};
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Round capacity.
+	* @param[in]	capacity		Requested capacity.
+	* @returns		std::size_t		The lowest power of two not lower than capacity (at least 2).
+	******************************************************************************************************/
+	static std::size_t RoundCapacity(std::size_t capacity) noexcept
+	{
+		std::size_t rounded = 2;
+		while (rounded < capacity)
+		{
+			rounded <<= 1;
+		}
+
+		return rounded;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Acquire slot.
+	* @details		Claims the next free slot (producer side). Claimed slot must be published by @ref Publish.
+	* @param[out]	position		Queue position of claimed slot.
+	* @returns		Slot*		Claimed slot or nullptr when entry is dropped.
+	******************************************************************************************************/
+	Slot* Acquire(std::size_t& position) noexcept
+	{
+		//shutdown waits for producers which saw running sink
+		m_producers.fetch_add(1, std::memory_order_seq_cst);
+		position = m_enqueuePosition.load(std::memory_order_relaxed);
+
+		while (m_running.load(std::memory_order_seq_cst))
+		{
+			Slot* slot = &m_slots[position & m_mask];
+			std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+			if (difference == 0)
+			{
+				if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					return slot;
+				}
+			}
+			else if (difference < 0)
+			{
+				if (m_policy == MsvErrorSinkPolicy::Drop)
+				{
+					break;
+				}
+
+				std::this_thread::yield();
+				position = m_enqueuePosition.load(std::memory_order_relaxed);
+			}
+			else
+			{
+				position = m_enqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+		m_producers.fetch_sub(1, std::memory_order_release);
+
+		return nullptr;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Publish slot.
+	* @details		Makes filled slot visible to consumer.
+	* @param[in]	slot			Claimed and filled slot.
+	* @param[in]	position		Queue position of the slot.
+	******************************************************************************************************/
+	void Publish(Slot* slot, std::size_t position) noexcept
+	{
+		slot->sequence.store(position + 1, std::memory_order_release);
+		m_producers.fetch_sub(1, std::memory_order_release);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Format entry.
+	* @details		Appends formatted entry to batch and destroys stored exception.
+	* @param[in]	slot		Slot with entry.
+	* @param[out]	batch		Batch to append formatted entry to.
+	******************************************************************************************************/
+	static void Format(Slot& slot, std::string& batch)
+	{
+		if (slot.isException)
+		{
+			batch.append(slot.exception.what());
+			slot.exception.~MsvException();
+			return;
+		}
+
+		MsvInlineString<MSV_ERROR_SINK_MESSAGE_SIZE + 128> line;
+		line.AppendDecimal(std::chrono::system_clock::to_time_t(MsvTimestampToSystemTime(slot.code.timestamp)));
+		line.Append(" 0x");
+		line.AppendDecimal(slot.code.errorCode, 8, '0');
+		line.AppendChar(' ');
+		line.Append(slot.code.fileName ? slot.code.fileName : "");
+		line.AppendChar(':');
+		line.AppendDecimal(slot.code.line);
+		line.AppendChar(' ');
+		line.Append(slot.code.message);
+		line.AppendChar('\n');
+
+		batch.append(line.GetString(), line.GetLength());
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Write batch.
+	* @details		Formats and writes up to @ref MSV_ERROR_SINK_BATCH ready entries (consumer side).
+	* @param[in]	batch		Reused batch buffer.
+	* @returns		std::size_t		Count of written entries.
+	******************************************************************************************************/
+	std::size_t WriteBatch(std::string& batch)
+	{
+		std::size_t count = 0;
+		batch.clear();
+
+		for (; count < MSV_ERROR_SINK_BATCH; ++count)
+		{
+			Slot& slot = m_slots[m_dequeuePosition & m_mask];
+			if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1)
+			{
+				break;
+			}
+
+			Format(slot, batch);
+			slot.sequence.store(m_dequeuePosition + m_mask + 1, std::memory_order_release);
+			++m_dequeuePosition;
+		}
+
+		if (count)
+		{
+			m_writer(batch.data(), batch.size());
+			m_writtenCount.fetch_add(count, std::memory_order_relaxed);
+		}
+
+		return count;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Run.
+	* @details		Background thread - writes batches until shutdown (then writes all queued entries). It polls
+	*					queue with growing idle wait (up to 16 ms) - producers never lock or notify.
+	******************************************************************************************************/
+	void Run()
+	{
+		std::string batch;
+		batch.reserve(MSV_ERROR_SINK_BATCH * 256);
+		std::chrono::milliseconds idle(1);
+
+		for (;;)
+		{
+			bool running = m_running.load(std::memory_order_acquire);
+			std::size_t written = WriteBatch(batch);
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+			if (written)
+			{
+				idle = std::chrono::milliseconds(1);
+				continue;
+			}
+
+			m_processedPosition = m_dequeuePosition;
+			m_processed.notify_all();
+
+			if (!running && !m_producers.load(std::memory_order_seq_cst) && m_processedPosition == m_enqueuePosition.load(std::memory_order_acquire))
+			{
+				m_stopped = true;
+				m_processed.notify_all();
+				return;
+			}
+
+			if (m_flushRequests || !running)
+			{
+				//claimed slots are being filled - they will be ready soon
+				lock.unlock();
+				std::this_thread::yield();
+				continue;
+			}
+
+			m_wakeUp.wait_for(lock, idle);
+			idle = idle < std::chrono::milliseconds(16) ? idle * 2 : idle;
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Writer of formatted batches.
+	******************************************************************************************************/
+	Writer m_writer;
+
+	/**************************************************************************************************//**
+	* @brief		Queue capacity mask.
+	* @details	Capacity - 1 (capacity is power of two).
+	******************************************************************************************************/
+	std::size_t m_mask;
+
+	/**************************************************************************************************//**
+	* @brief		Queue slots.
+	******************************************************************************************************/
+	std::unique_ptr<Slot[]> m_slots;
+
+	/**************************************************************************************************//**
+	* @brief		Full queue policy.
+	******************************************************************************************************/
+	MsvErrorSinkPolicy m_policy;
+
+	/**************************************************************************************************//**
+	* @brief		Enqueue position.
+	* @details	Position of the next claimed slot (shared by producers).
+	******************************************************************************************************/
+	alignas(64) std::atomic<std::size_t> m_enqueuePosition;
+
+	/**************************************************************************************************//**
+	* @brief		Dequeue position.
+	* @details	Position of the next entry to write (owned by background thread).
+	******************************************************************************************************/
+	alignas(64) std::size_t m_dequeuePosition;
+
+	/**************************************************************************************************//**
+	* @brief		Active producers.
+	* @details	Count of producers between claim and publish (shutdown waits for them).
+	******************************************************************************************************/
+	alignas(64) std::atomic<std::size_t> m_producers;
+
+	/**************************************************************************************************//**
+	* @brief		Mutex of background thread state.
+	******************************************************************************************************/
+	std::mutex m_mutex;
+
+	/**************************************************************************************************//**
+	* @brief		Wakes background thread up (flush, shutdown).
+	******************************************************************************************************/
+	std::condition_variable m_wakeUp;
+
+	/**************************************************************************************************//**
+	* @brief		Notifies processed entries (flush).
+	******************************************************************************************************/
+	std::condition_variable m_processed;
+
+	/**************************************************************************************************//**
+	* @brief		Processed position.
+	* @details	All entries before this position have been written.
+	******************************************************************************************************/
+	std::size_t m_processedPosition;
+
+	/**************************************************************************************************//**
+	* @brief		Count of waiting flushes.
+	******************************************************************************************************/
+	std::size_t m_flushRequests;
+
+	/**************************************************************************************************//**
+	* @brief		Background thread has stopped.
+	******************************************************************************************************/
+	bool m_stopped;
+
+	/**************************************************************************************************//**
+	* @brief		Count of dropped entries.
+	******************************************************************************************************/
+	std::atomic<uint64_t> m_droppedCount;
+
+	/**************************************************************************************************//**
+	* @brief		Count of written entries.
+	******************************************************************************************************/
+	std::atomic<uint64_t> m_writtenCount;
+
+	/**************************************************************************************************//**
+	* @brief		Sink accepts new entries.
+	******************************************************************************************************/
+	std::atomic<bool> m_running;
+
+	/**************************************************************************************************//**
+	* @brief		Background thread.
+	******************************************************************************************************/
+	std::thread m_thread;
+};
+
+
+/**************************************************************************************************//**
+* @def			MSV_SINK_LOG(msvSink, msvErrorCode, msvMessage)
+* @brief			Log errorcode to sink.
+* @details		Queues errorcode with current filename and line to @ref MsvErrorSink.
+* @param[in]	msvSink				The sink.
+* @param[in]	msvErrorCode		The errorcode to log.
+* @param[in]	msvMessage			The message (nullptr for name of registered errorcode).
+* @see			MsvErrorSink::Log
+******************************************************************************************************/
+#define MSV_SINK_LOG(msvSink, msvErrorCode, msvMessage) (msvSink).Log(msvErrorCode, __FILE__, __LINE__, msvMessage)
+
+
+#endif // !MARSTECH_ERROR_SINK_H
+
+/** @} */	//End of group MPLS.
@@ -38,21 +38,198 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 #define MARSTECH_EXCEPTION_H
 
 
-#include "MsvError.h"
+#include "msverror.h"
+#include "msverrorcodes.h"
+#include "msvinlinestring.h"
+#include "msvmemoryresource.h"
+#include "msvtimestamp.h"
+
+#ifdef MSV_EXCEPTION_STACK_TRACE
+/**************************************************************************************************//**
+* @def			MSV_EXCEPTION_STACK_TRACE
+* @brief			Capture stack traces.
+* @details		When defined, @ref MsvException captures raw return addresses on throw (see
+*					@ref MsvException::GetStackTrace). It must be defined (or not) in all translation units.
+******************************************************************************************************/
+#include "msvstacktrace.h"
+#endif
 
 MSV_DISABLE_ALL_WARNINGS
 
+#include <atomic>
 #include <exception>
 #include <chrono>
-#include <sstream>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
 
 MSV_ENABLE_WARNINGS
 
 
+#if !defined(MSV_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)
+/**************************************************************************************************//**
+* @def			MSV_NO_EXCEPTIONS
+* @brief			Exception free mode.
+* @details		Defined automatically when exceptions are disabled (-fno-exceptions, /EHs-c-) or it can be
+*					defined explicitly. @ref MSV_THROW, @ref MSV_RETHROW, @ref MSV_THROW_FAILED (and
+*					@ref MSV_VALUE_OR_THROW) do not throw then - they pass @ref MsvException to failure handler
+*					(see @ref MsvSetFailureHandler) or return errorcode when @ref MSV_NO_EXCEPTIONS_RETURN is
+*					defined. It must be the same in all translation units.
+******************************************************************************************************/
+#define MSV_NO_EXCEPTIONS
+#endif
+
+#if defined(MSV_NO_EXCEPTIONS_RETURN) && !defined(MSV_NO_EXCEPTIONS)
+/**************************************************************************************************//**
+* @def			MSV_NO_EXCEPTIONS_RETURN
+* @brief			Exception free mode with returns.
+* @details		Throw macros return (call return of current function/method) @ref MsvFailure with errorcode
+*					instead of calling failure handler - current function/method must return @ref MsvErrorCode
+*					or @ref MsvResult. It implies @ref MSV_NO_EXCEPTIONS.
+******************************************************************************************************/
+#define MSV_NO_EXCEPTIONS
+#endif
+
+
+#ifndef MSV_EXCEPTION_MESSAGE_SIZE
+/**************************************************************************************************//**
+* @def			MSV_EXCEPTION_MESSAGE_SIZE
+* @brief			Inline message size.
+* @details		Size of @ref MsvException inline buffer for messages of inline frames (including terminating
+*					zeros). Frames with longer messages are moved to the heap. Define it before including this
+*					header to change it (it must be same in all translation units).
+* @see			MSV_EXCEPTION_INLINE_FRAMES
+******************************************************************************************************/
+#define MSV_EXCEPTION_MESSAGE_SIZE 128
+#endif // !MSV_EXCEPTION_MESSAGE_SIZE
+
+#ifndef MSV_EXCEPTION_INLINE_FRAMES
+/**************************************************************************************************//**
+* @def			MSV_EXCEPTION_INLINE_FRAMES
+* @brief			Inline frames count.
+* @details		Count of frames (throw and rethrows) which @ref MsvException stores inline. Next frames
+*					are moved to the heap. Define it before including this header to change it (it must be same
+*					in all translation units).
+* @see			MSV_EXCEPTION_MESSAGE_SIZE
+******************************************************************************************************/
+#define MSV_EXCEPTION_INLINE_FRAMES 4
+#endif // !MSV_EXCEPTION_INLINE_FRAMES
+
+#ifndef MSV_EXCEPTION_ALLOCATION_MESSAGE_SIZE
+/**************************************************************************************************//**
+* @def			MSV_EXCEPTION_ALLOCATION_MESSAGE_SIZE
+* @brief			Allocation error message size.
+* @details		Maximal size (including terminating zero) of message of frame with MSV_ALLOCATION_ERROR.
+*					These frames never allocate - they are always stored inline and their messages are truncated
+*					to this size, so the inline buffer is not exhausted by one frame and rethrows still fit.
+*					Define it before including this header to change it (it must be same in all translation
+*					units).
+* @see			MSV_EXCEPTION_MESSAGE_SIZE
+******************************************************************************************************/
+#define MSV_EXCEPTION_ALLOCATION_MESSAGE_SIZE (MSV_EXCEPTION_MESSAGE_SIZE / MSV_EXCEPTION_INLINE_FRAMES)
+#endif // !MSV_EXCEPTION_ALLOCATION_MESSAGE_SIZE
+
+#ifndef MSV_EXCEPTION_WHAT_SIZE
+/**************************************************************************************************//**
+* @def			MSV_EXCEPTION_WHAT_SIZE
+* @brief			Inline what size.
+* @details		Size of @ref MsvException inline buffer for formatted message (including terminating zero).
+*					Longer formatted messages are moved to the heap. Define it before including this header to
+*					change it (it must be same in all translation units).
+******************************************************************************************************/
+#define MSV_EXCEPTION_WHAT_SIZE 256
+#endif // !MSV_EXCEPTION_WHAT_SIZE
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech exception frame.
+* @details	Information about one (re)throw of @ref MsvException. The first frame is the throw, next frames
+*				are rethrows (the last frame is the latest rethrow).
+* @see		MsvException::GetFrame
+******************************************************************************************************/
+struct MsvExceptionFrame
+{
+	/**************************************************************************************************//**
+	* @brief		Errorcode set by (re)throw.
+	******************************************************************************************************/
+	MsvErrorCode errorCode;
+
+	/**************************************************************************************************//**
+	* @brief		Filename where exception has been (re)thrown.
+	* @warning	Only pointer is stored (it is usually __FILE__). It must be valid for the exception lifetime.
+	******************************************************************************************************/
+	const char* fileName;
+
+	/**************************************************************************************************//**
+	* @brief		Line number where exception has been (re)thrown.
+	******************************************************************************************************/
+	int line;
+
+	/**************************************************************************************************//**
+	* @brief		Timestamp when exception has been (re)thrown.
+	* @details	Raw monotonic ticks - convert them by @ref MsvTimestampToSystemTime or
+	*				@ref MsvTimestampElapsed (or use @ref MsvException::GetFrameTime and
+	*				@ref MsvException::GetFrameElapsed).
+	******************************************************************************************************/
+	MsvTimestamp timestamp;
+
+	/**************************************************************************************************//**
+	* @brief		Message set by (re)throw.
+	* @details	Zero terminated message owned by exception.
+	******************************************************************************************************/
+	const char* message;
+};
+
+/**************************************************************************************************//**
+* @brief		MarsTech exception frame node.
+* @details	Heap stored @ref MsvExceptionFrame (frames which do not fit to @ref MsvException inline
+*				storage). Nodes are linked from the latest frame to older frames. Message is stored right
+*				after the node (in the same allocation).
+* @note		Nodes are immutable and reference counted - they are shared by copies of @ref MsvException
+*				and each node holds reference to its previous node.
+* @see		MSV_EXCEPTION_INLINE_FRAMES
+******************************************************************************************************/
+struct MsvExceptionFrameNode
+{
+	/**************************************************************************************************//**
+	* @brief		Reference counter.
+	* @details	Count of exceptions and newer nodes which reference this node.
+	******************************************************************************************************/
+	std::atomic<std::size_t> references;
+
+	/**************************************************************************************************//**
+	* @brief		Stored frame.
+	******************************************************************************************************/
+	MsvExceptionFrame frame;
+
+	/**************************************************************************************************//**
+	* @brief		Previous (older) heap stored frame or nullptr.
+	******************************************************************************************************/
+	MsvExceptionFrameNode* previous;
+};
+
+
 /**************************************************************************************************//**
 * @brief		MarsTech exception.
 * @details	Exception which stores @ref MsvErrorCode and message. It can be rethrown with new message
-*				and new errorCode. Original message and errorCode will be stored too.
+*				and new errorCode. Original message and errorCode will be stored too - each (re)throw is
+*				stored as structured @ref MsvExceptionFrame.
+* @note		First frames with short messages are stored in inline buffers - throwing exception does not
+*				allocate any heap memory then. Next frames are stored in heap nodes, adding a frame is O(1).
+* @note		When heap allocation fails, messages are truncated.
+* @note		Heap storage is allocated from memory resource of exceptions (@ref MsvGetExceptionMemoryResource,
+*				thread local recycling pool by default).
+* @note		Copying and moving never allocates - inline storage is copied and heap stored frames (and long
+*				formatted message) are shared.
+* @note		Const methods (including @ref what) can be called concurrently on the same instance (e.g. exception
+*				rethrown from std::exception_ptr in several threads). Rethrowing, assigning and moving must not
+*				race with other use of the instance.
+* @see		MSV_EXCEPTION_MESSAGE_SIZE
+* @see		MSV_EXCEPTION_INLINE_FRAMES
+* @see		MSV_EXCEPTION_WHAT_SIZE
 * @see		MsvErrorCode
 * @see		MSV_THROW
 * @see		MSV_RETHROW
@@ -73,36 +250,121 @@ public:
 	* @see			MSV_THROW_FAILED
 	******************************************************************************************************/
 	MsvException(const char* fileName, int line, MsvErrorCode errorCode, const char* msg) :
-		std::exception()
+		std::exception(),
+		m_errorCode(errorCode),
+		m_frameCount(0),
+		m_inlineFrameCount(0),
+		m_messagesLength(0),
+		m_lastNode(nullptr),
+		m_formattedFrames(0)
 	{
-		m_errorCode = errorCode;
-		
-		std::stringstream data;
-		data << std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()) << " 0x" << std::setfill('0') << std::setw(8) << errorCode << " " << fileName << ":" << line << " " << msg << std::endl;
-		m_what = data.str();
+		MSV_ERROR_HOOK(errorCode, fileName, line)
+		AddFrame(fileName, line, errorCode, msg);
+
+#ifdef MSV_EXCEPTION_STACK_TRACE
+		m_stackTrace.Capture();
+#endif
+	}
+
+#ifdef MSV_EXCEPTION_STACK_TRACE
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates exception with already captured stack trace (@ref MsvThrow captures it, so the trace
+	*					starts at the throw site).
+	* @param[in]	fileName		Filename where exception has been thrown.
+	* @param[in]	line			Line number where exception has been thrown.
+	* @param[in]	errorCode	The errorcode to set to the exception.
+	* @param[in]	msg			Message to set to the exception.
+	* @param[in]	stackTrace	Stack trace of the throw.
+	* @see			MSV_THROW
+	******************************************************************************************************/
+	MsvException(const char* fileName, int line, MsvErrorCode errorCode, const char* msg, const MsvStackTrace& stackTrace) :
+		std::exception(),
+		m_errorCode(errorCode),
+		m_frameCount(0),
+		m_inlineFrameCount(0),
+		m_messagesLength(0),
+		m_lastNode(nullptr),
+		m_formattedFrames(0),
+		m_stackTrace(stackTrace)
+	{
+		MSV_ERROR_HOOK(errorCode, fileName, line)
+		AddFrame(fileName, line, errorCode, msg);
 	}
+#endif
 
 	/**************************************************************************************************//**
 	* @brief			Copy constructor.
 	* @param[in]	origin		Original @ref MsvException to be copied.
 	******************************************************************************************************/
-	MsvException(const MsvException& origin) :
+	MsvException(const MsvException& origin) noexcept :
 		std::exception(origin),
 		m_errorCode(origin.m_errorCode),
-		m_what(origin.m_what)
+		m_frameCount(0),
+		m_inlineFrameCount(0),
+		m_messagesLength(0),
+		m_lastNode(nullptr),
+		m_formattedFrames(0)
 	{
-		
+		CopyFrames(origin);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Move constructor.
+	* @param[in]	origin		Original @ref MsvException to be moved. It has no frames after move.
+	******************************************************************************************************/
+	MsvException(MsvException&& origin) noexcept :
+		std::exception(origin),
+		m_errorCode(origin.m_errorCode),
+		m_frameCount(0),
+		m_inlineFrameCount(0),
+		m_messagesLength(0),
+		m_lastNode(nullptr),
+		m_formattedFrames(0)
+	{
+		MoveFrames(origin);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Destructor.
+	******************************************************************************************************/
+	virtual ~MsvException() noexcept override
+	{
+		ReleaseNodes(m_lastNode);
 	}
 
 	/**************************************************************************************************//**
 	* @brief			Assign operator.
 	* @param[in]	origin		Original @ref MsvException to be assigned.
 	******************************************************************************************************/
-	MsvException& operator= (const MsvException& origin)
+	MsvException& operator= (const MsvException& origin) noexcept
+	{
+		if (this != &origin)
+		{
+			std::exception::operator=(origin);
+			m_errorCode = origin.m_errorCode;
+			ReleaseNodes(m_lastNode);
+			CopyFrames(origin);
+		}
+
+		return *this;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Move assign operator.
+	* @param[in]	origin		Original @ref MsvException to be moved. It has no frames after move.
+	******************************************************************************************************/
+	MsvException& operator= (MsvException&& origin) noexcept
 	{
-		std::exception::operator=(origin);
-		m_errorCode = origin.m_errorCode;
-		m_what = origin.m_what;
+		if (this != &origin)
+		{
+			std::exception::operator=(origin);
+			m_errorCode = origin.m_errorCode;
+			ReleaseNodes(m_lastNode);
+			MoveFrames(origin);
+		}
+
+		return *this;
 	}
 
 	/**************************************************************************************************//**
@@ -110,27 +372,118 @@ public:
 	* @details	Returns the last set errorcode.
 	* @returns	MsvErrorCode		The last errorcode set to the exception.
 	******************************************************************************************************/
-	MsvErrorCode GetErrorCode()
+	MsvErrorCode GetErrorCode() const noexcept
 	{
 		return m_errorCode;
 	}
 
+#ifdef MSV_EXCEPTION_STACK_TRACE
+	/**************************************************************************************************//**
+	* @brief			Get stack trace.
+	* @details		Returns raw return addresses captured where exception has been thrown. They are symbolized
+	*					when the trace is formatted (@ref MsvStackTrace::ToString).
+	* @returns		const MsvStackTrace&		Captured stack trace.
+	******************************************************************************************************/
+	const MsvStackTrace& GetStackTrace() const noexcept
+	{
+		return m_stackTrace;
+	}
+#endif
+
+	/**************************************************************************************************//**
+	* @brief		Get frame count.
+	* @details	Returns count of stored frames (throw and all rethrows).
+	* @returns	std::size_t		Count of stored frames.
+	* @see		GetFrame
+	******************************************************************************************************/
+	std::size_t GetFrameCount() const noexcept
+	{
+		return m_frameCount;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get frame.
+	* @details		Returns stored frame. Frame 0 is the throw, the last frame is the latest rethrow.
+	* @param[in]	index		Index of frame (must be lower than @ref GetFrameCount).
+	* @returns		MsvExceptionFrame		Stored frame (its message is valid for the exception lifetime).
+	* @note			Inline frames are accessed in O(1), heap stored frames in O(count of newer frames). Use
+	*					@ref ForEachFrame to walk all frames.
+	* @see			GetFrameCount
+	******************************************************************************************************/
+	MsvExceptionFrame GetFrame(std::size_t index) const noexcept
+	{
+		if (index < m_inlineFrameCount)
+		{
+			return m_frames[index];
+		}
+
+		const MsvExceptionFrameNode* node = m_lastNode;
+		for (std::size_t frameIndex = m_frameCount - 1; frameIndex > index; --frameIndex)
+		{
+			node = node->previous;
+		}
+
+		return node->frame;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			For each frame.
+	* @details		Calls visitor for all stored frames from the throw (frame 0) to the latest rethrow.
+	* @param[in]	visitor		Callable with const MsvExceptionFrame& parameter.
+	* @note			Walking all frames is linear (up to a log32 factor for very long chains) and it does not
+	*					allocate.
+	* @see			GetFrame
+	******************************************************************************************************/
+	template<typename Visitor>
+	void ForEachFrame(Visitor&& visitor) const
+	{
+		for (std::size_t index = 0; index < m_inlineFrameCount; ++index)
+		{
+			visitor(static_cast<const MsvExceptionFrame&>(m_frames[index]));
+		}
+
+		VisitNodes(m_lastNode, m_frameCount - m_inlineFrameCount, visitor);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get frame time.
+	* @details		Returns system (wall-clock) time when the frame has been (re)thrown.
+	* @param[in]	index		Index of frame (must be lower than @ref GetFrameCount).
+	* @returns		std::chrono::system_clock::time_point		Time of the frame.
+	* @see			MsvTimestampToSystemTime
+	******************************************************************************************************/
+	std::chrono::system_clock::time_point GetFrameTime(std::size_t index) const noexcept
+	{
+		return MsvTimestampToSystemTime(GetFrame(index).timestamp);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get frame elapsed time.
+	* @details		Returns time elapsed between the throw (frame 0) and the frame.
+	* @param[in]	index		Index of frame (must be lower than @ref GetFrameCount).
+	* @returns		std::chrono::nanoseconds		Time elapsed since the throw.
+	* @see			MsvTimestampElapsed
+	******************************************************************************************************/
+	std::chrono::nanoseconds GetFrameElapsed(std::size_t index) const noexcept
+	{
+		return MsvTimestampElapsed(GetFrame(0).timestamp, GetFrame(index).timestamp);
+	}
+
 	/**************************************************************************************************//**
 	* @brief			Rethrowing info.
-	* @details		Stores new line to message and sets new errorcode. It is automatically called by @ref MSV_RETHROW.
+	* @details		Stores new frame and sets new errorcode. It is automatically called by @ref MSV_RETHROW.
 	* @param[in]	fileName		Filename where exception has been thrown.
 	* @param[in]	line			Line number where exception has been thrown.
 	* @param[in]	errorCode	The errorcode to set to the exception.
 	* @param[in]	msg			Message to set to the exception.
+	* @note			Adding a frame is O(1) - nothing is formatted or copied.
 	* @see			MSV_RETHROW
 	******************************************************************************************************/
 	void Rethrowing(const char* fileName, int line, MsvErrorCode errorCode, const char* msg)
 	{
+		MSV_ERROR_HOOK(errorCode, fileName, line)
 		m_errorCode = errorCode;
-		
-		std::stringstream data;
-		data << m_what << std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()) << " 0x" << std::setfill('0') << std::setw(8) << errorCode << " " << fileName << ":" << line << " " << msg << std::endl;
-		m_what = data.str();
+		AddFrame(fileName, line, errorCode, msg);
 	}
 
 	/**************************************************************************************************//**
@@ -138,14 +491,329 @@ public:
 	* @details	Returns formatted message what happened.
 	* @returns	cont char*		Formatted message what happened.
 	* @note		One line format: &lt;time&gt; &lt;hex_errorcode&gt; &lt;fileName&gt;:&lt;linenumber&gt; &lt;message&gt;
+	* @note		Frames are formatted on the first call and cached (next calls format only newly added frames).
+	*				If formatting fails (out of memory), formatted message is truncated.
+	* @note		It is thread safe - concurrent calls format frames only once.
 	* @see		m_what
 	******************************************************************************************************/
 	virtual const char* what() const noexcept override
 	{
-		return m_what.c_str();
+		if (m_formattedFrames.load(std::memory_order_acquire) != m_frameCount)
+		{
+			FormatFrames();
+		}
+
+		return m_what.GetString();
 	}
 
 protected:
+	/**************************************************************************************************//**
+	* @brief			Add frame.
+	* @details		Stores frame inline (when there is free inline frame and the message fits to inline
+	*					buffer) or to a new heap node.
+	* @param[in]	fileName		Filename where exception has been (re)thrown.
+	* @param[in]	line			Line number where exception has been (re)thrown.
+	* @param[in]	errorCode	The errorcode set by (re)throw.
+	* @param[in]	msg			Message set by (re)throw.
+	* @note			When heap allocation fails, message is truncated to free space of inline buffer. When there
+	*					is no free inline frame, frame is lost (errorcode is still set). Frames with
+	*					MSV_ALLOCATION_ERROR never allocate (memory is exhausted) - they are stored inline only
+	*					and their messages are truncated to MSV_EXCEPTION_ALLOCATION_MESSAGE_SIZE.
+	******************************************************************************************************/
+	void AddFrame(const char* fileName, int line, MsvErrorCode errorCode, const char* msg) noexcept
+	{
+		if (!msg)
+		{
+			msg = "";
+		}
+
+		std::size_t length = std::strlen(msg);
+		bool allocationError = errorCode == MSV_ALLOCATION_ERROR;
+		MsvExceptionFrame frame = { errorCode, fileName, line, MsvTimestampNow(), nullptr };
+		bool inlineFrame = m_inlineFrameCount == m_frameCount && m_inlineFrameCount < MSV_EXCEPTION_INLINE_FRAMES;
+
+		if (!inlineFrame || m_messagesLength + length + 1 > MSV_EXCEPTION_MESSAGE_SIZE)
+		{
+			if (MsvExceptionFrameNode* node = allocationError ? nullptr : AllocateNode(frame, msg, length))
+			{
+				node->previous = m_lastNode;
+				m_lastNode = node;
+				++m_frameCount;
+				return;
+			}
+
+			if (!inlineFrame || m_messagesLength >= MSV_EXCEPTION_MESSAGE_SIZE)
+			{
+				return;
+			}
+		}
+
+		frame.message = StoreInlineMessage(msg, length, allocationError ? MSV_EXCEPTION_ALLOCATION_MESSAGE_SIZE : MSV_EXCEPTION_MESSAGE_SIZE);
+		m_frames[m_inlineFrameCount++] = frame;
+		++m_frameCount;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Store inline message.
+	* @details		Copies message to the free space of inline buffer. Message is truncated (with "..." mark)
+	*					when it does not fit.
+	* @param[in]	msg			Message to store.
+	* @param[in]	length		Length of message.
+	* @param[in]	maxSize		Maximal size of stored message (including terminating zero).
+	* @returns		const char*		Stored zero terminated message.
+	******************************************************************************************************/
+	const char* StoreInlineMessage(const char* msg, std::size_t length, std::size_t maxSize) noexcept
+	{
+		char* message = m_messages + m_messagesLength;
+		std::size_t freeSpace = MSV_EXCEPTION_MESSAGE_SIZE - m_messagesLength;
+		freeSpace = (maxSize < freeSpace ? maxSize : freeSpace) - 1;
+
+		if (length > freeSpace)
+		{
+			length = freeSpace;
+			std::memcpy(message, msg, length);
+			std::memset(message + length - (length < 3 ? length : 3), '.', length < 3 ? length : 3);
+		}
+		else
+		{
+			std::memcpy(message, msg, length);
+		}
+
+		message[length] = '\0';
+		m_messagesLength += length + 1;
+
+		return message;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Allocate node.
+	* @details		Allocates heap node for frame and copies message to it.
+	* @param[in]	frame			Frame to store (its message is ignored).
+	* @param[in]	msg			Message to store.
+	* @param[in]	length		Length of message.
+	* @returns		MsvExceptionFrameNode*		Allocated node (not linked) or nullptr when allocation failed.
+	******************************************************************************************************/
+	static MsvExceptionFrameNode* AllocateNode(const MsvExceptionFrame& frame, const char* msg, std::size_t length) noexcept
+	{
+		void* memory = MsvAllocateExceptionMemory(sizeof(MsvExceptionFrameNode) + length + 1);
+		if (!memory)
+		{
+			return nullptr;
+		}
+
+		MsvExceptionFrameNode* node = new (memory) MsvExceptionFrameNode();
+		char* message = reinterpret_cast<char*>(node + 1);
+		std::memcpy(message, msg, length);
+		message[length] = '\0';
+
+		node->references.store(1, std::memory_order_relaxed);
+		node->frame = frame;
+		node->frame.message = message;
+		node->previous = nullptr;
+
+		return node;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Copy frames.
+	* @details		Copies inline frames and shares heap stored frames and formatted message with origin.
+	* @param[in]	origin		Original @ref MsvException to copy frames from.
+	* @warning		Current heap nodes must be released before.
+	******************************************************************************************************/
+	void CopyFrames(const MsvException& origin) noexcept
+	{
+		std::memcpy(m_messages, origin.m_messages, origin.m_messagesLength);
+		m_messagesLength = origin.m_messagesLength;
+
+		for (std::size_t index = 0; index < origin.m_inlineFrameCount; ++index)
+		{
+			m_frames[index] = origin.m_frames[index];
+			m_frames[index].message = m_messages + (origin.m_frames[index].message - origin.m_messages);
+		}
+		m_inlineFrameCount = origin.m_inlineFrameCount;
+		m_frameCount = origin.m_frameCount;
+
+		m_lastNode = origin.m_lastNode;
+		if (m_lastNode)
+		{
+			m_lastNode->references.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		//formatted message is complete (and not written anymore) only when all frames are formatted
+		if (origin.m_formattedFrames.load(std::memory_order_acquire) == origin.m_frameCount)
+		{
+			m_what = origin.m_what;
+			m_formattedFrames.store(origin.m_frameCount, std::memory_order_relaxed);
+		}
+		else
+		{
+			m_what.Clear();
+			m_formattedFrames.store(0, std::memory_order_relaxed);
+		}
+
+#ifdef MSV_EXCEPTION_STACK_TRACE
+		m_stackTrace = origin.m_stackTrace;
+#endif
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Move frames.
+	* @details		Copies inline frames and takes heap stored frames and formatted message from origin.
+	*					Origin has no frames then.
+	* @param[in]	origin		Original @ref MsvException to move frames from.
+	* @warning		Current heap nodes must be released before.
+	******************************************************************************************************/
+	void MoveFrames(MsvException& origin) noexcept
+	{
+		MsvExceptionFrameNode* lastNode = origin.m_lastNode;
+		origin.m_lastNode = nullptr;
+
+		CopyFrames(origin);
+		m_lastNode = lastNode;
+		if (m_formattedFrames.load(std::memory_order_relaxed))
+		{
+			m_what = std::move(origin.m_what);
+		}
+
+		origin.m_frameCount = 0;
+		origin.m_inlineFrameCount = 0;
+		origin.m_messagesLength = 0;
+		origin.m_formattedFrames.store(0, std::memory_order_relaxed);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Release nodes.
+	* @details		Releases reference to heap node. Frees it (and releases older nodes) when it was the last
+	*					reference.
+	* @param[in]	node		The latest heap node to release (can be nullptr).
+	******************************************************************************************************/
+	static void ReleaseNodes(MsvExceptionFrameNode* node) noexcept
+	{
+		while (node && node->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			MsvExceptionFrameNode* previous = node->previous;
+			node->~MsvExceptionFrameNode();
+			MsvFreeExceptionMemory(node);
+			node = previous;
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Format frames.
+	* @details	Appends all not yet formatted frames to @ref m_what. Only one thread formats - it marks
+	*				@ref m_formattedFrames by @ref FormattingFrames, other threads wait until formatted frames are
+	*				published.
+	* @see		m_what
+	* @see		m_formattedFrames
+	******************************************************************************************************/
+	void FormatFrames() const noexcept
+	{
+		std::size_t formatted = m_formattedFrames.load(std::memory_order_acquire);
+		while (formatted != m_frameCount)
+		{
+			if (formatted == FormattingFrames)
+			{
+				std::this_thread::yield();
+				formatted = m_formattedFrames.load(std::memory_order_acquire);
+			}
+			else if (m_formattedFrames.compare_exchange_weak(formatted, FormattingFrames, std::memory_order_acquire))
+			{
+				std::size_t index = formatted;
+				for (; index < m_inlineFrameCount; ++index)
+				{
+					FormatFrame(m_frames[index]);
+				}
+
+				auto formatFrame = [this](const MsvExceptionFrame& frame) noexcept { FormatFrame(frame); };
+				VisitNodes(m_lastNode, m_frameCount - index, formatFrame);
+				m_formattedFrames.store(m_frameCount, std::memory_order_release);
+				return;
+			}
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Visit nodes.
+	* @details		Calls visitor for frames of the given count of the latest heap nodes (from the oldest). Nodes
+	*					are linked from the latest one, so up to @ref VisitedNodes nodes are collected to local array
+	*					and visited backwards. Longer chains are split to @ref VisitedNodes segments which are visited
+	*					the same way (from the oldest segment) - recursion depth and count of walks through the chain
+	*					are log32(count), e.g. 3 for 32768 nodes.
+	* @param[in]	node			The latest heap node.
+	* @param[in]	count			Count of nodes to visit.
+	* @param[in]	visitor		Callable with const MsvExceptionFrame& parameter.
+	******************************************************************************************************/
+	template<typename Visitor>
+	static void VisitNodes(const MsvExceptionFrameNode* node, std::size_t count, Visitor& visitor)
+	{
+		const MsvExceptionFrameNode* nodes[VisitedNodes];
+
+		if (count <= VisitedNodes)
+		{
+			std::size_t stored = 0;
+			for (; node && stored < count; node = node->previous)
+			{
+				nodes[stored++] = node;
+			}
+
+			while (stored)
+			{
+				visitor(static_cast<const MsvExceptionFrame&>(nodes[--stored]->frame));
+			}
+
+			return;
+		}
+
+		//the latest node of each segment (the oldest segment can be shorter)
+		std::size_t segmentSize = (count + VisitedNodes - 1) / VisitedNodes;
+		std::size_t segmentCount = 0;
+		for (std::size_t index = 0; node && index < count; ++index, node = node->previous)
+		{
+			if (index % segmentSize == 0)
+			{
+				nodes[segmentCount++] = node;
+			}
+		}
+
+		while (segmentCount)
+		{
+			--segmentCount;
+			std::size_t newerCount = segmentCount * segmentSize;
+			VisitNodes(nodes[segmentCount], count - newerCount < segmentSize ? count - newerCount : segmentSize, visitor);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Format frame.
+	* @details		Appends one formatted line to @ref m_what.
+	* @param[in]	frame		Frame to format.
+	* @note			One line format: &lt;time&gt; &lt;hex_errorcode&gt; &lt;fileName&gt;:&lt;linenumber&gt; &lt;message&gt;
+	******************************************************************************************************/
+	void FormatFrame(const MsvExceptionFrame& frame) const noexcept
+	{
+		m_what.AppendDecimal(std::chrono::system_clock::to_time_t(MsvTimestampToSystemTime(frame.timestamp)));
+		m_what.Append(" 0x");
+		m_what.AppendDecimal(frame.errorCode, 8, '0');
+		m_what.AppendChar(' ');
+		m_what.Append(frame.fileName);
+		m_what.AppendChar(':');
+		m_what.AppendDecimal(frame.line);
+		m_what.AppendChar(' ');
+		m_what.Append(frame.message);
+		m_what.AppendChar('\n');
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Formatting frames mark.
+	* @details	Value of @ref m_formattedFrames while a thread formats frames.
+	******************************************************************************************************/
+	static constexpr std::size_t FormattingFrames = static_cast<std::size_t>(-1);
+
+	/**************************************************************************************************//**
+	* @brief		Count of heap nodes visited from local array (see @ref VisitNodes).
+	******************************************************************************************************/
+	static constexpr std::size_t VisitedNodes = 32;
+
 	/**************************************************************************************************//**
 	* @brief		Stored errorcode.
 	* @details	The last stored errorcode. Can be accessed by @ref GetErrorCode method.
@@ -155,40 +823,227 @@ protected:
 	MsvErrorCode m_errorCode;
 
 	/**************************************************************************************************//**
-	* @brief		Stored message/messages.
-	* @details	Holds all errorcodes and messages in formatted line by line string.
+	* @brief		Frame count.
+	* @details	Count of all stored frames (inline and heap stored).
+	******************************************************************************************************/
+	std::size_t m_frameCount;
+
+	/**************************************************************************************************//**
+	* @brief		Inline frame count.
+	* @details	Count of frames stored in @ref m_frames. These are always the oldest frames.
+	******************************************************************************************************/
+	std::size_t m_inlineFrameCount;
+
+	/**************************************************************************************************//**
+	* @brief		Inline frames.
+	* @details	The oldest frames (their messages are stored in @ref m_messages).
+	* @see		MSV_EXCEPTION_INLINE_FRAMES
+	******************************************************************************************************/
+	MsvExceptionFrame m_frames[MSV_EXCEPTION_INLINE_FRAMES];
+
+	/**************************************************************************************************//**
+	* @brief		Inline messages.
+	* @details	Zero terminated messages of inline frames stored one after another.
+	* @see		MSV_EXCEPTION_MESSAGE_SIZE
+	******************************************************************************************************/
+	char m_messages[MSV_EXCEPTION_MESSAGE_SIZE];
+
+	/**************************************************************************************************//**
+	* @brief		Inline messages length.
+	* @details	Used length of @ref m_messages (including terminating zeros).
+	******************************************************************************************************/
+	std::size_t m_messagesLength;
+
+	/**************************************************************************************************//**
+	* @brief		The latest heap stored frame.
+	* @details	Frames which do not fit to inline storage (nullptr when there are no such frames). Nodes are
+*				shared with copies of this exception.
+	******************************************************************************************************/
+	MsvExceptionFrameNode* m_lastNode;
+
+	/**************************************************************************************************//**
+	* @brief		Formatted message/messages.
+	* @details	Holds all errorcodes and messages in formatted line by line string. It is formatted lazily
+	*				(by @ref what).
 	* @note		One line format: &lt;time&gt; &lt;hex_errorcode&gt; &lt;fileName&gt;:&lt;linenumber&gt; &lt;message&gt;
+	* @see		FormatFrames
+	* @see		MSV_EXCEPTION_WHAT_SIZE
 	******************************************************************************************************/
-	std::string m_what;
+	mutable MsvInlineString<MSV_EXCEPTION_WHAT_SIZE> m_what;
+
+	/**************************************************************************************************//**
+	* @brief		Formatted frames count.
+	* @details	Count of frames which have been already formatted to @ref m_what (@ref FormattingFrames while
+	*				they are being formatted). It publishes formatted message to other threads.
+	******************************************************************************************************/
+	mutable std::atomic<std::size_t> m_formattedFrames;
+
+#ifdef MSV_EXCEPTION_STACK_TRACE
+	/**************************************************************************************************//**
+	* @brief		Stack trace.
+	* @details	Return addresses captured by @ref MsvThrow (from the throw site) or by constructor (rethrows share it).
+	******************************************************************************************************/
+	MsvStackTrace m_stackTrace;
+#endif
 };
 
 
+/**************************************************************************************************//**
+* @brief		Failure handler.
+* @details	Called with exception which would be thrown in exception free mode (@ref MSV_NO_EXCEPTIONS). It
+*				must not return (it should terminate) - process is aborted when it returns. Do not jump out of it
+*				(longjmp) - destructor of the exception would be skipped (heap stored frames leak).
+* @see		MsvSetFailureHandler
+******************************************************************************************************/
+typedef void (*MsvFailureHandler)(const MsvException& exception);
+
+/**************************************************************************************************//**
+* @brief			Get failure handler storage.
+* @returns		std::atomic<MsvFailureHandler>&		Installed failure handler (nullptr for default one).
+******************************************************************************************************/
+inline std::atomic<MsvFailureHandler>& MsvGetFailureHandlerStorage() noexcept
+{
+	static std::atomic<MsvFailureHandler> handler(nullptr);
+
+	return handler;
+}
+
+/**************************************************************************************************//**
+* @brief			Set failure handler.
+* @details		Installs handler of failures in exception free mode (@ref MSV_NO_EXCEPTIONS). Default handler
+*					writes formatted exception (@ref MsvException::what) to stderr and aborts.
+* @param[in]	handler		New failure handler or nullptr for default one.
+* @returns		MsvFailureHandler		Previous failure handler (nullptr for default one).
+******************************************************************************************************/
+inline MsvFailureHandler MsvSetFailureHandler(MsvFailureHandler handler) noexcept
+{
+	return MsvGetFailureHandlerStorage().exchange(handler, std::memory_order_acq_rel);
+}
+
+/**************************************************************************************************//**
+* @brief			Raise exception.
+* @details		Throws the exception or passes it to failure handler in exception free mode
+*					(@ref MSV_NO_EXCEPTIONS). It never returns.
+* @param[in]	exception		Exception to raise.
+* @see			MsvSetFailureHandler
+******************************************************************************************************/
+[[noreturn]] MSV_NOINLINE inline void MsvRaise(const MsvException& exception)
+{
+#ifdef MSV_NO_EXCEPTIONS
+	if (MsvFailureHandler handler = MsvGetFailureHandlerStorage().load(std::memory_order_acquire))
+	{
+		handler(exception);
+	}
+
+	std::fputs(exception.what(), stderr);
+	std::fflush(stderr);
+	std::abort();
+#else
+	throw exception;
+#endif
+}
+
+
+/**************************************************************************************************//**
+* @brief			Throw exception.
+* @details		Constructs and throws @ref MsvException (or raises it in exception free mode). It is out of
+*					line and cold, so throw sites are just a call (construction is not inlined to hot functions).
+* @param[in]	fileName		Filename where exception is thrown.
+* @param[in]	line			Line number where exception is thrown.
+* @param[in]	errorCode	The errorcode to set to the exception.
+* @param[in]	msg			Message to set to the exception.
+* @see			MSV_THROW
+******************************************************************************************************/
+[[noreturn]] MSV_NOINLINE MSV_COLD inline void MsvThrow(const char* fileName, int line, MsvErrorCode errorCode, const char* msg)
+{
+#if defined(MSV_EXCEPTION_STACK_TRACE)
+	//captured here (skipping this function), so the trace starts at the throw site
+	MsvStackTrace stackTrace;
+	stackTrace.Capture(1);
+
+#ifdef MSV_NO_EXCEPTIONS
+	MsvRaise(MsvException(fileName, line, errorCode, msg, stackTrace));
+#else
+	throw MsvException(fileName, line, errorCode, msg, stackTrace);
+#endif
+#elif defined(MSV_NO_EXCEPTIONS)
+	MsvRaise(MsvException(fileName, line, errorCode, msg));
+#else
+	throw MsvException(fileName, line, errorCode, msg);
+#endif
+}
+
+/**************************************************************************************************//**
+* @brief			Rethrow exception.
+* @details		Adds frame to the exception and throws it (or raises it in exception free mode). It is out of
+*					line and cold.
+* @param[in]	exception	Exception to rethrow.
+* @param[in]	fileName		Filename where exception is rethrown.
+* @param[in]	line			Line number where exception is rethrown.
+* @param[in]	errorCode	The errorcode to set to the exception.
+* @param[in]	msg			Message to set to the exception.
+* @see			MSV_RETHROW
+******************************************************************************************************/
+[[noreturn]] MSV_NOINLINE MSV_COLD inline void MsvRethrow(MsvException& exception, const char* fileName, int line, MsvErrorCode errorCode, const char* msg)
+{
+	exception.Rethrowing(fileName, line, errorCode, msg);
+	MsvRaise(exception);
+}
+
+
+#if defined(MSV_NO_EXCEPTIONS_RETURN)
+#define MSV_THROW(msvErrorCode, msvMessage) \
+{ \
+	MsvErrorCode msvErrT = (msvErrorCode); \
+	MSV_ERROR_HOOK(msvErrT, __FILE__, __LINE__) \
+	(void)(msvMessage); \
+	return MsvFailure(msvErrT); \
+}
+
+#define MSV_RETHROW(msvException, msvErrorCode, msvMessage) \
+{ \
+	MsvErrorCode msvErrRT = (msvErrorCode); \
+	msvException.Rethrowing(__FILE__, __LINE__, msvErrRT, msvMessage); \
+	return MsvFailure(msvErrRT); \
+}
+#elif defined(MSV_INLINE_THROW) && !defined(MSV_NO_EXCEPTIONS)
+//inline construction at throw sites (it is the baseline of throw site size report only)
+#define MSV_THROW(msvErrorCode, msvMessage) throw MsvException(__FILE__, __LINE__, msvErrorCode, msvMessage);
+
+#define MSV_RETHROW(msvException, msvErrorCode, msvMessage) \
+msvException.Rethrowing(__FILE__, __LINE__, msvErrorCode, msvMessage); \
+throw msvException;
+#else
 /**************************************************************************************************//**
 * @def			MSV_THROW(msvErrorCode, msg)
 * @brief			Throw @ref MsvException.
-* @details		Throws @ref MsvException with stored errorcode and message.
+* @details		Throws @ref MsvException with stored errorcode and message. The exception is constructed by
+*					cold @ref MsvThrow function - throw site is just a call.
 * @param[in]	msvErrorCode		The errorcode to set to the exception.
 * @param[in]	msvMessage			The message to set to the exception.
 * @see			MsvErrorCode
 * @see			MsvException
+* @note			In exception free mode it calls failure handler (@ref MSV_NO_EXCEPTIONS) or returns errorcode
+*					(@ref MSV_NO_EXCEPTIONS_RETURN - message is not stored then).
 ******************************************************************************************************/
-#define MSV_THROW(msvErrorCode, msvMessage) throw MsvException(__FILE__, __LINE__, msvErrorCode, msvMessage);
+#define MSV_THROW(msvErrorCode, msvMessage) MsvThrow(__FILE__, __LINE__, msvErrorCode, msvMessage);
 
 /**************************************************************************************************//**
 * @def			MSV_RETHROW(msvException, msvErrorCode, msvMessage)
 * @brief			Rehrow @ref MsvException.
-* @details		Sets new message and errorcode (original message and errorcode is stored too) and rehrows @ref MsvException.
+* @details		Sets new message and errorcode (original message and errorcode is stored too) and rehrows @ref MsvException
+*					(by cold @ref MsvRethrow function).
 * @param[in]	msvException		The exception to rethrow.
 * @param[in]	msvErrorCode		The errorcode to set to the exception.
 * @param[in]	msvMessage			The message to set to the exception.
 * @see			MsvErrorCode
 * @see			MsvException
 * @see			MSV_THROW
+* @note			In exception free mode it passes the exception to failure handler (@ref MSV_NO_EXCEPTIONS) or
+*					returns errorcode (@ref MSV_NO_EXCEPTIONS_RETURN).
 ******************************************************************************************************/
-#define MSV_RETHROW(msvException, msvErrorCode, msvMessage) \
-msvException.Rethrowing(__FILE__, __LINE__, msvErrorCode, msvMessage); \
-throw msvException;
-//std::rethrow_exception(std::make_exception_ptr(msvException));
+#define MSV_RETHROW(msvException, msvErrorCode, msvMessage) MsvRethrow(msvException, __FILE__, __LINE__, msvErrorCode, msvMessage);
+#endif
 
 /**************************************************************************************************//**
 * @def			MSV_THROW_FAILED(MsvErrorCodeIn)
@@ -200,15 +1055,22 @@ throw msvException;
 * @see			MsvErrorCode
 * @see			MSV_FAILED
 * @see			MSV_THROW
+* @see			MSV_UNLIKELY
 * @warning		Throws @ref MsvException if failed errorcode is received.
 ******************************************************************************************************/
 #define MSV_THROW_FAILED(msvErrorCode, msvMessage) \
 { \
 	MsvErrorCode msvErrTF = (msvErrorCode); \
-	if (MSV_FAILED(msvErrTF)) { MSV_THROW(msvErrTF, msvMessage); } \
+	if (MSV_UNLIKELY(MSV_FAILED(msvErrTF))) MSV_UNLIKELY_BRANCH { MSV_THROW(msvErrTF, msvMessage); } \
 }
 
 
+#ifdef MSV_NO_EXCEPTIONS_RETURN
+//throw macros return MsvFailure
+#include "msvresult.h"
+#endif
+
+
 #endif // !MARSTECH_EXCEPTION_H
 
 /** @} */	//End of group MPLS.
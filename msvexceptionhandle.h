@@ -0,0 +1,234 @@
+/**************************************************************************************************//**
+* @defgroup		MSVERROR MarsTech Error Handling
+* @brief			MarsTech Error
+* @details		Contains implementation and all definitions of MarsTech Error.
+* @copyright	GNU General Public License (GPLv3).
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Exception Handle
+* @details		Contains movable handle which transfers MsvException between threads.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Error.
+
+MarsTech Error is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Error is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MarsTech Error. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_EXCEPTION_HANDLE_H
+#define MARSTECH_EXCEPTION_HANDLE_H
+
+
+#include "msverrorcodes.h"
+#include "msvexception.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <new>
+#include <utility>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech exception handle.
+* @details	Movable owner of @ref MsvException - lightweight replacement of std::exception_ptr for transfer of
+*				failures from worker threads to requester threads (through futures, queues, ...). Exception is
+*				stored inline in the handle, so capture and moves of the handle never allocate (exception is moved
+*				or copied - heap frames are shared) and errorcode is readable without rethrow. The only allocation
+*				of the transfer is the exception object thrown by @ref Rethrow (it is allocated by C++ runtime).
+* @note		std::make_exception_ptr and std::rethrow_exception allocate twice (exception object and dependent
+*				exception rethrown from it).
+* @see		MsvException
+******************************************************************************************************/
+class MsvExceptionHandle
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates empty handle.
+	******************************************************************************************************/
+	MsvExceptionHandle() noexcept :
+		m_empty(),
+		m_captured(false)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Captures exception (it is moved to the handle).
+	* @param[in]	exception		Exception to capture.
+	******************************************************************************************************/
+	explicit MsvExceptionHandle(MsvException&& exception) noexcept :
+		m_exception(std::move(exception)),
+		m_captured(true)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Captures copy of exception (copy shares heap frames - it does not allocate).
+	* @param[in]	exception		Exception to capture.
+	******************************************************************************************************/
+	explicit MsvExceptionHandle(const MsvException& exception) noexcept :
+		m_exception(exception),
+		m_captured(true)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Move constructor.
+	* @param[in]	origin		Moved handle (it is empty after move).
+	******************************************************************************************************/
+	MsvExceptionHandle(MsvExceptionHandle&& origin) noexcept :
+		m_empty(),
+		m_captured(false)
+	{
+		Take(origin);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Move assignment.
+	* @param[in]	origin		Moved handle (it is empty after move).
+	* @returns		MsvExceptionHandle&		This handle.
+	******************************************************************************************************/
+	MsvExceptionHandle& operator= (MsvExceptionHandle&& origin) noexcept
+	{
+		if (this != &origin)
+		{
+			Reset();
+			Take(origin);
+		}
+
+		return *this;
+	}
+
+	MsvExceptionHandle(const MsvExceptionHandle&) = delete;
+	MsvExceptionHandle& operator= (const MsvExceptionHandle&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Destructor.
+	* @details		Destroys captured exception (if any).
+	******************************************************************************************************/
+	~MsvExceptionHandle()
+	{
+		Reset();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Check handle holds failure.
+	* @retval		true		When exception has been captured.
+	* @retval		false		When handle is empty.
+	******************************************************************************************************/
+	explicit operator bool() const noexcept
+	{
+		return m_captured;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get errorcode.
+	* @returns		MsvErrorCode		Errorcode of captured exception or MSV_SUCCESS when handle is empty.
+	******************************************************************************************************/
+	MsvErrorCode GetErrorCode() const noexcept
+	{
+		return m_captured ? m_exception.GetErrorCode() : MSV_SUCCESS;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get exception.
+	* @returns		const MsvException*		Captured exception or nullptr when handle is empty.
+	******************************************************************************************************/
+	const MsvException* Get() const noexcept
+	{
+		return m_captured ? &m_exception : nullptr;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Rethrow exception.
+	* @details		Throws copy of captured exception (copy does not allocate - C++ runtime allocates only the
+	*					thrown object). In exception free mode it raises exception (see @ref MsvRaise).
+	* @warning		Handle must not be empty.
+	******************************************************************************************************/
+	[[noreturn]] void Rethrow() const
+	{
+#ifdef MSV_NO_EXCEPTIONS
+		MsvRaise(m_exception);
+#else
+		throw m_exception;
+#endif
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Take exception.
+	* @details		Moves exception of origin handle to this empty handle and destroys it in origin handle.
+	* @param[in]	origin		Moved handle (it is empty then).
+	******************************************************************************************************/
+	void Take(MsvExceptionHandle& origin) noexcept
+	{
+		if (origin.m_captured)
+		{
+			new (&m_exception) MsvException(std::move(origin.m_exception));
+			m_captured = true;
+			origin.Reset();
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Reset handle.
+	* @details		Destroys captured exception (if any) - handle is empty then.
+	******************************************************************************************************/
+	void Reset() noexcept
+	{
+		if (m_captured)
+		{
+			m_exception.~MsvException();
+			m_captured = false;
+		}
+	}
+
+	union
+	{
+		/**************************************************************************************************//**
+		* @brief		Empty member (active when there is no captured exception).
+		******************************************************************************************************/
+		char m_empty;
+
+		/**************************************************************************************************//**
+		* @brief		Captured exception (active when @ref m_captured is set).
+		******************************************************************************************************/
+		MsvException m_exception;
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Exception has been captured.
+	******************************************************************************************************/
+	bool m_captured;
+};
+
+
+#endif // !MARSTECH_EXCEPTION_HANDLE_H
+
+/** @} */	//End of group MPLS.
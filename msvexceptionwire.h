@@ -0,0 +1,552 @@
+/**************************************************************************************************//**
+* @defgroup		MSVERROR MarsTech Error Handling
+* @brief			MarsTech Error
+* @details		Contains implementation and all definitions of MarsTech Error.
+* @copyright	GNU General Public License (GPLv3).
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Exception Wire Format
+* @details		Contains compact versioned binary format of MsvException (writer and zero-copy view).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Error.
+
+MarsTech Error is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Error is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MarsTech Error. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_EXCEPTION_WIRE_H
+#define MARSTECH_EXCEPTION_WIRE_H
+
+
+#include "msverrorcodes.h"
+#include "msvexception.h"
+#include "msvtimestamp.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+MSV_ENABLE_WARNINGS
+
+
+/*
+Wire format (version 1, all integers are little-endian):
+
+header (16 bytes):
+	uint8_t		magic[4]				"MSVE"
+	uint8_t		version					1
+	uint8_t		flags						0 (reserved)
+	uint16_t		frameCount				count of frames
+	int32_t		errorCode				the last errorcode of exception
+	uint32_t		size						size of whole encoded exception (header and frames)
+
+frame (20 bytes + strings), frames are stored from the throw to the latest rethrow:
+	int32_t		errorCode				errorcode set by (re)throw
+	int32_t		line						line number
+	int64_t		time						system time in nanoseconds since epoch
+	uint16_t		fileNameLength			filename length (without terminating zero)
+	uint16_t		messageLength			message length (without terminating zero)
+	char			fileName[]				filename and terminating zero
+	char			message[]				message and terminating zero
+*/
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech exception wire frame.
+* @details	One frame read by @ref MsvExceptionView. Strings point to the read buffer (they are zero
+*				terminated).
+******************************************************************************************************/
+struct MsvExceptionWireFrame
+{
+	/**************************************************************************************************//**
+	* @brief		Errorcode set by (re)throw.
+	******************************************************************************************************/
+	MsvErrorCode errorCode;
+
+	/**************************************************************************************************//**
+	* @brief		Line number where exception has been (re)thrown.
+	******************************************************************************************************/
+	int line;
+
+	/**************************************************************************************************//**
+	* @brief		System time when exception has been (re)thrown.
+	******************************************************************************************************/
+	std::chrono::system_clock::time_point time;
+
+	/**************************************************************************************************//**
+	* @brief		Filename where exception has been (re)thrown.
+	******************************************************************************************************/
+	const char* fileName;
+
+	/**************************************************************************************************//**
+	* @brief		Filename length.
+	******************************************************************************************************/
+	std::size_t fileNameLength;
+
+	/**************************************************************************************************//**
+	* @brief		Message set by (re)throw.
+	******************************************************************************************************/
+	const char* message;
+
+	/**************************************************************************************************//**
+	* @brief		Message length.
+	******************************************************************************************************/
+	std::size_t messageLength;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech exception wire format.
+* @details	Constants and little-endian helpers of the binary format (see format description above).
+******************************************************************************************************/
+class MsvExceptionWire
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Format version.
+	******************************************************************************************************/
+	static constexpr uint8_t Version = 1;
+
+	/**************************************************************************************************//**
+	* @brief		Header size.
+	******************************************************************************************************/
+	static constexpr std::size_t HeaderSize = 16;
+
+	/**************************************************************************************************//**
+	* @brief		Frame header size (without strings).
+	******************************************************************************************************/
+	static constexpr std::size_t FrameHeaderSize = 20;
+
+	/**************************************************************************************************//**
+	* @brief		Maximal string length (longer strings are truncated).
+	******************************************************************************************************/
+	static constexpr std::size_t MaxStringLength = 0xFFFF;
+
+	/**************************************************************************************************//**
+	* @brief		Maximal frame count (the latest frames are not encoded).
+	******************************************************************************************************/
+	static constexpr std::size_t MaxFrameCount = 0xFFFF;
+
+	/**************************************************************************************************//**
+	* @brief			Get encoded size.
+	* @param[in]	exception		Exception to encode.
+	* @returns		std::size_t		Size of encoded exception (longer strings are truncated to
+	*										@ref MaxStringLength).
+	******************************************************************************************************/
+	static std::size_t GetSize(const MsvException& exception) noexcept
+	{
+		std::size_t size = HeaderSize;
+		std::size_t frameCount = GetFrameCount(exception);
+
+		exception.ForEachFrame([&size, &frameCount](const MsvExceptionFrame& frame) noexcept
+		{
+			if (frameCount)
+			{
+				--frameCount;
+				size += FrameHeaderSize + GetStringLength(frame.fileName) + 1 + GetStringLength(frame.message) + 1;
+			}
+		});
+
+		return size;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Write exception.
+	* @details		Encodes exception to the buffer.
+	* @param[in]	exception		Exception to encode.
+	* @param[out]	buffer			Output buffer (no alignment is required).
+	* @param[in]	size				Size of output buffer.
+	* @returns		std::size_t		Count of written bytes or 0 when buffer is too small (see @ref GetSize).
+	******************************************************************************************************/
+	static std::size_t Write(const MsvException& exception, void* buffer, std::size_t size) noexcept
+	{
+		std::size_t encodedSize = GetSize(exception);
+		if (!buffer || size < encodedSize || encodedSize > UINT32_MAX)
+		{
+			return 0;
+		}
+
+		uint8_t* output = static_cast<uint8_t*>(buffer);
+		std::size_t frameCount = GetFrameCount(exception);
+
+		std::memcpy(output, "MSVE", 4);
+		output[4] = Version;
+		output[5] = 0;
+		WriteUInt16(output + 6, static_cast<uint16_t>(frameCount));
+		WriteUInt32(output + 8, static_cast<uint32_t>(exception.GetErrorCode()));
+		WriteUInt32(output + 12, static_cast<uint32_t>(encodedSize));
+		output += HeaderSize;
+
+		exception.ForEachFrame([&output, &frameCount](const MsvExceptionFrame& frame) noexcept
+		{
+			if (!frameCount)
+			{
+				return;
+			}
+
+			--frameCount;
+			std::size_t fileNameLength = GetStringLength(frame.fileName);
+			std::size_t messageLength = GetStringLength(frame.message);
+			int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(MsvTimestampToSystemTime(frame.timestamp).time_since_epoch()).count();
+
+			WriteUInt32(output, static_cast<uint32_t>(frame.errorCode));
+			WriteUInt32(output + 4, static_cast<uint32_t>(frame.line));
+			WriteUInt64(output + 8, static_cast<uint64_t>(time));
+			WriteUInt16(output + 16, static_cast<uint16_t>(fileNameLength));
+			WriteUInt16(output + 18, static_cast<uint16_t>(messageLength));
+			output += FrameHeaderSize;
+
+			output = WriteString(output, frame.fileName, fileNameLength);
+			output = WriteString(output, frame.message, messageLength);
+		});
+
+		return encodedSize;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Read little-endian uint16_t (no alignment is required).
+	******************************************************************************************************/
+	static uint16_t ReadUInt16(const uint8_t* input) noexcept
+	{
+		return static_cast<uint16_t>(input[0] | (input[1] << 8));
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Read little-endian uint32_t (no alignment is required).
+	******************************************************************************************************/
+	static uint32_t ReadUInt32(const uint8_t* input) noexcept
+	{
+		return static_cast<uint32_t>(input[0]) | (static_cast<uint32_t>(input[1]) << 8) | (static_cast<uint32_t>(input[2]) << 16) | (static_cast<uint32_t>(input[3]) << 24);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Read little-endian uint64_t (no alignment is required).
+	******************************************************************************************************/
+	static uint64_t ReadUInt64(const uint8_t* input) noexcept
+	{
+		return static_cast<uint64_t>(ReadUInt32(input)) | (static_cast<uint64_t>(ReadUInt32(input + 4)) << 32);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Get count of encoded frames.
+	******************************************************************************************************/
+	static std::size_t GetFrameCount(const MsvException& exception) noexcept
+	{
+		return exception.GetFrameCount() < MaxFrameCount ? exception.GetFrameCount() : MaxFrameCount;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get encoded string length.
+	******************************************************************************************************/
+	static std::size_t GetStringLength(const char* str) noexcept
+	{
+		std::size_t length = str ? std::strlen(str) : 0;
+
+		return length < MaxStringLength ? length : MaxStringLength;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Write string with terminating zero.
+	******************************************************************************************************/
+	static uint8_t* WriteString(uint8_t* output, const char* str, std::size_t length) noexcept
+	{
+		if (length)
+		{
+			std::memcpy(output, str, length);
+		}
+		output[length] = '\0';
+
+		return output + length + 1;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Write little-endian uint16_t.
+	******************************************************************************************************/
+	static void WriteUInt16(uint8_t* output, uint16_t value) noexcept
+	{
+		output[0] = static_cast<uint8_t>(value);
+		output[1] = static_cast<uint8_t>(value >> 8);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Write little-endian uint32_t.
+	******************************************************************************************************/
+	static void WriteUInt32(uint8_t* output, uint32_t value) noexcept
+	{
+		for (int index = 0; index < 4; ++index)
+		{
+			output[index] = static_cast<uint8_t>(value >> (8 * index));
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Write little-endian uint64_t.
+	******************************************************************************************************/
+	static void WriteUInt64(uint8_t* output, uint64_t value) noexcept
+	{
+		WriteUInt32(output, static_cast<uint32_t>(value));
+		WriteUInt32(output + 4, static_cast<uint32_t>(value >> 32));
+	}
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech exception view.
+* @details	Zero-copy reader of encoded @ref MsvException. @ref Parse validates whole buffer (so frames can be
+*				read without further checks) and it never allocates. Returned strings point to the buffer - it
+*				must be valid while the view and its frames are used.
+* @see		MsvExceptionWire
+******************************************************************************************************/
+class MsvExceptionView
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Frame iterator.
+	* @details	Forward iterator over frames (from the throw to the latest rethrow).
+	******************************************************************************************************/
+	class FrameIterator
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef MsvExceptionWireFrame value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const MsvExceptionWireFrame* pointer;
+		typedef const MsvExceptionWireFrame& reference;
+
+		FrameIterator(const uint8_t* position, const uint8_t* end) noexcept :
+			m_position(position),
+			m_end(end),
+			m_frame()
+		{
+			Read();
+		}
+
+		reference operator*() const noexcept { return m_frame; }
+		pointer operator->() const noexcept { return &m_frame; }
+		bool operator==(const FrameIterator& other) const noexcept { return m_position == other.m_position; }
+		bool operator!=(const FrameIterator& other) const noexcept { return m_position != other.m_position; }
+
+		FrameIterator& operator++() noexcept
+		{
+			m_position += MsvExceptionWire::FrameHeaderSize + m_frame.fileNameLength + 1 + m_frame.messageLength + 1;
+			Read();
+
+			return *this;
+		}
+
+		FrameIterator operator++(int) noexcept
+		{
+			FrameIterator previous = *this;
+			++*this;
+
+			return previous;
+		}
+
+	protected:
+		/**************************************************************************************************//**
+		* @brief		Read frame at current position.
+		******************************************************************************************************/
+		void Read() noexcept
+		{
+			if (m_position >= m_end)
+			{
+				return;
+			}
+
+			m_frame.errorCode = static_cast<MsvErrorCode>(MsvExceptionWire::ReadUInt32(m_position));
+			m_frame.line = static_cast<int>(MsvExceptionWire::ReadUInt32(m_position + 4));
+			m_frame.time = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(static_cast<int64_t>(MsvExceptionWire::ReadUInt64(m_position + 8)))));
+			m_frame.fileNameLength = MsvExceptionWire::ReadUInt16(m_position + 16);
+			m_frame.messageLength = MsvExceptionWire::ReadUInt16(m_position + 18);
+			m_frame.fileName = reinterpret_cast<const char*>(m_position + MsvExceptionWire::FrameHeaderSize);
+			m_frame.message = m_frame.fileName + m_frame.fileNameLength + 1;
+		}
+
+		const uint8_t* m_position;
+		const uint8_t* m_end;
+		MsvExceptionWireFrame m_frame;
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates empty view (it has no frames).
+	******************************************************************************************************/
+	MsvExceptionView() noexcept :
+		m_data(nullptr),
+		m_size(0),
+		m_frameCount(0),
+		m_errorCode(MSV_SUCCESS)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Parse buffer.
+	* @details		Validates encoded exception at the beginning of buffer and sets view to it.
+	* @param[in]	data		Buffer with encoded exception (no alignment is required).
+	* @param[in]	size		Size of buffer (it can be bigger than encoded exception).
+	* @retval		MSV_SUCCESS					On success.
+	* @retval		MSV_PARSE_ERROR			When buffer is not encoded exception or its version is not supported.
+	* @retval		MSV_INVALID_DATA_ERROR	When encoded exception is truncated or malformed.
+	* @note			View is empty when parse fails.
+	******************************************************************************************************/
+	MsvErrorCode Parse(const void* data, std::size_t size) noexcept
+	{
+		*this = MsvExceptionView();
+
+		const uint8_t* input = static_cast<const uint8_t*>(data);
+		if (!input || size < MsvExceptionWire::HeaderSize || std::memcmp(input, "MSVE", 4) || input[4] != MsvExceptionWire::Version)
+		{
+			return MSV_PARSE_ERROR;
+		}
+
+		std::size_t frameCount = MsvExceptionWire::ReadUInt16(input + 6);
+		std::size_t encodedSize = MsvExceptionWire::ReadUInt32(input + 12);
+		if (input[5] || encodedSize < MsvExceptionWire::HeaderSize || encodedSize > size)
+		{
+			return MSV_INVALID_DATA_ERROR;
+		}
+
+		std::size_t offset = MsvExceptionWire::HeaderSize;
+		for (std::size_t index = 0; index < frameCount; ++index)
+		{
+			if (encodedSize - offset < MsvExceptionWire::FrameHeaderSize)
+			{
+				return MSV_INVALID_DATA_ERROR;
+			}
+
+			std::size_t fileNameLength = MsvExceptionWire::ReadUInt16(input + offset + 16);
+			std::size_t messageLength = MsvExceptionWire::ReadUInt16(input + offset + 18);
+			offset += MsvExceptionWire::FrameHeaderSize;
+
+			if (encodedSize - offset < fileNameLength + 1 + messageLength + 1 || input[offset + fileNameLength] || input[offset + fileNameLength + 1 + messageLength])
+			{
+				return MSV_INVALID_DATA_ERROR;
+			}
+
+			offset += fileNameLength + 1 + messageLength + 1;
+		}
+
+		if (offset != encodedSize)
+		{
+			return MSV_INVALID_DATA_ERROR;
+		}
+
+		m_data = input;
+		m_size = encodedSize;
+		m_frameCount = frameCount;
+		m_errorCode = static_cast<MsvErrorCode>(MsvExceptionWire::ReadUInt32(input + 8));
+
+		return MSV_SUCCESS;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get errorcode.
+	* @returns		MsvErrorCode		The last errorcode of exception.
+	******************************************************************************************************/
+	MsvErrorCode GetErrorCode() const noexcept
+	{
+		return m_errorCode;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get frame count.
+	* @returns		std::size_t		Count of frames.
+	******************************************************************************************************/
+	std::size_t GetFrameCount() const noexcept
+	{
+		return m_frameCount;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get size.
+	* @returns		std::size_t		Size of encoded exception (next data in buffer starts there).
+	******************************************************************************************************/
+	std::size_t GetSize() const noexcept
+	{
+		return m_size;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get frame.
+	* @param[in]	index		Index of frame (must be lower than @ref GetFrameCount).
+	* @returns		MsvExceptionWireFrame		The frame (O(index)).
+	******************************************************************************************************/
+	MsvExceptionWireFrame GetFrame(std::size_t index) const noexcept
+	{
+		FrameIterator iterator = begin();
+		for (; index; --index)
+		{
+			++iterator;
+		}
+
+		return *iterator;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get iterator to the first frame.
+	******************************************************************************************************/
+	FrameIterator begin() const noexcept
+	{
+		return m_data ? FrameIterator(m_data + MsvExceptionWire::HeaderSize, m_data + m_size) : end();
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get iterator behind the last frame.
+	******************************************************************************************************/
+	FrameIterator end() const noexcept
+	{
+		return FrameIterator(m_data + m_size, m_data + m_size);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Encoded exception (nullptr for empty view).
+	******************************************************************************************************/
+	const uint8_t* m_data;
+
+	/**************************************************************************************************//**
+	* @brief		Size of encoded exception.
+	******************************************************************************************************/
+	std::size_t m_size;
+
+	/**************************************************************************************************//**
+	* @brief		Count of frames.
+	******************************************************************************************************/
+	std::size_t m_frameCount;
+
+	/**************************************************************************************************//**
+	* @brief		The last errorcode of exception.
+	******************************************************************************************************/
+	MsvErrorCode m_errorCode;
+};
+
+
+#endif // !MARSTECH_EXCEPTION_WIRE_H
+
+/** @} */	//End of group MPLS.
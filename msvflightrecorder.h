@@ -0,0 +1,447 @@
+/**************************************************************************************************//**
+* @defgroup		MSVERROR MarsTech Error Handling
+* @brief			MarsTech Error
+* @details		Contains implementation and all definitions of MarsTech Error.
+* @copyright	GNU General Public License (GPLv3).
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Flight Recorder
+* @details		Contains per-thread lock-free ring buffers of recent errors and their time ordered dump.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Error.
+
+MarsTech Error is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Error is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MarsTech Error. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_FLIGHT_RECORDER_H
+#define MARSTECH_FLIGHT_RECORDER_H
+
+
+#include "msverror.h"
+#include "msverrorregistry.h"
+#include "msvtimestamp.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+#ifndef MSV_FLIGHT_RECORDER_SIZE
+/**************************************************************************************************//**
+* @def			MSV_FLIGHT_RECORDER_SIZE
+* @brief			Flight recorder size.
+* @details		Count of the latest records kept per thread (it must be power of two). Define it before including
+*					MarsTech Error headers to change it (it must be same in all translation units).
+******************************************************************************************************/
+#define MSV_FLIGHT_RECORDER_SIZE 256
+#endif // !MSV_FLIGHT_RECORDER_SIZE
+
+static_assert(MSV_FLIGHT_RECORDER_SIZE > 0 && (MSV_FLIGHT_RECORDER_SIZE & (MSV_FLIGHT_RECORDER_SIZE - 1)) == 0, "MSV_FLIGHT_RECORDER_SIZE must be power of two.");
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech flight record.
+* @details	One recorded error (throw, rethrow or failed propagation).
+******************************************************************************************************/
+struct MsvFlightRecord
+{
+	/**************************************************************************************************//**
+	* @brief		Recorded errorcode.
+	******************************************************************************************************/
+	MsvErrorCode errorCode;
+
+	/**************************************************************************************************//**
+	* @brief		Line number where errorcode has been produced.
+	******************************************************************************************************/
+	int line;
+
+	/**************************************************************************************************//**
+	* @brief		Filename where errorcode has been produced.
+	* @warning	Only pointer is stored (it is usually __FILE__).
+	******************************************************************************************************/
+	const char* fileName;
+
+	/**************************************************************************************************//**
+	* @brief		Timestamp when errorcode has been produced.
+	* @see		MsvTimestampToSystemTime
+	******************************************************************************************************/
+	MsvTimestamp timestamp;
+
+	/**************************************************************************************************//**
+	* @brief		Index of recording thread.
+	* @details	Threads are numbered from 0 in order of their first record.
+	******************************************************************************************************/
+	uint32_t threadIndex;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech flight recorder ring.
+* @details	Fixed-size ring of the latest records of one thread. Only the owner thread records (no locks, no
+*				read-modify-write atomics, no allocations), other threads can read concurrently - each entry is
+*				guarded by its sequence number (seqlock), so overwritten entries are detected and skipped.
+******************************************************************************************************/
+class MsvFlightRecorderRing
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	******************************************************************************************************/
+	MsvFlightRecorderRing() noexcept
+	{
+		for (Entry& entry : m_entries)
+		{
+			entry.sequence.store(0, std::memory_order_relaxed);
+		}
+
+		m_head.store(0, std::memory_order_relaxed);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Record.
+	* @details		Stores record to the next entry (overwrites the oldest one when ring is full).
+	* @param[in]	errorCode		Errorcode to record.
+	* @param[in]	fileName			Filename where errorcode has been produced.
+	* @param[in]	line				Line number where errorcode has been produced.
+	* @warning		It must be called by the owner thread only.
+	******************************************************************************************************/
+	void Record(MsvErrorCode errorCode, const char* fileName, int line) noexcept
+	{
+		uint64_t position = m_head.load(std::memory_order_relaxed);
+		Entry& entry = m_entries[position & (MSV_FLIGHT_RECORDER_SIZE - 1)];
+
+		entry.sequence.store(2 * position + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		entry.errorCode.store(errorCode, std::memory_order_relaxed);
+		entry.line.store(line, std::memory_order_relaxed);
+		entry.fileName.store(fileName, std::memory_order_relaxed);
+		entry.timestamp.store(MsvTimestampNow(), std::memory_order_relaxed);
+
+		entry.sequence.store(2 * position + 2, std::memory_order_release);
+		m_head.store(position + 1, std::memory_order_release);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get head.
+	* @returns		uint64_t		Count of all records of the ring (position of the next record).
+	******************************************************************************************************/
+	uint64_t GetHead() const noexcept
+	{
+		return m_head.load(std::memory_order_acquire);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Read record.
+	* @param[in]	position		Position of record (lower than @ref GetHead).
+	* @param[out]	record		Read record (its threadIndex is not set).
+	* @retval		true			When record has been read.
+	* @retval		false			When record has been overwritten (or it is being overwritten).
+	******************************************************************************************************/
+	bool Read(uint64_t position, MsvFlightRecord& record) const noexcept
+	{
+		const Entry& entry = m_entries[position & (MSV_FLIGHT_RECORDER_SIZE - 1)];
+
+		uint64_t sequence = entry.sequence.load(std::memory_order_acquire);
+		if (sequence != 2 * position + 2)
+		{
+			return false;
+		}
+
+		record.errorCode = entry.errorCode.load(std::memory_order_relaxed);
+		record.line = entry.line.load(std::memory_order_relaxed);
+		record.fileName = entry.fileName.load(std::memory_order_relaxed);
+		record.timestamp = entry.timestamp.load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		return entry.sequence.load(std::memory_order_relaxed) == sequence;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Ring entry.
+	* @details	Sequence is odd while entry is being written and 2 * position + 2 when record is complete.
+	******************************************************************************************************/
+	struct Entry
+	{
+		std::atomic<uint64_t> sequence;
+		std::atomic<MsvErrorCode> errorCode;
+		std::atomic<int> line;
+		std::atomic<const char*> fileName;
+		std::atomic<MsvTimestamp> timestamp;
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Ring entries.
+	* @see		MSV_FLIGHT_RECORDER_SIZE
+	******************************************************************************************************/
+	Entry m_entries[MSV_FLIGHT_RECORDER_SIZE];
+
+	/**************************************************************************************************//**
+	* @brief		Head.
+	* @details	Count of all records (position of the next record).
+	******************************************************************************************************/
+	std::atomic<uint64_t> m_head;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech flight recorder.
+* @details	Process wide recorder of recent errors. Each thread records to its own ring (created on the first
+*				record) - rings of finished threads are dropped.
+* @note		Errors are recorded by @ref MsvException (@ref MSV_THROW, @ref MSV_THROW_FAILED, @ref MSV_RETHROW)
+*				and by failure branches of propagation macros (@ref MSV_RETURN_FAILED, @ref MSV_TRY) when
+*				@ref MSV_FLIGHT_RECORDER is defined.
+* @see		MSV_FLIGHT_RECORDER
+******************************************************************************************************/
+class MsvFlightRecorder
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Record.
+	* @details		Records error to the ring of current thread.
+	* @param[in]	errorCode		Errorcode to record.
+	* @param[in]	fileName			Filename where errorcode has been produced.
+	* @param[in]	line				Line number where errorcode has been produced.
+	******************************************************************************************************/
+	static void Record(MsvErrorCode errorCode, const char* fileName, int line) noexcept
+	{
+		GetThreadRing().ring.Record(errorCode, fileName, line);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Dump.
+	* @details		Calls callback for records of all threads in time order (from the oldest).
+	* @param[in]	callback		Callback called as callback(const MsvFlightRecord&).
+	* @note			Records added during dump are not dumped. Records overwritten during dump are skipped.
+	******************************************************************************************************/
+	template<typename Callback>
+	static void Dump(Callback&& callback)
+	{
+		Registry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+
+		DumpLocked(registry, callback);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Dump to file.
+	* @details		Writes records of all threads in time order (from the oldest) to the file. It can be called
+	*					from fatal-error handler (e.g. terminate handler) - it does not allocate and it does not
+	*					wait for registry lock forever (it gives up when the lock can't be taken).
+	* @param[in]	file		Output file (e.g. stderr).
+	* @retval		MSV_SUCCESS			On success.
+	* @retval		MSV_BUSY_ERROR		When registry lock can't be taken.
+	* @note			One line format: &lt;time&gt;.&lt;nanoseconds&gt; &lt;thread&gt; 0x&lt;hex_errorcode&gt;
+	*					&lt;name&gt; &lt;fileName&gt;:&lt;linenumber&gt;
+	******************************************************************************************************/
+	static MsvErrorCode Dump(std::FILE* file) noexcept
+	{
+		Registry& registry = GetRegistry();
+
+		bool locked = false;
+		for (int attempt = 0; attempt < 1000 && !locked; ++attempt)
+		{
+			locked = registry.mutex.try_lock();
+			if (!locked)
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		if (!locked)
+		{
+			return MSV_BUSY_ERROR;
+		}
+
+		DumpLocked(registry, [file](const MsvFlightRecord& record)
+		{
+			char line[512];
+			int length = FormatRecord(record, line, sizeof(line));
+			if (length > 0)
+			{
+				std::fwrite(line, 1, static_cast<std::size_t>(length) < sizeof(line) ? static_cast<std::size_t>(length) : sizeof(line) - 1, file);
+			}
+		});
+
+		std::fflush(file);
+		registry.mutex.unlock();
+
+		return MSV_SUCCESS;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Format record.
+	* @details		Formats record to one line (see @ref Dump(std::FILE*)).
+	* @param[in]	record		Record to format.
+	* @param[out]	buffer		Output buffer.
+	* @param[in]	size			Size of output buffer.
+	* @returns		int			Length of formatted line (it is truncated when it is not lower than size).
+	******************************************************************************************************/
+	static int FormatRecord(const MsvFlightRecord& record, char* buffer, std::size_t size) noexcept
+	{
+		int64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(MsvTimestampToSystemTime(record.timestamp).time_since_epoch()).count();
+		const char* name = MsvErrorCodeName(record.errorCode);
+
+		return std::snprintf(buffer, size, "%lld.%09lld %u 0x%08X %s %s:%d\n", static_cast<long long>(nanoseconds / 1000000000), static_cast<long long>(nanoseconds % 1000000000),
+			record.threadIndex, static_cast<uint32_t>(record.errorCode), name ? name : "-", record.fileName ? record.fileName : "-", record.line);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Thread ring.
+	* @details	Registers ring on construction and unregisters it on thread exit. It holds dump state too.
+	******************************************************************************************************/
+	struct ThreadRing
+	{
+		ThreadRing() noexcept :
+			previous(nullptr)
+		{
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+
+			threadIndex = registry.threadCount++;
+			next = registry.first;
+			if (next)
+			{
+				next->previous = this;
+			}
+			registry.first = this;
+		}
+
+		~ThreadRing() noexcept
+		{
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+
+			(previous ? previous->next : registry.first) = next;
+			if (next)
+			{
+				next->previous = previous;
+			}
+		}
+
+		MsvFlightRecorderRing ring;
+		uint32_t threadIndex;
+		ThreadRing* previous;
+		ThreadRing* next;
+
+		//dump state (guarded by registry mutex)
+		uint64_t cursor;
+		uint64_t end;
+		bool hasCandidate;
+		MsvFlightRecord candidate;
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Ring registry.
+	* @details	Live rings (linked list - registration never allocates).
+	******************************************************************************************************/
+	struct Registry
+	{
+		std::mutex mutex;
+		ThreadRing* first = nullptr;
+		uint32_t threadCount = 0;
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Dump locked.
+	* @details		Merges rings of all threads by timestamps (no allocations).
+	* @param[in]	registry		Locked registry.
+	* @param[in]	callback		Callback called for each record.
+	******************************************************************************************************/
+	template<typename Callback>
+	static void DumpLocked(Registry& registry, Callback&& callback)
+	{
+		for (ThreadRing* threadRing = registry.first; threadRing; threadRing = threadRing->next)
+		{
+			threadRing->end = threadRing->ring.GetHead();
+			threadRing->cursor = threadRing->end > MSV_FLIGHT_RECORDER_SIZE ? threadRing->end - MSV_FLIGHT_RECORDER_SIZE : 0;
+			threadRing->hasCandidate = false;
+		}
+
+		for (;;)
+		{
+			ThreadRing* oldest = nullptr;
+
+			for (ThreadRing* threadRing = registry.first; threadRing; threadRing = threadRing->next)
+			{
+				while (!threadRing->hasCandidate && threadRing->cursor < threadRing->end)
+				{
+					threadRing->hasCandidate = threadRing->ring.Read(threadRing->cursor++, threadRing->candidate);
+				}
+
+				if (threadRing->hasCandidate && (!oldest || static_cast<int64_t>(threadRing->candidate.timestamp - oldest->candidate.timestamp) < 0))
+				{
+					oldest = threadRing;
+				}
+			}
+
+			if (!oldest)
+			{
+				return;
+			}
+
+			oldest->candidate.threadIndex = oldest->threadIndex;
+			oldest->hasCandidate = false;
+			callback(static_cast<const MsvFlightRecord&>(oldest->candidate));
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get registry.
+	* @returns		Registry&		Process wide ring registry.
+	******************************************************************************************************/
+	static Registry& GetRegistry() noexcept
+	{
+		static Registry registry;
+
+		return registry;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get thread ring.
+	* @returns		ThreadRing&		Ring of current thread (created by the first call).
+	******************************************************************************************************/
+	static ThreadRing& GetThreadRing() noexcept
+	{
+		static thread_local ThreadRing threadRing;
+
+		return threadRing;
+	}
+};
+
+
+#endif // !MARSTECH_FLIGHT_RECORDER_H
+
+/** @} */	//End of group MPLS.
@@ -0,0 +1,542 @@
+/**************************************************************************************************//**
+* @defgroup		MSVERROR MarsTech Error Handling
+* @brief			MarsTech Error
+* @details		Contains implementation and all definitions of MarsTech Error.
+* @copyright	GNU General Public License (GPLv3).
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Inline String
+* @details		Contains definition of MsvInlineString - string with inline buffer and allocation-free formatting.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Error.
+
+MarsTech Error is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Error is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MarsTech Error. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_INLINE_STRING_H
+#define MARSTECH_INLINE_STRING_H
+
+
+#include "msverror.h"
+#include "msvmemoryresource.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech inline string heap buffer.
+* @details	Header of heap buffer used by @ref MsvInlineString. Characters are stored right after the header
+*				(in the same allocation). Heap buffer is shared by copies of string (copy on write).
+******************************************************************************************************/
+struct MsvInlineStringHeap
+{
+	/**************************************************************************************************//**
+	* @brief		Reference counter.
+	* @details	Count of strings which share this buffer.
+	******************************************************************************************************/
+	std::atomic<std::size_t> references;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech inline string.
+* @details	String which stores up to InlineSize - 1 characters in its own (inline) buffer. Longer strings
+*				are moved to the heap. All methods are noexcept - when heap allocation fails, the string is
+*				truncated instead of throwing.
+* @tparam		InlineSize		Size of inline buffer (including terminating zero).
+* @note		Heap buffers are allocated by @ref MsvAllocateExceptionMemory (from memory resource of
+*				exceptions).
+* @note		Heap buffer is reference counted and shared by copies (copy on write) - copying long string
+*				costs one atomic increment, it is copied when some of copies is modified.
+* @note		Truncation rules: Text which does not fit is cut. If there is enough space, the last three
+*				stored characters are replaced by "..." to show the string has been truncated. Once
+*				truncated, all next appends are ignored.
+* @note		Numbers are formatted by std::to_chars - no locale and no allocation.
+******************************************************************************************************/
+template<std::size_t InlineSize>
+class MsvInlineString
+{
+	static_assert(InlineSize > 4, "Inline buffer must be able to hold at least truncation mark.");
+
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates empty string stored in inline buffer.
+	******************************************************************************************************/
+	MsvInlineString() noexcept :
+		m_heap(nullptr),
+		m_length(0),
+		m_capacity(InlineSize),
+		m_truncated(false)
+	{
+		m_inline[0] = '\0';
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Copy constructor.
+	* @param[in]	origin		Original string to be copied.
+	* @note			Heap buffer is shared (not copied).
+	******************************************************************************************************/
+	MsvInlineString(const MsvInlineString& origin) noexcept :
+		MsvInlineString()
+	{
+		Share(origin);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Move constructor.
+	* @param[in]	origin		Original string to be moved. It is empty after move.
+	******************************************************************************************************/
+	MsvInlineString(MsvInlineString&& origin) noexcept :
+		MsvInlineString()
+	{
+		Steal(origin);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Destructor.
+	******************************************************************************************************/
+	~MsvInlineString() noexcept
+	{
+		Release();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Assign operator.
+	* @param[in]	origin		Original string to be assigned.
+	* @note			Heap buffer is shared (not copied).
+	******************************************************************************************************/
+	MsvInlineString& operator=(const MsvInlineString& origin) noexcept
+	{
+		if (this != &origin)
+		{
+			Release();
+			Share(origin);
+		}
+
+		return *this;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Move assign operator.
+	* @param[in]	origin		Original string to be moved. It is empty after move.
+	******************************************************************************************************/
+	MsvInlineString& operator=(MsvInlineString&& origin) noexcept
+	{
+		if (this != &origin)
+		{
+			Release();
+			Steal(origin);
+		}
+
+		return *this;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Clear string.
+	* @details		Sets length to zero and resets truncated flag. Not shared heap buffer (if any) is kept for
+	*					reuse.
+	******************************************************************************************************/
+	void Clear() noexcept
+	{
+		if (IsShared())
+		{
+			Release();
+		}
+
+		m_length = 0;
+		m_truncated = false;
+		GetBuffer()[0] = '\0';
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Append string.
+	* @param[in]	str		Zero terminated string to append (nullptr is treated as empty string).
+	* @retval		true		When whole string has been appended.
+	* @retval		false		When string has been truncated.
+	******************************************************************************************************/
+	bool Append(const char* str) noexcept
+	{
+		return Append(str, str ? std::strlen(str) : 0);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Append string.
+	* @param[in]	str		String to append (does not have to be zero terminated).
+	* @param[in]	length	Length of str.
+	* @retval		true		When whole string has been appended.
+	* @retval		false		When string has been truncated.
+	******************************************************************************************************/
+	bool Append(const char* str, std::size_t length) noexcept
+	{
+		if (m_truncated)
+		{
+			return false;
+		}
+
+		if (!Reserve(length))
+		{
+			//current buffer is writable (shared buffer has been moved to inline one), it can still be big enough
+			std::size_t fitting = m_capacity - m_length - 1;
+			if (fitting < length || m_truncated)
+			{
+				fitting = fitting < length ? fitting : length;
+				std::memcpy(GetBuffer() + m_length, str, fitting);
+				m_length += fitting;
+				Truncate();
+				return false;
+			}
+		}
+
+		if (length)
+		{
+			std::memcpy(GetBuffer() + m_length, str, length);
+		}
+		m_length += length;
+		GetBuffer()[m_length] = '\0';
+
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Append character.
+	* @param[in]	character		Character to append.
+	* @retval		true				When character has been appended.
+	* @retval		false				When string has been truncated.
+	******************************************************************************************************/
+	bool AppendChar(char character) noexcept
+	{
+		return Append(&character, 1);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Append decimal number.
+	* @details		Formats value as decimal number aligned to right (like std::right with std::setw and
+	*					std::setfill - fill characters are placed before sign).
+	* @param[in]	value		Value to append.
+	* @param[in]	width		Minimal width of formatted number.
+	* @param[in]	fill		Fill character used when formatted number is shorter than width.
+	* @retval		true		When number has been appended.
+	* @retval		false		When string has been truncated.
+	******************************************************************************************************/
+	bool AppendDecimal(int64_t value, std::size_t width = 0, char fill = ' ') noexcept
+	{
+		char number[24];
+		std::to_chars_result result = std::to_chars(number, number + sizeof(number), value);
+
+		return AppendPadded(number, static_cast<std::size_t>(result.ptr - number), width, fill);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Append hexadecimal number.
+	* @details		Formats value as uppercase hexadecimal number (without prefix) padded by zeros to width.
+	* @param[in]	value		Value to append.
+	* @param[in]	width		Minimal width of formatted number.
+	* @retval		true		When number has been appended.
+	* @retval		false		When string has been truncated.
+	******************************************************************************************************/
+	bool AppendHex(uint64_t value, std::size_t width = 0) noexcept
+	{
+		char number[24];
+		std::to_chars_result result = std::to_chars(number, number + sizeof(number), value, 16);
+		for (char* digit = number; digit != result.ptr; ++digit)
+		{
+			if (*digit >= 'a' && *digit <= 'f')
+			{
+				*digit = static_cast<char>(*digit - 'a' + 'A');
+			}
+		}
+
+		return AppendPadded(number, static_cast<std::size_t>(result.ptr - number), width, '0');
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get string.
+	* @returns		const char*		Zero terminated stored string.
+	******************************************************************************************************/
+	const char* GetString() const noexcept
+	{
+		return m_heap ? reinterpret_cast<const char*>(m_heap + 1) : m_inline;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get length.
+	* @returns		std::size_t		Length of stored string (without terminating zero).
+	******************************************************************************************************/
+	std::size_t GetLength() const noexcept
+	{
+		return m_length;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Check truncated.
+	* @retval		true		When some append has been truncated (heap allocation failed).
+	* @retval		false		When whole string is stored.
+	******************************************************************************************************/
+	bool IsTruncated() const noexcept
+	{
+		return m_truncated;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Check inline.
+	* @retval		true		When string is stored in inline buffer (no heap memory is used).
+	* @retval		false		When string has been moved to heap.
+	******************************************************************************************************/
+	bool IsInline() const noexcept
+	{
+		return m_heap == nullptr;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Check shared.
+	* @retval		true		When heap buffer is shared with some copy of this string.
+	* @retval		false		When string is inline or it is the only owner of heap buffer.
+	******************************************************************************************************/
+	bool IsShared() const noexcept
+	{
+		return m_heap && m_heap->references.load(std::memory_order_acquire) > 1;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Get buffer.
+	* @returns		char*		Current buffer (inline or heap).
+	* @warning		Heap buffer can be written only when it is not shared.
+	******************************************************************************************************/
+	char* GetBuffer() noexcept
+	{
+		return m_heap ? reinterpret_cast<char*>(m_heap + 1) : m_inline;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Reserve space.
+	* @details		Makes sure there is writable space for additional characters (and terminating zero). Moves
+	*					string to the new heap buffer when current buffer is too small or shared.
+	* @param[in]	additional		Number of characters which will be appended.
+	* @retval		true				When there is enough space.
+	* @retval		false				When heap allocation failed (current buffer is writable, but too small).
+	******************************************************************************************************/
+	bool Reserve(std::size_t additional) noexcept
+	{
+		std::size_t required = m_length + additional + 1;
+		bool shared = IsShared();
+		if (required <= m_capacity && !shared)
+		{
+			return true;
+		}
+
+		std::size_t capacity = m_capacity;
+		if (capacity < required)
+		{
+			capacity = capacity * 2 < required ? required : capacity * 2;
+		}
+
+		void* memory = MsvAllocateExceptionMemory(sizeof(MsvInlineStringHeap) + capacity);
+		if (!memory)
+		{
+			if (shared)
+			{
+				//shared buffer can not be written - continue with truncated inline copy
+				MoveToInline();
+			}
+
+			return false;
+		}
+
+		MsvInlineStringHeap* heap = new (memory) MsvInlineStringHeap();
+		heap->references.store(1, std::memory_order_relaxed);
+		std::memcpy(reinterpret_cast<char*>(heap + 1), GetString(), m_length + 1);
+
+		Release();
+		m_heap = heap;
+		m_capacity = capacity;
+
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Move to inline.
+	* @details		Copies string from heap buffer to inline buffer (it is truncated when it does not fit) and
+	*					releases heap buffer.
+	******************************************************************************************************/
+	void MoveToInline() noexcept
+	{
+		std::size_t length = m_length < InlineSize - 1 ? m_length : InlineSize - 1;
+		std::memcpy(m_inline, GetString(), length);
+		m_inline[length] = '\0';
+
+		Release();
+		if (length < m_length)
+		{
+			m_length = length;
+			Truncate();
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Append padded string.
+	* @param[in]	str		String to append.
+	* @param[in]	length	Length of str.
+	* @param[in]	width		Minimal width of appended string.
+	* @param[in]	fill		Fill character placed before str when it is shorter than width.
+	* @retval		true		When string has been appended.
+	* @retval		false		When string has been truncated.
+	******************************************************************************************************/
+	bool AppendPadded(const char* str, std::size_t length, std::size_t width, char fill) noexcept
+	{
+		for (; width > length; --width)
+		{
+			if (!AppendChar(fill))
+			{
+				return false;
+			}
+		}
+
+		return Append(str, length);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Truncate string.
+	* @details		Sets truncated flag and writes truncation mark ("...") to the end of string.
+	* @warning		Current buffer must be writable.
+	******************************************************************************************************/
+	void Truncate() noexcept
+	{
+		m_truncated = true;
+
+		char* buffer = GetBuffer();
+		std::size_t mark = m_length < 3 ? m_length : 3;
+		std::memset(buffer + m_length - mark, '.', mark);
+		buffer[m_length] = '\0';
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Share string.
+	* @details		Copies inline buffer or shares heap buffer of origin.
+	* @param[in]	origin		String to share.
+	* @warning		This string must be released before.
+	******************************************************************************************************/
+	void Share(const MsvInlineString& origin) noexcept
+	{
+		m_heap = origin.m_heap;
+		m_length = origin.m_length;
+		m_capacity = origin.m_capacity;
+		m_truncated = origin.m_truncated;
+
+		if (m_heap)
+		{
+			m_heap->references.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			std::memcpy(m_inline, origin.m_inline, m_length + 1);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Steal string.
+	* @details		Moves inline buffer or heap buffer of origin to this string. Origin is empty then.
+	* @param[in]	origin		String to steal.
+	* @warning		This string must be released before.
+	******************************************************************************************************/
+	void Steal(MsvInlineString& origin) noexcept
+	{
+		Share(origin);
+
+		if (origin.m_heap)
+		{
+			//this string has taken the reference
+			m_heap->references.fetch_sub(1, std::memory_order_relaxed);
+			origin.m_heap = nullptr;
+			origin.m_capacity = InlineSize;
+		}
+
+		origin.m_length = 0;
+		origin.m_truncated = false;
+		origin.m_inline[0] = '\0';
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Release heap buffer.
+	* @details		Releases reference to heap buffer (frees it when it is the last one) and switches to
+	*					inline buffer.
+	* @warning		String content and length must be set by caller then (content in heap buffer is lost).
+	******************************************************************************************************/
+	void Release() noexcept
+	{
+		if (m_heap && m_heap->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			m_heap->~MsvInlineStringHeap();
+			MsvFreeExceptionMemory(m_heap);
+		}
+
+		m_heap = nullptr;
+		m_capacity = InlineSize;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Inline buffer.
+	* @details	Stores string until it is longer than InlineSize - 1 characters.
+	******************************************************************************************************/
+	char m_inline[InlineSize];
+
+	/**************************************************************************************************//**
+	* @brief		Heap buffer.
+	* @details	Stores string when it does not fit to @ref m_inline. It is nullptr when string is inline.
+	******************************************************************************************************/
+	MsvInlineStringHeap* m_heap;
+
+	/**************************************************************************************************//**
+	* @brief		String length.
+	* @details	Length of stored string (without terminating zero).
+	******************************************************************************************************/
+	std::size_t m_length;
+
+	/**************************************************************************************************//**
+	* @brief		Buffer capacity.
+	* @details	Capacity of current buffer (including terminating zero).
+	******************************************************************************************************/
+	std::size_t m_capacity;
+
+	/**************************************************************************************************//**
+	* @brief		Truncated flag.
+	* @details	True when some append has been truncated.
+	******************************************************************************************************/
+	bool m_truncated;
+};
+
+
+#endif // !MARSTECH_INLINE_STRING_H
+
+/** @} */	//End of group MPLS.
@@ -0,0 +1,506 @@
+/**************************************************************************************************//**
+* @defgroup		MSVERROR MarsTech Error Handling
+* @brief			MarsTech Error
+* @details		Contains implementation and all definitions of MarsTech Error.
+* @copyright	GNU General Public License (GPLv3).
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Memory Resource
+* @details		Contains memory resource of MsvException heap storage and thread local recycling pool.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Error.
+
+MarsTech Error is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Error is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MarsTech Error. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_MEMORY_RESOURCE_H
+#define MARSTECH_MEMORY_RESOURCE_H
+
+
+#include "msverror.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+#if defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define MSV_MEMORY_RESOURCE
+#endif
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+#ifndef MSV_EXCEPTION_POOL_DEPTH
+/**************************************************************************************************//**
+* @def			MSV_EXCEPTION_POOL_DEPTH
+* @brief			Exception pool depth.
+* @details		Maximal count of free blocks of each size class cached by each thread in
+*					@ref MsvExceptionPoolResource. Define it before including this header to change it (it must be
+*					same in all translation units).
+******************************************************************************************************/
+#define MSV_EXCEPTION_POOL_DEPTH 16
+#endif // !MSV_EXCEPTION_POOL_DEPTH
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+//memory resources report failure by std::bad_alloc (it is converted to nullptr)
+#define MSV_MEMORY_RESOURCE_THROWS
+#endif
+
+
+#ifdef MSV_MEMORY_RESOURCE
+
+/**************************************************************************************************//**
+* @brief		MarsTech exception pool resource.
+* @details	Default memory resource of @ref MsvException heap storage (heap frames and long formatted
+*				messages). Freed blocks are cached in thread local free lists (size classes 64 - 4096 bytes,
+*				@ref MSV_EXCEPTION_POOL_DEPTH blocks per class), so repeated throws reuse memory instead of
+*				round-tripping through the global heap. Larger blocks are allocated directly.
+* @note		Each block is own allocation from the global heap (operator new) - block can be freed by any
+*				thread (exceptions are shared by copies and moved between threads) and it stays valid when the
+*				allocating thread exits. Cached blocks are freed when thread exits.
+* @see		MsvGetExceptionMemoryResource
+******************************************************************************************************/
+class MsvExceptionPoolResource :
+	public std::pmr::memory_resource
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Count of size classes.
+	******************************************************************************************************/
+	static constexpr std::size_t ClassCount = 7;
+
+	/**************************************************************************************************//**
+	* @brief		The smallest size class.
+	******************************************************************************************************/
+	static constexpr std::size_t MinClassSize = 64;
+
+	/**************************************************************************************************//**
+	* @brief		The largest size class.
+	******************************************************************************************************/
+	static constexpr std::size_t MaxClassSize = MinClassSize << (ClassCount - 1);
+
+	/**************************************************************************************************//**
+	* @brief			Allocate block.
+	* @details		Reuses cached block of the same size class or allocates new one.
+	* @param[in]	bytes			Size of block.
+	* @param[in]	alignment	Alignment of block.
+	* @returns		void*			Allocated block or nullptr when allocation failed.
+	******************************************************************************************************/
+	static void* TryAllocate(std::size_t bytes, std::size_t alignment) noexcept
+	{
+		if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		{
+			return ::operator new(bytes, std::align_val_t(alignment), std::nothrow);
+		}
+
+		if (bytes > MaxClassSize)
+		{
+			return ::operator new(bytes, std::nothrow);
+		}
+
+		std::size_t sizeClass = GetSizeClass(bytes);
+		if (!IsThreadCacheDestroyed())
+		{
+			ThreadCache& cache = GetThreadCache();
+			if (cache.counts[sizeClass])
+			{
+				return cache.blocks[sizeClass][--cache.counts[sizeClass]];
+			}
+		}
+
+		return ::operator new(MinClassSize << sizeClass, std::nothrow);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Free block.
+	* @details		Caches block in thread local free list (or frees it when the list is full).
+	* @param[in]	block			Block to free.
+	* @param[in]	bytes			Size of block (the same as allocated).
+	* @param[in]	alignment	Alignment of block (the same as allocated).
+	******************************************************************************************************/
+	static void Free(void* block, std::size_t bytes, std::size_t alignment) noexcept
+	{
+		if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		{
+			::operator delete(block, std::align_val_t(alignment));
+			return;
+		}
+
+		if (bytes <= MaxClassSize && !IsThreadCacheDestroyed())
+		{
+			std::size_t sizeClass = GetSizeClass(bytes);
+			ThreadCache& cache = GetThreadCache();
+			if (cache.counts[sizeClass] < MSV_EXCEPTION_POOL_DEPTH)
+			{
+				cache.blocks[sizeClass][cache.counts[sizeClass]++] = block;
+				return;
+			}
+		}
+
+		::operator delete(block);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Thread cache.
+	* @details	Free blocks of one thread (stack per size class).
+	******************************************************************************************************/
+	struct ThreadCache
+	{
+		ThreadCache() noexcept :
+			counts()
+		{
+
+		}
+
+		~ThreadCache()
+		{
+			for (std::size_t sizeClass = 0; sizeClass < ClassCount; ++sizeClass)
+			{
+				while (counts[sizeClass])
+				{
+					::operator delete(blocks[sizeClass][--counts[sizeClass]]);
+				}
+			}
+
+			IsThreadCacheDestroyed() = true;
+		}
+
+		void* blocks[ClassCount][MSV_EXCEPTION_POOL_DEPTH];
+		std::size_t counts[ClassCount];
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Get size class.
+	* @param[in]	bytes			Size of block (up to @ref MaxClassSize).
+	* @returns		std::size_t		Index of the smallest size class which fits the block.
+	******************************************************************************************************/
+	static std::size_t GetSizeClass(std::size_t bytes) noexcept
+	{
+		std::size_t sizeClass = 0;
+		while ((MinClassSize << sizeClass) < bytes)
+		{
+			++sizeClass;
+		}
+
+		return sizeClass;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get thread cache.
+	* @returns		ThreadCache&		Cache of current thread.
+	******************************************************************************************************/
+	static ThreadCache& GetThreadCache() noexcept
+	{
+		thread_local ThreadCache cache;
+
+		return cache;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get thread cache destroyed flag.
+	* @details		Blocks freed after thread cache has been destroyed (by thread local or static destructors)
+	*					are freed directly.
+	* @returns		bool&		Flag of current thread (trivial - it is valid during thread exit).
+	******************************************************************************************************/
+	static bool& IsThreadCacheDestroyed() noexcept
+	{
+		thread_local bool destroyed = false;
+
+		return destroyed;
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc		TryAllocate
+	* @throws		std::bad_alloc		When allocation failed.
+	******************************************************************************************************/
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		void* block = TryAllocate(bytes, alignment);
+
+#ifdef MSV_MEMORY_RESOURCE_THROWS
+		if (!block)
+		{
+			throw std::bad_alloc();
+		}
+#endif
+
+		return block;
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc		Free
+	******************************************************************************************************/
+	void do_deallocate(void* block, std::size_t bytes, std::size_t alignment) override
+	{
+		Free(block, bytes, alignment);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Compare resources.
+	* @param[in]	other		Other resource.
+	* @retval		true		When other resource is exception pool too (all pools share the same caches).
+	* @retval		false		Otherwise.
+	******************************************************************************************************/
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return dynamic_cast<const MsvExceptionPoolResource*>(&other) != nullptr;
+	}
+};
+
+
+/**************************************************************************************************//**
+* @brief			Get exception pool resource.
+* @returns		MsvExceptionPoolResource*		Default memory resource of exceptions (it is never destroyed -
+*															exceptions can be freed by static destructors).
+******************************************************************************************************/
+inline MsvExceptionPoolResource* MsvGetExceptionPoolResource() noexcept
+{
+	alignas(MsvExceptionPoolResource) static unsigned char storage[sizeof(MsvExceptionPoolResource)];
+	static MsvExceptionPoolResource* resource = new (storage) MsvExceptionPoolResource();
+
+	return resource;
+}
+
+/**************************************************************************************************//**
+* @brief			Get process memory resource storage.
+* @returns		std::atomic<std::pmr::memory_resource*>&		Process wide memory resource of exceptions
+*																				(nullptr for @ref MsvExceptionPoolResource).
+******************************************************************************************************/
+inline std::atomic<std::pmr::memory_resource*>& MsvGetExceptionMemoryResourceStorage() noexcept
+{
+	static std::atomic<std::pmr::memory_resource*> resource(nullptr);
+
+	return resource;
+}
+
+/**************************************************************************************************//**
+* @brief			Get thread memory resource storage.
+* @returns		std::pmr::memory_resource*&		Memory resource of exceptions of current thread (nullptr for
+*															process wide one).
+******************************************************************************************************/
+inline std::pmr::memory_resource*& MsvGetThreadExceptionMemoryResourceStorage() noexcept
+{
+	thread_local std::pmr::memory_resource* resource = nullptr;
+
+	return resource;
+}
+
+/**************************************************************************************************//**
+* @brief			Set process memory resource.
+* @details		Sets memory resource of exceptions for all threads (which do not set their own).
+* @param[in]	resource		New memory resource or nullptr for default one (@ref MsvExceptionPoolResource).
+* @returns		std::pmr::memory_resource*		Previous memory resource (nullptr for default one).
+* @warning		Memory resource must live until all exceptions allocated from it are destroyed.
+******************************************************************************************************/
+inline std::pmr::memory_resource* MsvSetExceptionMemoryResource(std::pmr::memory_resource* resource) noexcept
+{
+	return MsvGetExceptionMemoryResourceStorage().exchange(resource, std::memory_order_acq_rel);
+}
+
+/**************************************************************************************************//**
+* @brief			Set thread memory resource.
+* @details		Sets memory resource of exceptions for current thread.
+* @param[in]	resource		New memory resource or nullptr for process wide one.
+* @returns		std::pmr::memory_resource*		Previous memory resource of current thread (nullptr for process
+*															wide one).
+* @warning		Memory resource must live until all exceptions allocated from it are destroyed (they can be
+*					freed by other threads).
+* @see			MsvExceptionMemoryResourceScope
+******************************************************************************************************/
+inline std::pmr::memory_resource* MsvSetThreadExceptionMemoryResource(std::pmr::memory_resource* resource) noexcept
+{
+	std::pmr::memory_resource* previous = MsvGetThreadExceptionMemoryResourceStorage();
+	MsvGetThreadExceptionMemoryResourceStorage() = resource;
+
+	return previous;
+}
+
+/**************************************************************************************************//**
+* @brief			Get memory resource.
+* @returns		std::pmr::memory_resource*		Memory resource of exceptions of current thread - thread one,
+*															process wide one or default one (in this order).
+******************************************************************************************************/
+inline std::pmr::memory_resource* MsvGetExceptionMemoryResource() noexcept
+{
+	if (std::pmr::memory_resource* resource = MsvGetThreadExceptionMemoryResourceStorage())
+	{
+		return resource;
+	}
+
+	if (std::pmr::memory_resource* resource = MsvGetExceptionMemoryResourceStorage().load(std::memory_order_acquire))
+	{
+		return resource;
+	}
+
+	return MsvGetExceptionPoolResource();
+}
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech exception memory resource scope.
+* @details	Sets memory resource of exceptions for current thread until the scope ends (previous one is
+*				restored then).
+* @see		MsvSetThreadExceptionMemoryResource
+******************************************************************************************************/
+class MsvExceptionMemoryResourceScope
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	resource		Memory resource of exceptions thrown in the scope.
+	******************************************************************************************************/
+	explicit MsvExceptionMemoryResourceScope(std::pmr::memory_resource* resource) noexcept :
+		m_previous(MsvSetThreadExceptionMemoryResource(resource))
+	{
+
+	}
+
+	MsvExceptionMemoryResourceScope(const MsvExceptionMemoryResourceScope&) = delete;
+	MsvExceptionMemoryResourceScope& operator= (const MsvExceptionMemoryResourceScope&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Destructor.
+	* @details		Restores previous memory resource.
+	******************************************************************************************************/
+	~MsvExceptionMemoryResourceScope()
+	{
+		MsvSetThreadExceptionMemoryResource(m_previous);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Previous memory resource of current thread.
+	******************************************************************************************************/
+	std::pmr::memory_resource* m_previous;
+};
+
+#endif // MSV_MEMORY_RESOURCE
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech exception memory header.
+* @details	Stored before each block allocated by @ref MsvAllocateExceptionMemory - block can be freed by
+*				other thread (which uses other memory resource).
+******************************************************************************************************/
+struct alignas(std::max_align_t) MsvExceptionMemoryHeader
+{
+#ifdef MSV_MEMORY_RESOURCE
+	/**************************************************************************************************//**
+	* @brief		Memory resource which allocated block.
+	******************************************************************************************************/
+	std::pmr::memory_resource* resource;
+#endif
+
+	/**************************************************************************************************//**
+	* @brief		Size of block (including header).
+	******************************************************************************************************/
+	std::size_t size;
+};
+
+/**************************************************************************************************//**
+* @brief			Allocate exception memory.
+* @details		Allocates heap storage of exception from memory resource of current thread
+*					(@ref MsvGetExceptionMemoryResource) or from the global heap when memory resources are not
+*					available.
+* @param[in]	size		Size of memory.
+* @returns		void*		Allocated memory (aligned to std::max_align_t) or nullptr when allocation failed.
+* @see			MsvFreeExceptionMemory
+******************************************************************************************************/
+inline void* MsvAllocateExceptionMemory(std::size_t size) noexcept
+{
+	size += sizeof(MsvExceptionMemoryHeader);
+	void* block = nullptr;
+
+#ifdef MSV_MEMORY_RESOURCE
+	std::pmr::memory_resource* resource = MsvGetExceptionMemoryResource();
+	if (resource == MsvGetExceptionPoolResource())
+	{
+		block = MsvExceptionPoolResource::TryAllocate(size, alignof(MsvExceptionMemoryHeader));
+	}
+	else
+	{
+#ifdef MSV_MEMORY_RESOURCE_THROWS
+		try
+		{
+			block = resource->allocate(size, alignof(MsvExceptionMemoryHeader));
+		}
+		catch (...)
+		{
+			block = nullptr;
+		}
+#else
+		block = resource->allocate(size, alignof(MsvExceptionMemoryHeader));
+#endif
+	}
+#else
+	block = ::operator new(size, std::nothrow);
+#endif
+
+	if (!block)
+	{
+		return nullptr;
+	}
+
+	MsvExceptionMemoryHeader* header = new (block) MsvExceptionMemoryHeader();
+#ifdef MSV_MEMORY_RESOURCE
+	header->resource = resource;
+#endif
+	header->size = size;
+
+	return header + 1;
+}
+
+/**************************************************************************************************//**
+* @brief			Free exception memory.
+* @details		Returns memory to the memory resource which allocated it.
+* @param[in]	memory		Memory allocated by @ref MsvAllocateExceptionMemory.
+******************************************************************************************************/
+inline void MsvFreeExceptionMemory(void* memory) noexcept
+{
+	MsvExceptionMemoryHeader* header = static_cast<MsvExceptionMemoryHeader*>(memory) - 1;
+
+#ifdef MSV_MEMORY_RESOURCE
+	if (header->resource == MsvGetExceptionPoolResource())
+	{
+		MsvExceptionPoolResource::Free(header, header->size, alignof(MsvExceptionMemoryHeader));
+	}
+	else
+	{
+		header->resource->deallocate(header, header->size, alignof(MsvExceptionMemoryHeader));
+	}
+#else
+	::operator delete(header);
+#endif
+}
+
+
+#endif // !MARSTECH_MEMORY_RESOURCE_H
+
+/** @} */	//End of group MPLS.
@@ -0,0 +1,659 @@
+/**************************************************************************************************//**
+* @defgroup		MSVERROR MarsTech Error Handling
+* @brief			MarsTech Error
+* @details		Contains implementation and all definitions of MarsTech Error.
+* @copyright	GNU General Public License (GPLv3).
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Result
+* @details		Contains definition of MsvResult - value or MsvErrorCode for exception-free hot paths.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Error.
+
+MarsTech Error is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Error is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MarsTech Error. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_RESULT_H
+#define MARSTECH_RESULT_H
+
+
+#include "msverrorcodes.h"
+#include "msvexception.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech failure.
+* @details	Wrapper of failed @ref MsvErrorCode. It is implicitly convertible to any @ref MsvResult and to
+*				@ref MsvErrorCode, so it can be returned from functions returning both of them.
+* @see		MsvResult
+* @see		MSV_TRY
+******************************************************************************************************/
+struct MsvFailure
+{
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	failedErrorCode		Failed (warning or error) errorcode.
+	* @warning		Errorcode must be failed (@ref MSV_FAILED).
+	******************************************************************************************************/
+	constexpr explicit MsvFailure(MsvErrorCode failedErrorCode) noexcept :
+		errorCode(failedErrorCode)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Convert to errorcode.
+	* @returns		MsvErrorCode		Stored failed errorcode.
+	******************************************************************************************************/
+	constexpr operator MsvErrorCode() const noexcept
+	{
+		return errorCode;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Stored failed errorcode.
+	******************************************************************************************************/
+	MsvErrorCode errorCode;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech result storage.
+* @details	Storage of @ref MsvResult for trivially copyable values - it is trivially copyable too. Value is
+*				valid when stored errorcode succeeded (errorcode is the discriminant - there is no other flag).
+* @tparam		T				Type of value.
+* @tparam		Trivial		True when T is trivially copyable and destructible.
+******************************************************************************************************/
+template<typename T, bool Trivial = std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value>
+class MsvResultStorage
+{
+protected:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates storage without value.
+	* @param[in]	errorCode		Failed errorcode (it is forced to be failed).
+	******************************************************************************************************/
+	constexpr explicit MsvResultStorage(MsvErrorCode errorCode) noexcept :
+		m_empty(),
+		m_errorCode(errorCode | MsvWarnMask)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates storage with value.
+	* @param[in]	errorCode		Succeeded errorcode.
+	* @param[in]	args				Arguments to construct value.
+	******************************************************************************************************/
+	template<typename... Args>
+	constexpr MsvResultStorage(MsvErrorCode errorCode, std::in_place_t, Args&&... args) :
+		m_value(std::forward<Args>(args)...),
+		m_errorCode(errorCode)
+	{
+
+	}
+
+	union
+	{
+		/**************************************************************************************************//**
+		* @brief		Empty member (active when there is no value).
+		******************************************************************************************************/
+		char m_empty;
+
+		/**************************************************************************************************//**
+		* @brief		Stored value (active when @ref m_errorCode succeeded).
+		******************************************************************************************************/
+		T m_value;
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Stored errorcode.
+	* @details	Value is stored when errorcode succeeded.
+	******************************************************************************************************/
+	MsvErrorCode m_errorCode;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech result storage.
+* @details	Storage of @ref MsvResult for not trivially copyable values. Value is valid when stored
+*				errorcode succeeded (errorcode is the discriminant - there is no other flag).
+* @tparam		T				Type of value.
+******************************************************************************************************/
+template<typename T>
+class MsvResultStorage<T, false>
+{
+protected:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates storage without value.
+	* @param[in]	errorCode		Failed errorcode.
+	* @note			Errorcode is forced to be failed (it does not change warnings and errors), so storage without
+	*					value never looks like storage with value (even for compiler).
+	******************************************************************************************************/
+	explicit MsvResultStorage(MsvErrorCode errorCode) noexcept :
+		m_empty(),
+		m_errorCode(errorCode | MsvWarnMask)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates storage with value.
+	* @param[in]	errorCode		Succeeded errorcode.
+	* @param[in]	args				Arguments to construct value.
+	******************************************************************************************************/
+	template<typename... Args>
+	MsvResultStorage(MsvErrorCode errorCode, std::in_place_t, Args&&... args) :
+		m_value(std::forward<Args>(args)...),
+		m_errorCode(errorCode)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Copy constructor.
+	* @param[in]	origin		Original storage to be copied.
+	******************************************************************************************************/
+	MsvResultStorage(const MsvResultStorage& origin) :
+		m_empty(),
+		m_errorCode(origin.m_errorCode)
+	{
+		if (MSV_SUCCEEDED(m_errorCode))
+		{
+			new (&m_value) T(origin.m_value);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Move constructor.
+	* @param[in]	origin		Original storage to be moved.
+	******************************************************************************************************/
+	MsvResultStorage(MsvResultStorage&& origin) noexcept(std::is_nothrow_move_constructible<T>::value) :
+		m_empty(),
+		m_errorCode(origin.m_errorCode)
+	{
+		if (MSV_SUCCEEDED(m_errorCode))
+		{
+			new (&m_value) T(std::move(origin.m_value));
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Destructor.
+	******************************************************************************************************/
+	~MsvResultStorage() noexcept
+	{
+		if (MSV_SUCCEEDED(m_errorCode))
+		{
+			m_value.~T();
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Assign operator.
+	* @param[in]	origin		Original storage to be assigned.
+	******************************************************************************************************/
+	MsvResultStorage& operator=(const MsvResultStorage& origin)
+	{
+		if (this != &origin)
+		{
+			Assign(origin);
+		}
+
+		return *this;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Move assign operator.
+	* @param[in]	origin		Original storage to be moved.
+	******************************************************************************************************/
+	MsvResultStorage& operator=(MsvResultStorage&& origin) noexcept(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value)
+	{
+		if (this != &origin)
+		{
+			Assign(std::move(origin));
+		}
+
+		return *this;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Assign storage.
+	* @param[in]	origin		Original storage to be assigned (copied or moved).
+	******************************************************************************************************/
+	template<typename Storage>
+	void Assign(Storage&& origin)
+	{
+		if (MSV_FAILED(origin.m_errorCode))
+		{
+			//value of origin is not touched at all
+			if (MSV_SUCCEEDED(m_errorCode))
+			{
+				m_value.~T();
+			}
+		}
+		else if (MSV_SUCCEEDED(m_errorCode))
+		{
+			m_value = std::forward<Storage>(origin).m_value;
+		}
+		else
+		{
+			new (&m_value) T(std::forward<Storage>(origin).m_value);
+		}
+
+		m_errorCode = origin.m_errorCode;
+	}
+
+	union
+	{
+		/**************************************************************************************************//**
+		* @brief		Empty member (active when there is no value).
+		******************************************************************************************************/
+		char m_empty;
+
+		/**************************************************************************************************//**
+		* @brief		Stored value (active when @ref m_errorCode succeeded).
+		******************************************************************************************************/
+		T m_value;
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Stored errorcode.
+	* @details	Value is stored when errorcode succeeded.
+	******************************************************************************************************/
+	MsvErrorCode m_errorCode;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech result.
+* @details	Holds value (when errorcode succeeded - success or info) or failed errorcode (warning or
+*				error). Stored errorcode is the discriminant, so result is not bigger than value and errorcode
+*				together. Result is trivially copyable when T is trivially copyable.
+* @tparam		T		Type of value.
+* @see		MsvFailure
+* @see		MSV_TRY
+* @see		MSV_VALUE_OR_THROW
+******************************************************************************************************/
+template<typename T>
+class MsvResult :
+	public MsvResultStorage<T>
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates succeeded result with value.
+	* @param[in]	value		Value to store.
+	******************************************************************************************************/
+	constexpr MsvResult(const T& value) :
+		MsvResultStorage<T>(MSV_SUCCESS, std::in_place, value)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates succeeded result with value.
+	* @param[in]	value		Value to store.
+	******************************************************************************************************/
+	constexpr MsvResult(T&& value) :
+		MsvResultStorage<T>(MSV_SUCCESS, std::in_place, std::move(value))
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates succeeded result with value and success or info errorcode.
+	* @param[in]	errorCode		Succeeded (success or info) errorcode.
+	* @param[in]	args				Arguments to construct value.
+	* @warning		Errorcode must be succeeded (@ref MSV_SUCCEEDED).
+	******************************************************************************************************/
+	template<typename... Args>
+	constexpr MsvResult(MsvErrorCode errorCode, std::in_place_t, Args&&... args) :
+		MsvResultStorage<T>(errorCode, std::in_place, std::forward<Args>(args)...)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates failed result.
+	* @param[in]	failure		Failed errorcode.
+	******************************************************************************************************/
+	constexpr MsvResult(MsvFailure failure) noexcept :
+		MsvResultStorage<T>(failure.errorCode)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Check value.
+	* @retval		true		When result succeeded and it holds value.
+	* @retval		false		When result failed.
+	******************************************************************************************************/
+	constexpr bool HasValue() const noexcept
+	{
+		return MSV_SUCCEEDED(this->m_errorCode);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Check value.
+	* @see			HasValue
+	******************************************************************************************************/
+	constexpr explicit operator bool() const noexcept
+	{
+		return HasValue();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Check failed.
+	* @retval		true		When result failed (warning or error errorcode).
+	* @retval		false		When result succeeded.
+	******************************************************************************************************/
+	constexpr bool Failed() const noexcept
+	{
+		return MSV_FAILED(this->m_errorCode);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get errorcode.
+	* @returns		MsvErrorCode		Stored errorcode (success or info when result holds value).
+	******************************************************************************************************/
+	constexpr MsvErrorCode GetErrorCode() const noexcept
+	{
+		return this->m_errorCode;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get value.
+	* @returns		T&		Stored value.
+	* @warning		Result must hold value (@ref HasValue).
+	******************************************************************************************************/
+	constexpr T& GetValue() & noexcept
+	{
+		return this->m_value;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get value.
+	* @returns		const T&		Stored value.
+	* @warning		Result must hold value (@ref HasValue).
+	******************************************************************************************************/
+	constexpr const T& GetValue() const & noexcept
+	{
+		return this->m_value;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get value.
+	* @returns		T&&		Stored value (to be moved).
+	* @warning		Result must hold value (@ref HasValue).
+	******************************************************************************************************/
+	constexpr T&& GetValue() && noexcept
+	{
+		return std::move(this->m_value);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get value or default.
+	* @param[in]	defaultValue		Value returned when result failed.
+	* @returns		T						Stored value or defaultValue.
+	******************************************************************************************************/
+	constexpr T GetValueOr(T defaultValue) const &
+	{
+		return HasValue() ? this->m_value : defaultValue;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get value or throw.
+	* @details		Returns stored value or throws @ref MsvException with stored errorcode.
+	* @param[in]	fileName		Filename where exception is thrown.
+	* @param[in]	line			Line number where exception is thrown.
+	* @param[in]	msg			Message to set to the exception.
+	* @returns		T				Stored value.
+	* @see			MSV_VALUE_OR_THROW
+	******************************************************************************************************/
+	T GetValueOrThrow(const char* fileName, int line, const char* msg) &&
+	{
+		if (MSV_UNLIKELY(Failed())) MSV_UNLIKELY_BRANCH
+		{
+			MsvThrow(fileName, line, this->m_errorCode, msg);
+		}
+
+		return std::move(this->m_value);
+	}
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech result without value.
+* @details	Holds only errorcode - it is the same size as @ref MsvErrorCode.
+* @see		MsvResult
+******************************************************************************************************/
+template<>
+class MsvResult<void>
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates succeeded result.
+	* @param[in]	errorCode		Succeeded (success or info) errorcode.
+	******************************************************************************************************/
+	constexpr MsvResult(MsvErrorCode errorCode = MSV_SUCCESS, std::in_place_t = std::in_place) noexcept :
+		m_errorCode(errorCode)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates failed result.
+	* @param[in]	failure		Failed errorcode.
+	******************************************************************************************************/
+	constexpr MsvResult(MsvFailure failure) noexcept :
+		m_errorCode(failure.errorCode)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Check value.
+	* @retval		true		When result succeeded.
+	* @retval		false		When result failed.
+	******************************************************************************************************/
+	constexpr bool HasValue() const noexcept
+	{
+		return MSV_SUCCEEDED(m_errorCode);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Check value.
+	* @see			HasValue
+	******************************************************************************************************/
+	constexpr explicit operator bool() const noexcept
+	{
+		return HasValue();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Check failed.
+	* @retval		true		When result failed (warning or error errorcode).
+	* @retval		false		When result succeeded.
+	******************************************************************************************************/
+	constexpr bool Failed() const noexcept
+	{
+		return MSV_FAILED(m_errorCode);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get errorcode.
+	* @returns		MsvErrorCode		Stored errorcode.
+	******************************************************************************************************/
+	constexpr MsvErrorCode GetErrorCode() const noexcept
+	{
+		return m_errorCode;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get value.
+	* @details		Does nothing (there is no value). It is here for generic code and @ref MSV_TRY.
+	******************************************************************************************************/
+	constexpr void GetValue() const noexcept
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Throw failed.
+	* @details		Throws @ref MsvException with stored errorcode when result failed.
+	* @param[in]	fileName		Filename where exception is thrown.
+	* @param[in]	line			Line number where exception is thrown.
+	* @param[in]	msg			Message to set to the exception.
+	* @see			MSV_VALUE_OR_THROW
+	******************************************************************************************************/
+	void GetValueOrThrow(const char* fileName, int line, const char* msg) const
+	{
+		if (MSV_UNLIKELY(Failed())) MSV_UNLIKELY_BRANCH
+		{
+			MsvThrow(fileName, line, m_errorCode, msg);
+		}
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Stored errorcode.
+	******************************************************************************************************/
+	MsvErrorCode m_errorCode;
+};
+
+
+/**************************************************************************************************//**
+* @brief			Catch result.
+* @details		Calls function and converts thrown @ref MsvException to failed @ref MsvResult.
+* @param[in]	function		Function to call.
+* @returns		MsvResult		Result with returned value or with errorcode of thrown exception.
+* @note			Other exceptions are not caught. In exception free mode (@ref MSV_NO_EXCEPTIONS) it just
+*					calls function.
+******************************************************************************************************/
+template<typename Function>
+auto MsvCatchResult(Function&& function) -> MsvResult<decltype(function())>
+{
+#ifdef MSV_NO_EXCEPTIONS
+	if constexpr (std::is_void<decltype(function())>::value)
+	{
+		function();
+		return MsvResult<void>();
+	}
+	else
+	{
+		return MsvResult<decltype(function())>(function());
+	}
+#else
+	try
+	{
+		if constexpr (std::is_void<decltype(function())>::value)
+		{
+			function();
+			return MsvResult<void>();
+		}
+		else
+		{
+			return MsvResult<decltype(function())>(function());
+		}
+	}
+	catch (const MsvException& exception)
+	{
+		return MsvFailure(exception.GetErrorCode());
+	}
+#endif
+}
+
+
+#define MSV_RESULT_CONCAT_IMPL(first, second) first##second
+#define MSV_RESULT_CONCAT(first, second) MSV_RESULT_CONCAT_IMPL(first, second)
+#define MSV_RESULT_NAME MSV_RESULT_CONCAT(msvResult, __LINE__)
+
+/**************************************************************************************************//**
+* @def			MSV_TRY(variable, expression)
+* @brief			Check result and return failed.
+* @details		Evaluates expression (@ref MsvResult). Returns (calls return of current function/method)
+*					@ref MsvFailure when result failed, otherwise initializes variable by its value.
+* @param[in]	variable			Variable declaration (for example "int value") to initialize by result value.
+* @param[in]	expression		Expression returning @ref MsvResult.
+* @note			Current function/method must return @ref MsvResult or @ref MsvErrorCode.
+* @see			MsvResult
+* @see			MSV_TRY_VOID
+* @see			MSV_RETURN_FAILED
+* @warning		Ends current function/method if failed result is received.
+******************************************************************************************************/
+#define MSV_TRY(variable, expression) \
+	auto&& MSV_RESULT_NAME = (expression); \
+	if (MSV_UNLIKELY(MSV_RESULT_NAME.Failed())) MSV_UNLIKELY_BRANCH { MSV_ERROR_HOOK(MSV_RESULT_NAME.GetErrorCode(), __FILE__, __LINE__) return MsvFailure(MSV_RESULT_NAME.GetErrorCode()); } \
+	variable = std::move(MSV_RESULT_NAME).GetValue();
+
+/**************************************************************************************************//**
+* @def			MSV_TRY_VOID(expression)
+* @brief			Check result and return failed.
+* @details		Evaluates expression (@ref MsvResult) and returns (calls return of current function/method)
+*					@ref MsvFailure when result failed. Its value (if any) is ignored.
+* @param[in]	expression		Expression returning @ref MsvResult.
+* @note			Current function/method must return @ref MsvResult or @ref MsvErrorCode.
+* @see			MSV_TRY
+* @warning		Ends current function/method if failed result is received.
+******************************************************************************************************/
+#define MSV_TRY_VOID(expression) \
+{ \
+	auto&& msvResultTV = (expression); \
+	if (MSV_UNLIKELY(msvResultTV.Failed())) MSV_UNLIKELY_BRANCH { MSV_ERROR_HOOK(msvResultTV.GetErrorCode(), __FILE__, __LINE__) return MsvFailure(msvResultTV.GetErrorCode()); } \
+}
+
+/**************************************************************************************************//**
+* @def			MSV_VALUE_OR_THROW(result, msvMessage)
+* @brief			Get result value or throw.
+* @details		Returns value of result or throws @ref MsvException with its errorcode when it failed.
+* @param[in]	result			Result (@ref MsvResult) - it is moved.
+* @param[in]	msvMessage		The message to set to the exception.
+* @see			MsvResult::GetValueOrThrow
+* @note			In exception free mode it calls failure handler (it is an expression - it can't return
+*					errorcode even when @ref MSV_NO_EXCEPTIONS_RETURN is defined).
+* @warning		Throws @ref MsvException if failed result is received.
+******************************************************************************************************/
+#define MSV_VALUE_OR_THROW(result, msvMessage) std::move(result).GetValueOrThrow(__FILE__, __LINE__, msvMessage)
+
+
+#endif // !MARSTECH_RESULT_H
+
+/** @} */	//End of group MPLS.
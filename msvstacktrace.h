@@ -0,0 +1,404 @@
+/**************************************************************************************************//**
+* @defgroup		MSVERROR MarsTech Error Handling
+* @brief			MarsTech Error
+* @details		Contains implementation and all definitions of MarsTech Error.
+* @copyright	GNU General Public License (GPLv3).
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Stack Trace
+* @details		Contains stack trace capture (raw return addresses) and cached deferred symbolization.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Error.
+
+MarsTech Error is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Error is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MarsTech Error. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_STACK_TRACE_H
+#define MARSTECH_STACK_TRACE_H
+
+
+#include "msverror.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#if defined(_WIN32)
+//header is included to all translation units by msvexception.h - do not leak min/max and rarely used Win32 macros
+#ifndef NOMINMAX
+#define NOMINMAX
+#define MSV_STACK_TRACE_NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#define MSV_STACK_TRACE_WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <dbghelp.h>
+#ifdef MSV_STACK_TRACE_NOMINMAX
+#undef NOMINMAX
+#undef MSV_STACK_TRACE_NOMINMAX
+#endif
+#ifdef MSV_STACK_TRACE_WIN32_LEAN_AND_MEAN
+#undef WIN32_LEAN_AND_MEAN
+#undef MSV_STACK_TRACE_WIN32_LEAN_AND_MEAN
+#endif
+#pragma comment(lib, "dbghelp.lib")
+#define MSV_STACK_TRACE_WINDOWS
+#elif defined(__has_include)
+#if __has_include(<execinfo.h>) && __has_include(<dlfcn.h>) && __has_include(<cxxabi.h>)
+#include <execinfo.h>
+#include <dlfcn.h>
+#include <cxxabi.h>
+#define MSV_STACK_TRACE_EXECINFO
+#endif
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+#ifndef MSV_STACK_TRACE_DEPTH
+/**************************************************************************************************//**
+* @def			MSV_STACK_TRACE_DEPTH
+* @brief			Stack trace depth.
+* @details		Maximal count of captured return addresses. Define it before including MarsTech Error headers
+*					to change it (it must be same in all translation units).
+******************************************************************************************************/
+#define MSV_STACK_TRACE_DEPTH 32
+#endif // !MSV_STACK_TRACE_DEPTH
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech stack trace symbol.
+* @details	Symbolized return address. Not resolved parts are empty (or zero).
+******************************************************************************************************/
+struct MsvStackTraceSymbol
+{
+	/**************************************************************************************************//**
+	* @brief		Function name (demangled).
+	******************************************************************************************************/
+	std::string function;
+
+	/**************************************************************************************************//**
+	* @brief		Offset of address from the function start.
+	******************************************************************************************************/
+	std::uintptr_t offset;
+
+	/**************************************************************************************************//**
+	* @brief		Module (executable or shared library) path.
+	******************************************************************************************************/
+	std::string module;
+
+	/**************************************************************************************************//**
+	* @brief		Source filename (only when debug information is available to symbolizer).
+	******************************************************************************************************/
+	std::string fileName;
+
+	/**************************************************************************************************//**
+	* @brief		Source line number (0 when it is not known).
+	******************************************************************************************************/
+	int line;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech stack trace symbolizer.
+* @details	Resolves addresses to symbols and caches them (process wide), so repeated traces from the same
+*				sites are symbolized only once.
+* @note		On Linux function names are resolved by dladdr - executable symbols need to be exported
+*				(-rdynamic), source files and lines are not resolved. On Windows DbgHelp resolves source files and
+*				lines too (when PDB files are available).
+******************************************************************************************************/
+class MsvStackTraceSymbolizer
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Resolve address.
+	* @param[in]	address		Return address.
+	* @returns		const MsvStackTraceSymbol&		Cached symbol (valid for the process lifetime).
+	******************************************************************************************************/
+	static const MsvStackTraceSymbol& Resolve(void* address)
+	{
+		Cache& cache = GetCache();
+		std::lock_guard<std::mutex> lock(cache.mutex);
+
+		std::unordered_map<void*, MsvStackTraceSymbol>::iterator found = cache.symbols.find(address);
+		if (found != cache.symbols.end())
+		{
+			return found->second;
+		}
+
+		return cache.symbols.emplace(address, Symbolize(address)).first->second;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get cache size.
+	* @returns		std::size_t		Count of cached symbols.
+	******************************************************************************************************/
+	static std::size_t GetCacheSize()
+	{
+		Cache& cache = GetCache();
+		std::lock_guard<std::mutex> lock(cache.mutex);
+
+		return cache.symbols.size();
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Symbol cache.
+	******************************************************************************************************/
+	struct Cache
+	{
+		std::mutex mutex;
+		std::unordered_map<void*, MsvStackTraceSymbol> symbols;
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Get cache.
+	* @returns		Cache&		Process wide symbol cache.
+	******************************************************************************************************/
+	static Cache& GetCache()
+	{
+		static Cache cache;
+
+		return cache;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Symbolize address.
+	* @details		Resolves address by platform symbolizer (called with cache lock).
+	* @param[in]	address		Return address.
+	* @returns		MsvStackTraceSymbol		Resolved symbol.
+	******************************************************************************************************/
+	static MsvStackTraceSymbol Symbolize(void* address)
+	{
+		MsvStackTraceSymbol symbol = { std::string(), 0, std::string(), std::string(), 0 };
+
+		//return address may point behind the end of calling function (call of noreturn function) - look up the call
+		void* call = static_cast<char*>(address) - 1;
+
+#if defined(MSV_STACK_TRACE_EXECINFO)
+		Dl_info info;
+		if (dladdr(call, &info))
+		{
+			if (info.dli_fname)
+			{
+				symbol.module = info.dli_fname;
+			}
+
+			if (info.dli_sname)
+			{
+				int status = 0;
+				char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+				symbol.function = status == 0 && demangled ? demangled : info.dli_sname;
+				std::free(demangled);
+				symbol.offset = reinterpret_cast<std::uintptr_t>(address) - reinterpret_cast<std::uintptr_t>(info.dli_saddr);
+			}
+			else if (info.dli_fbase)
+			{
+				symbol.offset = reinterpret_cast<std::uintptr_t>(address) - reinterpret_cast<std::uintptr_t>(info.dli_fbase);
+			}
+		}
+#elif defined(MSV_STACK_TRACE_WINDOWS)
+		static bool initialized = SymInitialize(GetCurrentProcess(), nullptr, TRUE) != FALSE;
+		if (initialized)
+		{
+			char buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME];
+			SYMBOL_INFO* info = reinterpret_cast<SYMBOL_INFO*>(buffer);
+			info->SizeOfStruct = sizeof(SYMBOL_INFO);
+			info->MaxNameLen = MAX_SYM_NAME;
+
+			DWORD64 displacement = 0;
+			if (SymFromAddr(GetCurrentProcess(), reinterpret_cast<DWORD64>(call), &displacement, info))
+			{
+				symbol.function = info->Name;
+				symbol.offset = static_cast<std::uintptr_t>(displacement) + 1;
+			}
+
+			IMAGEHLP_LINE64 line;
+			line.SizeOfStruct = sizeof(IMAGEHLP_LINE64);
+			DWORD lineDisplacement = 0;
+			if (SymGetLineFromAddr64(GetCurrentProcess(), reinterpret_cast<DWORD64>(call), &lineDisplacement, &line))
+			{
+				symbol.fileName = line.FileName;
+				symbol.line = static_cast<int>(line.LineNumber);
+			}
+
+			IMAGEHLP_MODULE64 module;
+			module.SizeOfStruct = sizeof(IMAGEHLP_MODULE64);
+			if (SymGetModuleInfo64(GetCurrentProcess(), reinterpret_cast<DWORD64>(call), &module))
+			{
+				symbol.module = module.ImageName;
+			}
+		}
+#else
+		(void)call;
+#endif
+
+		return symbol;
+	}
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech stack trace.
+* @details	Raw return addresses captured without allocation (bounded by @ref MSV_STACK_TRACE_DEPTH). It is
+*				trivially copyable. Addresses are symbolized only when trace is formatted (see @ref ToString).
+* @note		On Linux (glibc) addresses are captured by backtrace() - it is called once on start-up (it loads
+*				unwinder on the first call). On Windows they are captured by RtlCaptureStackBackTrace. Trace is
+*				empty on other systems.
+******************************************************************************************************/
+class MsvStackTrace
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Creates empty stack trace.
+	******************************************************************************************************/
+	MsvStackTrace() noexcept :
+		m_size(0)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Capture stack trace.
+	* @details		Captures return addresses of current thread (the caller of this method is the first one).
+	* @param[in]	skip		Count of the latest callers to skip.
+	******************************************************************************************************/
+	MSV_NOINLINE void Capture(std::size_t skip = 0) noexcept
+	{
+		m_size = 0;
+
+#if defined(MSV_STACK_TRACE_EXECINFO)
+		void* addresses[MSV_STACK_TRACE_DEPTH + 8];
+		int size = backtrace(addresses, static_cast<int>(MSV_STACK_TRACE_DEPTH + 8));
+
+		for (std::size_t index = skip + 1; index < static_cast<std::size_t>(size) && m_size < MSV_STACK_TRACE_DEPTH; ++index)
+		{
+			m_addresses[m_size++] = addresses[index];
+		}
+#elif defined(MSV_STACK_TRACE_WINDOWS)
+		m_size = RtlCaptureStackBackTrace(static_cast<DWORD>(skip + 1), MSV_STACK_TRACE_DEPTH, m_addresses, nullptr);
+#else
+		(void)skip;
+#endif
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get size.
+	* @returns		std::size_t		Count of captured addresses.
+	******************************************************************************************************/
+	std::size_t GetSize() const noexcept
+	{
+		return m_size;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get address.
+	* @param[in]	index		Index of address (0 is the latest caller, must be lower than @ref GetSize).
+	* @returns		void*		Return address.
+	******************************************************************************************************/
+	void* GetAddress(std::size_t index) const noexcept
+	{
+		return m_addresses[index];
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Format stack trace.
+	* @details		Symbolizes addresses (see @ref MsvStackTraceSymbolizer) and formats them line by line.
+	* @returns		std::string		Formatted stack trace.
+	* @note			One line format: #&lt;index&gt; 0x&lt;address&gt; &lt;function&gt;+0x&lt;offset&gt;
+	*					(&lt;module&gt;) [at &lt;fileName&gt;:&lt;line&gt;]
+	******************************************************************************************************/
+	std::string ToString() const
+	{
+		std::string text;
+		char number[64];
+
+		for (std::size_t index = 0; index < m_size; ++index)
+		{
+			const MsvStackTraceSymbol& symbol = MsvStackTraceSymbolizer::Resolve(m_addresses[index]);
+
+			std::snprintf(number, sizeof(number), "#%zu 0x%llx ", index, static_cast<unsigned long long>(reinterpret_cast<std::uintptr_t>(m_addresses[index])));
+			text += number;
+			text += symbol.function.empty() ? "??" : symbol.function;
+
+			std::snprintf(number, sizeof(number), "+0x%llx", static_cast<unsigned long long>(symbol.offset));
+			text += number;
+
+			if (!symbol.module.empty())
+			{
+				text += " (" + symbol.module + ")";
+			}
+
+			if (!symbol.fileName.empty())
+			{
+				text += " at " + symbol.fileName + ":" + std::to_string(symbol.line);
+			}
+
+			text += '\n';
+		}
+
+		return text;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Captured return addresses.
+	******************************************************************************************************/
+	void* m_addresses[MSV_STACK_TRACE_DEPTH];
+
+	/**************************************************************************************************//**
+	* @brief		Count of captured return addresses.
+	******************************************************************************************************/
+	std::size_t m_size;
+};
+
+
+#if defined(MSV_STACK_TRACE_EXECINFO)
+/**************************************************************************************************//**
+* @brief		Stack trace warm-up.
+* @details	The first backtrace() call loads unwinder (it allocates) - it is called on start-up, so capturing
+*				traces on throws never allocates.
+******************************************************************************************************/
+inline const bool MsvStackTraceWarmedUp = []() noexcept
+{
+	void* address = nullptr;
+	backtrace(&address, 1);
+
+	return true;
+}();
+#endif
+
+
+#endif // !MARSTECH_STACK_TRACE_H
+
+/** @} */	//End of group MPLS.
@@ -0,0 +1,568 @@
+/**************************************************************************************************//**
+* @defgroup		MSVERROR MarsTech Error Handling
+* @brief			MarsTech Error
+* @details		Contains implementation and all definitions of MarsTech Error.
+* @copyright	GNU General Public License (GPLv3).
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Task
+* @details		Contains C++20 coroutine task which propagates failures without exceptions.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Error.
+
+MarsTech Error is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Error is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MarsTech Error. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_TASK_H
+#define MARSTECH_TASK_H
+
+
+#include "msverrorcodes.h"
+#include "msvexception.h"
+#include "msvresult.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+#if defined(__cpp_impl_coroutine) && defined(__cpp_lib_coroutine)
+/**************************************************************************************************//**
+* @def			MSV_COROUTINES
+* @brief			Coroutines are available.
+* @details		Defined when compiler and standard library support C++20 coroutines. @ref MsvTask is
+*					available only when it is defined.
+******************************************************************************************************/
+#define MSV_COROUTINES
+#endif
+
+
+#ifdef MSV_COROUTINES
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <coroutine>
+#include <type_traits>
+#include <utility>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech task promise base.
+* @details	Type independent part of @ref MsvTask promise - continuation and failure propagation. Failure
+*				of task awaited with short circuit (co_await task) is set directly to the awaiting promise and
+*				its continuation is resumed instead (the awaiting coroutine is never resumed).
+* @see		MsvTaskPromise
+******************************************************************************************************/
+class MsvTaskPromiseBase
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Set continuation.
+	* @param[in]	continuation		Coroutine resumed when task is done.
+	* @param[in]	parent				Promise which fails with the task (short circuit) or nullptr.
+	******************************************************************************************************/
+	void SetContinuation(std::coroutine_handle<> continuation, MsvTaskPromiseBase* parent) noexcept
+	{
+		m_continuation = continuation;
+		m_parent = parent;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Check task is done.
+	* @retval		true		When task returned or failed (directly or by short circuit).
+	* @retval		false		When task has not been started or it is still running.
+	******************************************************************************************************/
+	bool IsDone() const noexcept
+	{
+		return m_done;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Abort task.
+	* @details		Fails task and all its short circuit parents by errorcode.
+	* @param[in]	errorCode		Failed errorcode.
+	* @returns		std::coroutine_handle<>		Continuation of the last failed promise (coroutine to resume).
+	******************************************************************************************************/
+	std::coroutine_handle<> Abort(MsvErrorCode errorCode) noexcept
+	{
+		MsvTaskPromiseBase* promise = this;
+
+		for (;;)
+		{
+			promise->SetFailure(errorCode);
+			promise->m_done = true;
+
+			if (!promise->m_parent)
+			{
+				return promise->m_continuation;
+			}
+
+			promise = promise->m_parent;
+		}
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Destructor.
+	******************************************************************************************************/
+	~MsvTaskPromiseBase() = default;
+
+	/**************************************************************************************************//**
+	* @brief			Finish task.
+	* @details		Marks task done (it is called by final suspend).
+	* @param[in]	errorCode		Errorcode of task result.
+	* @returns		std::coroutine_handle<>		Coroutine to resume.
+	******************************************************************************************************/
+	std::coroutine_handle<> Finish(MsvErrorCode errorCode) noexcept
+	{
+		m_done = true;
+
+		if (MSV_FAILED(errorCode) && m_parent)
+		{
+			return m_parent->Abort(errorCode);
+		}
+
+		return m_continuation;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set failure.
+	* @details		Sets failed result.
+	* @param[in]	errorCode		Failed errorcode.
+	******************************************************************************************************/
+	virtual void SetFailure(MsvErrorCode errorCode) noexcept = 0;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Coroutine resumed when task is done (nothing for not awaited tasks).
+	******************************************************************************************************/
+	std::coroutine_handle<> m_continuation = std::noop_coroutine();
+
+	/**************************************************************************************************//**
+	* @brief		Promise which fails with the task (short circuit) or nullptr.
+	******************************************************************************************************/
+	MsvTaskPromiseBase* m_parent = nullptr;
+
+	/**************************************************************************************************//**
+	* @brief		Task is done.
+	******************************************************************************************************/
+	bool m_done = false;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech task final awaiter.
+* @details	Finishes task and transfers execution to its continuation (symmetric transfer).
+******************************************************************************************************/
+class MsvTaskFinalAwaiter
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Check awaiter is ready.
+	* @retval		false		Always (task is always suspended at final suspend point).
+	******************************************************************************************************/
+	bool await_ready() const noexcept
+	{
+		return false;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Suspend task.
+	* @param[in]	coroutine		Finished task.
+	* @returns		std::coroutine_handle<>		Coroutine to resume.
+	******************************************************************************************************/
+	template<typename Promise>
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> coroutine) noexcept
+	{
+		return coroutine.promise().Finish();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Resume task.
+	* @details		Never called (finished task is never resumed).
+	******************************************************************************************************/
+	void await_resume() const noexcept
+	{
+
+	}
+};
+
+
+template<typename T>
+class MsvTask;
+
+/**************************************************************************************************//**
+* @brief		MarsTech task promise.
+* @details	Stores task result. Thrown @ref MsvException is converted to failed result, other exceptions are
+*				rethrown (see @ref MsvCatchResult).
+* @tparam		T		Type of value.
+* @see		MsvTask
+******************************************************************************************************/
+template<typename T>
+class MsvTaskPromise :
+	public MsvTaskPromiseBase
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Get return object.
+	* @returns		MsvTask<T>		Task of this promise.
+	******************************************************************************************************/
+	MsvTask<T> get_return_object() noexcept
+	{
+		return MsvTask<T>(std::coroutine_handle<MsvTaskPromise>::from_promise(*this));
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Initial suspend.
+	* @details		Tasks are lazy - they start when they are awaited or started.
+	* @returns		std::suspend_always		Always suspend.
+	******************************************************************************************************/
+	std::suspend_always initial_suspend() const noexcept
+	{
+		return {};
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Final suspend.
+	* @returns		MsvTaskFinalAwaiter		Awaiter which resumes continuation.
+	******************************************************************************************************/
+	MsvTaskFinalAwaiter final_suspend() const noexcept
+	{
+		return {};
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Return value.
+	* @details		Stores result of co_return (value or @ref MsvFailure).
+	* @param[in]	result		Task result.
+	******************************************************************************************************/
+	void return_value(MsvResult<T> result) noexcept(std::is_nothrow_move_assignable<MsvResult<T>>::value)
+	{
+		m_result = std::move(result);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Handle unhandled exception.
+	* @details		Converts @ref MsvException to failed result, other exceptions are rethrown (to the code
+	*					which resumed task).
+	******************************************************************************************************/
+	void unhandled_exception()
+	{
+#ifndef MSV_NO_EXCEPTIONS
+		try
+		{
+			throw;
+		}
+		catch (const MsvException& exception)
+		{
+			SetFailure(exception.GetErrorCode());
+		}
+#endif
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get result.
+	* @returns		MsvResult<T>&		Task result (MSV_STILL_RUNNING_ERROR when task is not done).
+	******************************************************************************************************/
+	MsvResult<T>& GetResult() noexcept
+	{
+		return m_result;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Finish task.
+	* @returns		std::coroutine_handle<>		Coroutine to resume.
+	* @see			MsvTaskPromiseBase::Finish
+	******************************************************************************************************/
+	std::coroutine_handle<> Finish() noexcept
+	{
+		return MsvTaskPromiseBase::Finish(m_result.GetErrorCode());
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @copydoc		MsvTaskPromiseBase::SetFailure
+	******************************************************************************************************/
+	void SetFailure(MsvErrorCode errorCode) noexcept override
+	{
+		m_result = MsvFailure(errorCode);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Task result.
+	******************************************************************************************************/
+	MsvResult<T> m_result = MsvFailure(MSV_STILL_RUNNING_ERROR);
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech task.
+* @details	Lazy coroutine task whose result is @ref MsvResult (value or failed errorcode). Awaiting task
+*				starts it and resumes awaiting coroutine when it is done (symmetric transfer):
+*				- co_await task - returns value of succeeded task. Failed task short circuits awaiting task
+*				  (awaitable version of @ref MSV_RETURN_FAILED) - it fails with the same errorcode and it is
+*				  never resumed. Failure is propagated without exceptions through all short circuit awaits.
+*				- co_await task.AwaitResult() - returns @ref MsvResult (no short circuit, any coroutine can await).
+*
+*				Coroutine returns value or failure by co_return (co_return MsvFailure(errorCode)). Thrown
+*				@ref MsvException is converted to failed result.
+* @tparam		T		Type of value (void for tasks returning only errorcode).
+* @note		Task with void value must return errorcode (co_return MSV_SUCCESS). Locals of short circuited
+*				coroutine are destroyed with its task. Error hooks (@ref MSV_ERROR_HOOK) are not called when
+*				failure is propagated.
+* @see		MsvResult
+******************************************************************************************************/
+template<typename T>
+class MsvTask
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Promise type.
+	******************************************************************************************************/
+	typedef MsvTaskPromise<T> promise_type;
+
+	/**************************************************************************************************//**
+	* @brief		MarsTech task awaiter.
+	* @details	Starts awaited task and returns its value (short circuit) or result.
+	* @tparam		ShortCircuit		Failed task fails awaiting task (value is returned) or result is returned.
+	******************************************************************************************************/
+	template<bool ShortCircuit>
+	class Awaiter
+	{
+	public:
+		/**************************************************************************************************//**
+		* @brief			Constructor.
+		* @param[in]	coroutine		Awaited task.
+		******************************************************************************************************/
+		explicit Awaiter(std::coroutine_handle<promise_type> coroutine) noexcept :
+			m_coroutine(coroutine)
+		{
+
+		}
+
+		/**************************************************************************************************//**
+		* @brief			Check awaiter is ready.
+		* @retval		true		When task is done and its result can be returned.
+		* @retval		false		When task must be started (or awaiting task must be short circuited).
+		******************************************************************************************************/
+		bool await_ready() const noexcept
+		{
+			return m_coroutine.promise().IsDone() && (!ShortCircuit || !m_coroutine.promise().GetResult().Failed());
+		}
+
+		/**************************************************************************************************//**
+		* @brief			Suspend awaiting coroutine.
+		* @details		Starts awaited task (or short circuits awaiting task when awaited task already failed).
+		* @param[in]	awaiting		Awaiting coroutine.
+		* @returns		std::coroutine_handle<>		Coroutine to resume.
+		******************************************************************************************************/
+		template<typename Promise>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> awaiting) noexcept
+		{
+			promise_type& promise = m_coroutine.promise();
+
+			if constexpr (ShortCircuit)
+			{
+				static_assert(std::is_base_of<MsvTaskPromiseBase, Promise>::value, "Only MsvTask can short circuit (use AwaitResult).");
+
+				if (promise.IsDone())
+				{
+					return awaiting.promise().Abort(promise.GetResult().GetErrorCode());
+				}
+
+				promise.SetContinuation(awaiting, &awaiting.promise());
+			}
+			else
+			{
+				promise.SetContinuation(awaiting, nullptr);
+			}
+
+			return m_coroutine;
+		}
+
+		/**************************************************************************************************//**
+		* @brief			Resume awaiting coroutine.
+		* @returns		T or MsvResult<T>		Value of task (short circuit) or task result.
+		******************************************************************************************************/
+		std::conditional_t<ShortCircuit, T, MsvResult<T>> await_resume() noexcept(std::is_nothrow_move_constructible<MsvResult<T>>::value)
+		{
+			if constexpr (ShortCircuit)
+			{
+				return std::move(m_coroutine.promise().GetResult()).GetValue();
+			}
+			else
+			{
+				return std::move(m_coroutine.promise().GetResult());
+			}
+		}
+
+	protected:
+		/**************************************************************************************************//**
+		* @brief		Awaited task.
+		******************************************************************************************************/
+		std::coroutine_handle<promise_type> m_coroutine;
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	coroutine		Task coroutine (it is owned by task).
+	******************************************************************************************************/
+	explicit MsvTask(std::coroutine_handle<promise_type> coroutine) noexcept :
+		m_coroutine(coroutine)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Move constructor.
+	* @param[in]	origin		Moved task (it is empty after move).
+	******************************************************************************************************/
+	MsvTask(MsvTask&& origin) noexcept :
+		m_coroutine(std::exchange(origin.m_coroutine, nullptr))
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Move assignment.
+	* @param[in]	origin		Moved task (it is empty after move).
+	* @returns		MsvTask&		This task.
+	******************************************************************************************************/
+	MsvTask& operator=(MsvTask&& origin) noexcept
+	{
+		if (this != &origin)
+		{
+			Destroy();
+			m_coroutine = std::exchange(origin.m_coroutine, nullptr);
+		}
+
+		return *this;
+	}
+
+	MsvTask(const MsvTask&) = delete;
+	MsvTask& operator=(const MsvTask&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Destructor.
+	* @details		Destroys coroutine (even not finished one).
+	******************************************************************************************************/
+	~MsvTask()
+	{
+		Destroy();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Start task.
+	* @details		Runs task until it is done or suspended (awaiting asynchronous operation).
+	* @warning		Task must not be started twice (or started and awaited).
+	******************************************************************************************************/
+	void Start()
+	{
+		m_coroutine.resume();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Run task.
+	* @details		Starts task and returns its result.
+	* @returns		MsvResult<T>		Task result (MSV_STILL_RUNNING_ERROR when task has not been done
+	*										synchronously).
+	******************************************************************************************************/
+	MsvResult<T> Run() &&
+	{
+		Start();
+
+		return std::move(m_coroutine.promise().GetResult());
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Check task is done.
+	* @retval		true		When task returned or failed.
+	* @retval		false		When task has not been started or it is still running.
+	******************************************************************************************************/
+	bool IsDone() const noexcept
+	{
+		return m_coroutine.promise().IsDone();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get result.
+	* @returns		MsvResult<T>&		Task result (MSV_STILL_RUNNING_ERROR when task is not done).
+	******************************************************************************************************/
+	MsvResult<T>& GetResult() noexcept
+	{
+		return m_coroutine.promise().GetResult();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Await task with short circuit.
+	* @returns		Awaiter<true>		Awaiter which returns value (failure short circuits awaiting task).
+	******************************************************************************************************/
+	Awaiter<true> operator co_await() noexcept
+	{
+		return Awaiter<true>(m_coroutine);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Await task result.
+	* @returns		Awaiter<false>		Awaiter which returns @ref MsvResult.
+	******************************************************************************************************/
+	Awaiter<false> AwaitResult() noexcept
+	{
+		return Awaiter<false>(m_coroutine);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Destroy coroutine.
+	******************************************************************************************************/
+	void Destroy() noexcept
+	{
+		if (m_coroutine)
+		{
+			m_coroutine.destroy();
+		}
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Task coroutine.
+	******************************************************************************************************/
+	std::coroutine_handle<promise_type> m_coroutine;
+};
+
+#endif // MSV_COROUTINES
+
+
+#endif // !MARSTECH_TASK_H
+
+/** @} */	//End of group MPLS.
@@ -0,0 +1,306 @@
+/**************************************************************************************************//**
+* @defgroup		MSVERROR MarsTech Error Handling
+* @brief			MarsTech Error
+* @details		Contains implementation and all definitions of MarsTech Error.
+* @copyright	GNU General Public License (GPLv3).
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Timestamp
+* @details		Contains definition of cheap raw monotonic timestamps and their conversions.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Error.
+
+MarsTech Error is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Error is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MarsTech Error. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_TIMESTAMP_H
+#define MARSTECH_TIMESTAMP_H
+
+
+#include "msverror.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <chrono>
+#include <cstdint>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @def			MSV_TIMESTAMP_STEADY
+* @brief			Steady clock timestamp source.
+* @details		Timestamps are nanoseconds of std::chrono::steady_clock (portable, nanosecond precision).
+* @see			MSV_TIMESTAMP_SOURCE
+******************************************************************************************************/
+#define MSV_TIMESTAMP_STEADY 0
+
+/**************************************************************************************************//**
+* @def			MSV_TIMESTAMP_COARSE
+* @brief			Coarse monotonic clock timestamp source.
+* @details		Timestamps are nanoseconds of CLOCK_MONOTONIC_COARSE (the cheapest clock, but its resolution
+*					is only a few milliseconds). Available only on Linux - steady clock is used on other systems.
+* @see			MSV_TIMESTAMP_SOURCE
+******************************************************************************************************/
+#define MSV_TIMESTAMP_COARSE 1
+
+/**************************************************************************************************//**
+* @def			MSV_TIMESTAMP_TSC
+* @brief			Time stamp counter timestamp source.
+* @details		Timestamps are raw CPU time stamp counter ticks (cheap with sub-nanosecond resolution). They
+*					are converted to nanoseconds by rate calibrated on start-up. Available only on
+*					x86 and x64 CPUs with invariant TSC (checked by CPUID on start-up) - steady clock is used on
+*					other CPUs.
+* @warning		Calibration busy waits for 10 milliseconds during static initialization of every program
+*					(and shared library) built with this source.
+* @see			MSV_TIMESTAMP_SOURCE
+******************************************************************************************************/
+#define MSV_TIMESTAMP_TSC 2
+
+#ifndef MSV_TIMESTAMP_SOURCE
+/**************************************************************************************************//**
+* @def			MSV_TIMESTAMP_SOURCE
+* @brief			Timestamp source.
+* @details		Source of @ref MsvTimestamp (@ref MSV_TIMESTAMP_STEADY, @ref MSV_TIMESTAMP_COARSE or
+*					@ref MSV_TIMESTAMP_TSC). Define it before including this header to change it (it must be same
+*					in all translation units).
+******************************************************************************************************/
+#define MSV_TIMESTAMP_SOURCE MSV_TIMESTAMP_STEADY
+#endif // !MSV_TIMESTAMP_SOURCE
+
+#if MSV_TIMESTAMP_SOURCE == MSV_TIMESTAMP_TSC && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define MSV_TIMESTAMP_USE_TSC
+#elif MSV_TIMESTAMP_SOURCE == MSV_TIMESTAMP_COARSE && defined(__linux__)
+#define MSV_TIMESTAMP_USE_COARSE
+#endif
+
+MSV_DISABLE_ALL_WARNINGS
+
+#if defined(MSV_TIMESTAMP_USE_TSC) && defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(MSV_TIMESTAMP_USE_TSC)
+#include <cpuid.h>
+#include <x86intrin.h>
+#elif defined(MSV_TIMESTAMP_USE_COARSE)
+#include <time.h>
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech timestamp.
+* @details	Raw monotonic ticks of @ref MSV_TIMESTAMP_SOURCE. It is cheap to capture - convert it only when
+*				needed (by @ref MsvTimestampElapsed or @ref MsvTimestampToSystemTime).
+* @see		MsvTimestampNow
+******************************************************************************************************/
+typedef uint64_t MsvTimestamp;
+
+
+/**************************************************************************************************//**
+* @brief			Check time stamp counter is used.
+* @details		Time stamp counter is used only when @ref MSV_TIMESTAMP_TSC source is selected and the CPU has
+*					invariant TSC (CPUID 0x80000007 EDX bit 8) - its rate does not change with CPU frequency and
+*					power states. The CPU is checked only once.
+* @retval		true		When timestamps are time stamp counter ticks.
+* @retval		false		When timestamps are not time stamp counter ticks.
+******************************************************************************************************/
+inline bool MsvTimestampUseTsc() noexcept
+{
+#if defined(MSV_TIMESTAMP_USE_TSC) && defined(_MSC_VER)
+	static const bool invariantTsc = []() noexcept
+	{
+		int registers[4];
+		__cpuid(registers, static_cast<int>(0x80000000));
+		if (static_cast<unsigned int>(registers[0]) < 0x80000007)
+		{
+			return false;
+		}
+
+		__cpuid(registers, static_cast<int>(0x80000007));
+		return (registers[3] & (1 << 8)) != 0;
+	}();
+
+	return invariantTsc;
+#elif defined(MSV_TIMESTAMP_USE_TSC)
+	static const bool invariantTsc = []() noexcept
+	{
+		unsigned int eax, ebx, ecx, edx;
+		return __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) && (edx & (1u << 8));
+	}();
+
+	return invariantTsc;
+#else
+	return false;
+#endif
+}
+
+/**************************************************************************************************//**
+* @brief			Get current timestamp.
+* @returns		MsvTimestamp		Current raw monotonic ticks.
+* @see			MSV_TIMESTAMP_SOURCE
+******************************************************************************************************/
+inline MsvTimestamp MsvTimestampNow() noexcept
+{
+#if defined(MSV_TIMESTAMP_USE_COARSE)
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+	return static_cast<MsvTimestamp>(now.tv_sec) * 1000000000 + static_cast<MsvTimestamp>(now.tv_nsec);
+#else
+#if defined(MSV_TIMESTAMP_USE_TSC)
+	if (MsvTimestampUseTsc())
+	{
+		return __rdtsc();
+	}
+#endif
+
+	return static_cast<MsvTimestamp>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech timestamp calibration.
+* @details	Pairs timestamp with system (wall-clock) time and holds timestamp tick length. It is created
+*				once (on start-up) - see @ref MsvTimestampGetCalibration.
+******************************************************************************************************/
+struct MsvTimestampCalibration
+{
+	/**************************************************************************************************//**
+	* @brief		Timestamp taken together with @ref systemTime.
+	******************************************************************************************************/
+	MsvTimestamp timestamp;
+
+	/**************************************************************************************************//**
+	* @brief		System time taken together with @ref timestamp.
+	******************************************************************************************************/
+	std::chrono::system_clock::time_point systemTime;
+
+	/**************************************************************************************************//**
+	* @brief		Length of one timestamp tick in nanoseconds.
+	******************************************************************************************************/
+	double tickNanoseconds;
+};
+
+
+/**************************************************************************************************//**
+* @brief			Calibrate timestamp.
+* @details		Measures timestamp tick length and pairs timestamp with system time.
+* @returns		MsvTimestampCalibration		New calibration.
+* @note			Time stamp counter is measured against steady clock for 10 milliseconds (busy wait). It is not
+*					measured when the CPU has no invariant TSC (steady clock is used then).
+******************************************************************************************************/
+inline MsvTimestampCalibration MsvTimestampCalibrate() noexcept
+{
+	MsvTimestampCalibration calibration;
+	calibration.tickNanoseconds = 1.0;
+	calibration.timestamp = MsvTimestampNow();
+
+#if defined(MSV_TIMESTAMP_USE_TSC)
+	if (MsvTimestampUseTsc())
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		MsvTimestamp startTicks = MsvTimestampNow();
+		std::chrono::steady_clock::time_point end = start;
+
+		while (end - start < std::chrono::milliseconds(10))
+		{
+			end = std::chrono::steady_clock::now();
+		}
+
+		MsvTimestamp endTicks = MsvTimestampNow();
+		if (endTicks > startTicks)
+		{
+			calibration.tickNanoseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / static_cast<double>(endTicks - startTicks);
+		}
+
+		calibration.timestamp = MsvTimestampNow();
+	}
+#elif defined(MSV_TIMESTAMP_USE_COARSE)
+	//precise monotonic clock has the same base as coarse one
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	calibration.timestamp = static_cast<MsvTimestamp>(now.tv_sec) * 1000000000 + static_cast<MsvTimestamp>(now.tv_nsec);
+#endif
+
+	calibration.systemTime = std::chrono::system_clock::now();
+
+	return calibration;
+}
+
+/**************************************************************************************************//**
+* @brief			Get timestamp calibration.
+* @details		Returns process wide calibration (it is created on start-up - see @ref MsvTimestampCalibrated).
+* @returns		const MsvTimestampCalibration&		Process wide calibration.
+******************************************************************************************************/
+inline const MsvTimestampCalibration& MsvTimestampGetCalibration() noexcept
+{
+	static const MsvTimestampCalibration calibration = MsvTimestampCalibrate();
+
+	return calibration;
+}
+
+/**************************************************************************************************//**
+* @brief		Timestamp calibrated.
+* @details	Calibration is created on start-up, so the first conversion (usually in formatting of exception,
+*				error sink or flight recorder) does not wait for calibration of time stamp counter (10 ms).
+******************************************************************************************************/
+inline const bool MsvTimestampCalibrated = (MsvTimestampGetCalibration(), true);
+
+
+/**************************************************************************************************//**
+* @brief			Get elapsed time.
+* @details		Returns time elapsed between two timestamps.
+* @param[in]	from		Start timestamp.
+* @param[in]	to			End timestamp.
+* @returns		std::chrono::nanoseconds		Elapsed time (negative when "to" is older than "from").
+******************************************************************************************************/
+inline std::chrono::nanoseconds MsvTimestampElapsed(MsvTimestamp from, MsvTimestamp to) noexcept
+{
+	int64_t ticks = static_cast<int64_t>(to - from);
+
+#if defined(MSV_TIMESTAMP_USE_TSC)
+	return std::chrono::nanoseconds(static_cast<int64_t>(static_cast<double>(ticks) * MsvTimestampGetCalibration().tickNanoseconds));
+#else
+	return std::chrono::nanoseconds(ticks);
+#endif
+}
+
+/**************************************************************************************************//**
+* @brief			Convert timestamp to system time.
+* @param[in]	timestamp		Timestamp to convert.
+* @returns		std::chrono::system_clock::time_point		System (wall-clock) time of timestamp.
+* @note			System time changes after calibration (NTP, user changes) are not reflected.
+******************************************************************************************************/
+inline std::chrono::system_clock::time_point MsvTimestampToSystemTime(MsvTimestamp timestamp) noexcept
+{
+	const MsvTimestampCalibration& calibration = MsvTimestampGetCalibration();
+
+	return calibration.systemTime + std::chrono::duration_cast<std::chrono::system_clock::duration>(MsvTimestampElapsed(calibration.timestamp, timestamp));
+}
+
+
+#endif // !MARSTECH_TIMESTAMP_H
+
+/** @} */	//End of group MPLS.